@@ -0,0 +1,75 @@
+//
+// Created by michel on 16-10-26.
+//
+
+#include "benchmark.h"
+#include <org-simple/AlignedData.h>
+#include <org-simple/dsp/BiquadBlock.h>
+#include <string>
+#include <vector>
+
+using namespace org::simple;
+using namespace org::simple::benchmark;
+using namespace org::simple::dsp;
+
+namespace {
+
+static constexpr size_t TOTAL = 1 << 22;
+static constexpr size_t REPEATS = 5;
+
+using Buffer = std::vector<float, AlignedAllocator<float, 64>>;
+using Coefficients = BiQuad::Coefficients<float>;
+using History = BiQuad::History<float>;
+
+template <class Apply> double measure(size_t len, Apply apply) {
+  const size_t rounds = TOTAL / len + 1;
+  return nanosPerOperation(rounds * len, REPEATS, [&]() {
+    for (size_t round = 0; round < rounds; round++) {
+      apply();
+    }
+  });
+}
+
+template <size_t K>
+void measureBlock(std::ostream &out, const Coefficients &coefficients,
+                  const Buffer &x, Buffer &y, const std::string &suffix) {
+  BiQuadBlock<float, K> block(coefficients);
+  History history;
+  printResult(out,
+              ("block of " + std::to_string(K) + " outputs" + suffix).c_str(),
+              measure(x.size(),
+                      [&]() {
+                        block.applyWithHistory(x.data(), y.data(), x.size(),
+                                               history);
+                        doNotOptimize(y[0]);
+                      }),
+              "ns/sample");
+}
+
+void lengths(std::ostream &out) {
+  Coefficients coefficients;
+  BiQuad::Butterworth::configureLowPass(coefficients, 384000, 20);
+  for (size_t len : {64, 512, 4096}) {
+    Buffer x(len);
+    Buffer y(len);
+    fillSignal(x);
+    std::string suffix = ": " + std::to_string(len) + " samples";
+    History history;
+    printResult(out, ("applyWithHistory" + suffix).c_str(),
+                measure(len,
+                        [&]() {
+                          coefficients.applyWithHistory(x.data(), y.data(), len,
+                                                        history);
+                          doNotOptimize(y[0]);
+                        }),
+                "ns/sample");
+    measureBlock<4>(out, coefficients, x, y, suffix);
+    measureBlock<8>(out, coefficients, x, y, suffix);
+    measureBlock<16>(out, coefficients, x, y, suffix);
+  }
+}
+
+Benchmark lengthsBenchmark(
+    "BiQuadBlock: recursive biquad versus blocks of outputs", lengths);
+
+} // namespace
@@ -0,0 +1,145 @@
+//
+// Created by michel on 16-10-26.
+//
+
+#include "benchmark.h"
+#include <org-simple/AlignedData.h>
+#include <org-simple/dsp/BiquadCascade.h>
+#include <string>
+#include <vector>
+
+using namespace org::simple;
+using namespace org::simple::benchmark;
+using namespace org::simple::dsp;
+
+namespace {
+
+static constexpr size_t TOTAL = 1 << 21;
+static constexpr size_t REPEATS = 5;
+static constexpr size_t FRAMES = 512;
+static constexpr size_t SECTIONS = 8;
+
+using Buffer = std::vector<float, AlignedAllocator<float, 64>>;
+using Coefficients = BiQuad::Coefficients<float>;
+using History = BiQuad::History<float>;
+
+Coefficients coefficients(size_t channel, size_t section) {
+  Coefficients result;
+  BiQuad::Butterworth::configureLowPass(result, 48000,
+                                        1000.0 + 100.0 * channel + section);
+  return result;
+}
+
+/**
+ * An equalizer the way it is written without the cascade: every section of
+ * every channel with BiQuad::Coefficients::applyWithHistory(), alternating
+ * between the output and a scratch buffer so that the last section writes
+ * the output.
+ */
+struct PerChannel {
+  std::vector<Coefficients> coefficients_;
+  std::vector<History> history_;
+  Buffer scratch_;
+  size_t sections_;
+
+  PerChannel(size_t channels, size_t sections)
+      : coefficients_(channels * sections), history_(channels * sections),
+        scratch_(FRAMES), sections_(sections) {
+    for (size_t channel = 0; channel < channels; channel++) {
+      for (size_t section = 0; section < sections; section++) {
+        coefficients_[channel * sections + section] =
+            coefficients(channel, section);
+      }
+    }
+  }
+
+  void apply(const float *const *inputs, float *const *outputs,
+             size_t channels, size_t frames) {
+    for (size_t channel = 0; channel < channels; channel++) {
+      const float *input = inputs[channel];
+      for (size_t section = 0; section < sections_; section++) {
+        const size_t i = channel * sections_ + section;
+        float *output =
+            (sections_ - section) % 2 ? outputs[channel] : scratch_.data();
+        coefficients_[i].applyWithHistory(input, output, frames, history_[i]);
+        input = output;
+      }
+    }
+  }
+};
+
+template <size_t GROUP>
+BiQuadCascade<float, GROUP> cascade(size_t channels, size_t sections) {
+  BiQuadCascade<float, GROUP> result(channels, sections);
+  for (size_t channel = 0; channel < channels; channel++) {
+    for (size_t section = 0; section < sections; section++) {
+      result.setCoefficients(channel, section, coefficients(channel, section));
+    }
+  }
+  return result;
+}
+
+struct Data {
+  std::vector<Buffer> inputs;
+  std::vector<Buffer> outputs;
+  std::vector<const float *> inputPointers;
+  std::vector<float *> outputPointers;
+
+  explicit Data(size_t channels)
+      : inputs(channels, Buffer(FRAMES)), outputs(channels, Buffer(FRAMES)),
+        inputPointers(channels), outputPointers(channels) {
+    for (size_t channel = 0; channel < channels; channel++) {
+      fillSignal(inputs[channel], channel);
+      inputPointers[channel] = inputs[channel].data();
+      outputPointers[channel] = outputs[channel].data();
+    }
+  }
+
+  template <class Apply> double measure(Apply apply) {
+    const size_t channels = inputs.size();
+    const size_t rounds = TOTAL / channels / FRAMES + 1;
+    return nanosPerOperation(rounds * FRAMES * channels, REPEATS, [&]() {
+      for (size_t round = 0; round < rounds; round++) {
+        apply(inputPointers.data(), outputPointers.data());
+        doNotOptimize(outputs[round % channels][round % FRAMES]);
+      }
+    });
+  }
+};
+
+void channels(std::ostream &out) {
+  using Inputs = const float *const *;
+  using Outputs = float *const *;
+  for (size_t channels : {2, 8, 16, 32}) {
+    Data data(channels);
+    std::string suffix = ": " + std::to_string(channels) + " channels";
+    PerChannel perChannel(channels, SECTIONS);
+    printResult(out, ("applyWithHistory per channel" + suffix).c_str(),
+                data.measure([&](Inputs i, Outputs o) {
+                  perChannel.apply(i, o, channels, FRAMES);
+                }),
+                "ns/sample");
+    auto four = cascade<4>(channels, SECTIONS);
+    printResult(out, ("cascade of 4 channels" + suffix).c_str(),
+                data.measure(
+                    [&](Inputs i, Outputs o) { four.apply(i, o, FRAMES); }),
+                "ns/sample");
+    auto eight = cascade<8>(channels, SECTIONS);
+    printResult(out, ("cascade of 8 channels" + suffix).c_str(),
+                data.measure(
+                    [&](Inputs i, Outputs o) { eight.apply(i, o, FRAMES); }),
+                "ns/sample");
+    auto sixteen = cascade<16>(channels, SECTIONS);
+    printResult(out, ("cascade of 16 channels" + suffix).c_str(),
+                data.measure(
+                    [&](Inputs i, Outputs o) { sixteen.apply(i, o, FRAMES); }),
+                "ns/sample");
+  }
+}
+
+Benchmark channelsBenchmark(
+    "BiQuadCascade: 8 sections of 512 frames per channel versus groups of "
+    "channels",
+    channels);
+
+} // namespace
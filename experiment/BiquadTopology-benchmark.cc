@@ -0,0 +1,115 @@
+//
+// Created by michel on 16-10-26.
+//
+
+#include "benchmark.h"
+#include <cmath>
+#include <org-simple/AlignedData.h>
+#include <org-simple/dsp/BiquadTopology.h>
+#include <string>
+#include <vector>
+
+using namespace org::simple;
+using namespace org::simple::benchmark;
+using namespace org::simple::dsp;
+
+namespace {
+
+static constexpr size_t TOTAL = 1 << 22;
+static constexpr size_t REPEATS = 5;
+static constexpr size_t LEN = 4096;
+
+using Buffer = std::vector<float, AlignedAllocator<float, 64>>;
+using Coefficients = BiQuad::Coefficients<float>;
+
+Buffer signal() {
+  Buffer x(LEN);
+  fillSignal(x);
+  return x;
+}
+
+template <template <typename> class Topology>
+double throughput(const Coefficients &coefficients) {
+  static constexpr size_t ROUNDS = TOTAL / LEN;
+  Buffer x = signal();
+  Buffer y(LEN);
+  Topology<float> topology(coefficients);
+  typename Topology<float>::template State<float> state;
+  return nanosPerOperation(ROUNDS * LEN, REPEATS, [&]() {
+    for (size_t round = 0; round < ROUNDS; round++) {
+      topology.apply(x.data(), y.data(), LEN, state);
+      doNotOptimize(y[round % LEN]);
+    }
+  });
+}
+
+/**
+ * Returns the power of the difference with a double precision direct form I
+ * with the same coefficients, relative to the power of the output, in dB.
+ */
+template <template <typename> class Topology>
+double noiseFloor(const Coefficients &coefficients) {
+  static constexpr size_t ROUNDS = 64;
+  Buffer x = signal();
+  Buffer y(LEN);
+  std::vector<double> input(x.begin(), x.end());
+  std::vector<double> exact(LEN);
+  BiQuad::Coefficients<double> precise;
+  precise.b0 = coefficients.b0;
+  precise.b1 = coefficients.b1;
+  precise.b2 = coefficients.b2;
+  precise.a1 = coefficients.a1;
+  precise.a2 = coefficients.a2;
+  BiQuad::History<double> history;
+  Topology<float> topology(coefficients);
+  typename Topology<float>::template State<float> state;
+  double noise = 0;
+  double power = 0;
+  for (size_t round = 0; round < ROUNDS; round++) {
+    precise.applyWithHistory(input.data(), exact.data(), LEN, history);
+    topology.apply(x.data(), y.data(), LEN, state);
+    for (size_t i = 0; i < LEN; i++) {
+      noise += (exact[i] - y[i]) * (exact[i] - y[i]);
+      power += exact[i] * exact[i];
+    }
+  }
+  return 10 * std::log10(noise / power);
+}
+
+template <template <typename> class Topology>
+void measure(std::ostream &out, const char *topology,
+             const Coefficients &coefficients, const char *filter) {
+  std::string suffix = std::string(": ") + filter;
+  printResult(out, (std::string(topology) + suffix).c_str(),
+              throughput<Topology>(coefficients), "ns/sample");
+  printResult(out, (std::string(topology) + " noise" + suffix).c_str(),
+              noiseFloor<Topology>(coefficients), "dB");
+}
+
+void topologies(std::ostream &out) {
+  struct Filter {
+    const char *name;
+    Coefficients coefficients;
+  };
+  Filter filters[4];
+  filters[0].name = "low-pass 1k at 48k";
+  BiQuad::Butterworth::configureLowPass(filters[0].coefficients, 48000, 1000);
+  filters[1].name = "high-pass 20 at 192k";
+  BiQuad::Butterworth::configureHighPass(filters[1].coefficients, 192000, 20);
+  filters[2].name = "low-pass 20 at 192k";
+  BiQuad::Butterworth::configureLowPass(filters[2].coefficients, 192000, 20);
+  filters[3].name = "parametric 3k at 48k";
+  BiQuad::Parametric::configure(filters[3].coefficients, 48000, 3000, 4, 1);
+  for (const Filter &filter : filters) {
+    measure<BiQuadDirectForm1>(out, "DF-I", filter.coefficients, filter.name);
+    measure<BiQuadTransposedDirectForm2>(out, "TDF-II", filter.coefficients,
+                                         filter.name);
+    measure<BiQuadStateVariable>(out, "SVF", filter.coefficients,
+                                 filter.name);
+  }
+}
+
+Benchmark topologiesBenchmark(
+    "BiQuad topologies: throughput and noise floor in float", topologies);
+
+} // namespace
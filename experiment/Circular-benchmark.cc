@@ -0,0 +1,84 @@
+//
+// Created by michel on 15-10-26.
+//
+
+#include "benchmark.h"
+#include <org-simple/Circular.h>
+#include <string>
+#include <vector>
+
+using namespace org::simple;
+using namespace org::simple::benchmark;
+
+namespace {
+
+static constexpr size_t ELEMENTS = 1000;
+static constexpr size_t OPERATIONS = 1 << 20;
+static constexpr size_t REPEATS = 5;
+static constexpr size_t STRIDE = 7919;
+
+/**
+ * Reads from a delay line at indices that are wrapped from an ever increasing
+ * position, like a reader with a fixed delay does.
+ */
+template <class Metric> double wrapping(const Metric &metric) {
+  std::vector<float> data(metric.elements(), 1.0f);
+  return nanosPerOperation(OPERATIONS, REPEATS, [&]() {
+    float sum = 0;
+    size_t position = 0;
+    for (size_t i = 0; i < OPERATIONS; i++) {
+      position += STRIDE;
+      sum += data[metric.wrapped(position)];
+    }
+    doNotOptimize(sum);
+  });
+}
+
+/**
+ * Advances an index by a delay that is smaller than the number of elements,
+ * either with a safe add() or with unsafe_add(), that may use a conditional
+ * subtraction.
+ */
+template <class Metric, bool unsafe> double adding(const Metric &metric) {
+  std::vector<float> data(metric.elements(), 1.0f);
+  size_t delta = metric.elements() / 3 + 1;
+  return nanosPerOperation(OPERATIONS, REPEATS, [&]() {
+    float sum = 0;
+    size_t index = 0;
+    for (size_t i = 0; i < OPERATIONS; i++) {
+      if constexpr (unsafe) {
+        index = metric.unsafe_add(index, delta);
+      } else {
+        index = metric.add(index, delta);
+      }
+      sum += data[index];
+    }
+    doNotOptimize(sum);
+  });
+}
+
+template <WrappingType type> void measure(std::ostream &out, const char *name) {
+  Circular::Metric<type> metric(ELEMENTS);
+  std::string label = name;
+  printResult(out, (label + ": wrapped").c_str(), wrapping(metric));
+  printResult(out, (label + ": add").c_str(),
+              adding<decltype(metric), false>(metric));
+  printResult(out, (label + ": unsafe_add").c_str(),
+              adding<decltype(metric), true>(metric));
+}
+
+void wrappingTypes(std::ostream &out) {
+  measure<WrappingType::BIT_MASK>(out, "BIT_MASK (1024)");
+  measure<WrappingType::MODULO>(out, "MODULO (1000)");
+  measure<WrappingType::FAST_MODULO>(out, "FAST_MODULO (1000)");
+  printResult(
+      out, "FixedMetric MODULO (1000): wrapped",
+      wrapping(Circular::FixedMetric<WrappingType::MODULO, ELEMENTS>()));
+  printResult(
+      out, "FixedMetric FAST_MODULO (1000): wrapped",
+      wrapping(Circular::FixedMetric<WrappingType::FAST_MODULO, ELEMENTS>()));
+}
+
+Benchmark wrappingBenchmark("Circular: wrapping types", wrappingTypes);
+
+} // namespace
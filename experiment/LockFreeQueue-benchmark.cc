@@ -0,0 +1,80 @@
+//
+// Created by michel on 15-10-26.
+//
+
+#include "benchmark.h"
+#include <org-simple/LockFreeQueue.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace org::simple;
+using namespace org::simple::benchmark;
+
+namespace {
+
+static constexpr size_t CAPACITY = 1024;
+static constexpr size_t TRANSFERS = 1 << 20;
+static constexpr size_t REPEATS = 3;
+
+/**
+ * Transfers TRANSFERS values from \c producers to \c consumers threads, where
+ * all threads spin on a full or empty queue. The result is the wall-clock time
+ * per transferred value, so lower is better and perfect scaling would divide
+ * it by the number of threads.
+ */
+template <class Queue>
+double contention(Queue &queue, size_t producers, size_t consumers) {
+  size_t perProducer = TRANSFERS / producers;
+  size_t total = perProducer * producers;
+  return nanosPerOperation(total, REPEATS, [&]() {
+    std::atomic_size_t received = 0;
+    std::vector<std::thread> threads;
+    for (size_t p = 0; p < producers; p++) {
+      threads.emplace_back([&]() {
+        for (size_t i = 0; i < perProducer; i++) {
+          while (!queue.write(i)) {
+            std::this_thread::yield();
+          }
+        }
+      });
+    }
+    for (size_t c = 0; c < consumers; c++) {
+      threads.emplace_back([&]() {
+        size_t value;
+        size_t sum = 0;
+        while (received.load(std::memory_order_relaxed) < total) {
+          if (queue.read(value)) {
+            sum += value;
+            received.fetch_add(1, std::memory_order_relaxed);
+          } else {
+            std::this_thread::yield();
+          }
+        }
+        doNotOptimize(sum);
+      });
+    }
+    for (auto &thread : threads) {
+      thread.join();
+    }
+  });
+}
+
+void scaling(std::ostream &out) {
+  size_t maxThreads = std::max(4u, std::thread::hardware_concurrency());
+  for (size_t threads = 1; threads <= maxThreads; threads *= 2) {
+    LockFreeQueue::MultiProducerSingleConsumer<size_t, CAPACITY> mpsc;
+    LockFreeQueue::MultiProducerMultiConsumer<size_t, CAPACITY> mpmc;
+    std::string label = "MPSC: " + std::to_string(threads) + " producers";
+    printResult(out, label.c_str(), contention(mpsc, threads, 1));
+    label = "MPMC: " + std::to_string(threads) + " producers, 1 consumer";
+    printResult(out, label.c_str(), contention(mpmc, threads, 1));
+    label = "MPMC: " + std::to_string(threads) + " producers and consumers";
+    printResult(out, label.c_str(), contention(mpmc, threads, threads));
+  }
+}
+
+Benchmark scalingBenchmark("LockFreeQueue: contention from 1 to N threads",
+                           scaling);
+
+} // namespace
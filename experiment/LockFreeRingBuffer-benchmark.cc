@@ -0,0 +1,170 @@
+//
+// Created by michel on 15-10-26.
+//
+
+#include "benchmark.h"
+#include <org-simple/LockfreeRingBuffer.h>
+#include <thread>
+
+using namespace org::simple;
+using namespace org::simple::benchmark;
+
+namespace {
+
+static constexpr size_t CAPACITY = 1024;
+static constexpr size_t BLOCK = 256;
+static constexpr size_t BLOCKS = 4096;
+static constexpr size_t REPEATS = 5;
+
+template <class Buffer> double perElement(Buffer &buffer) {
+  float block[BLOCK];
+  for (size_t i = 0; i < BLOCK; i++) {
+    block[i] = i;
+  }
+  return nanosPerOperation(BLOCK * BLOCKS, REPEATS, [&]() {
+    for (size_t n = 0; n < BLOCKS; n++) {
+      for (size_t i = 0; i < BLOCK; i++) {
+        buffer.write(block[i]);
+      }
+      for (size_t i = 0; i < BLOCK; i++) {
+        buffer.read(block[i]);
+      }
+    }
+    doNotOptimize(block);
+  });
+}
+
+template <class Buffer> double bulk(Buffer &buffer) {
+  float block[BLOCK];
+  for (size_t i = 0; i < BLOCK; i++) {
+    block[i] = i;
+  }
+  return nanosPerOperation(BLOCK * BLOCKS, REPEATS, [&]() {
+    for (size_t n = 0; n < BLOCKS; n++) {
+      buffer.write(block, BLOCK);
+      buffer.read(block, BLOCK);
+    }
+    doNotOptimize(block);
+  });
+}
+
+template <class Buffer> double zeroCopy(Buffer &buffer) {
+  float sum = 0;
+  return nanosPerOperation(BLOCK * BLOCKS, REPEATS, [&]() {
+    for (size_t n = 0; n < BLOCKS; n++) {
+      auto w = buffer.acquire_write(BLOCK);
+      for (size_t i = 0; i < w.first.size(); i++) {
+        w.first[i] = i;
+      }
+      for (size_t i = 0; i < w.second.size(); i++) {
+        w.second[i] = i;
+      }
+      buffer.commit(w.size());
+      auto r = buffer.acquire_read(BLOCK);
+      for (float v : r.first) {
+        sum += v;
+      }
+      for (float v : r.second) {
+        sum += v;
+      }
+      buffer.consume(r.size());
+    }
+    doNotOptimize(sum);
+  });
+}
+
+void blockTransfer(std::ostream &out) {
+  RingBufferLockFreeFixedSize<float, CAPACITY> fixed;
+  float data[CAPACITY];
+  RingBufferLockFree<float>::Metric metric(CAPACITY);
+  RingBufferLockFree<float> variable(metric, data);
+
+  printResult(out, "MonotonicFixed: per element", perElement(fixed));
+  printResult(out, "MonotonicFixed: bulk write/read", bulk(fixed));
+  printResult(out, "MonotonicFixed: acquire/commit", zeroCopy(fixed));
+  printResult(out, "Monotonic: per element", perElement(variable));
+  printResult(out, "Monotonic: bulk write/read", bulk(variable));
+  printResult(out, "Monotonic: acquire/commit", zeroCopy(variable));
+
+  LockFreeRingBuffer::MonotonicFixed<
+      float, CAPACITY,
+      LockFreeRingBuffer::SharedIndices<LockFreeRingBuffer::AcquireRelease>>
+      fixedAcqRel;
+  printResult(out, "MonotonicFixed: per element, acquire/release",
+              perElement(fixedAcqRel));
+  printResult(out, "MonotonicFixed: acquire/commit, acquire/release",
+              zeroCopy(fixedAcqRel));
+
+  LockFreeRingBuffer::MonotonicFixed<float, CAPACITY,
+                                     LockFreeRingBuffer::SharedIndices<>,
+                                     LockFreeRingBuffer::CountingStatistics>
+      fixedCounting;
+  printResult(out, "MonotonicFixed: per element, counting statistics",
+              perElement(fixedCounting));
+  printResult(out, "MonotonicFixed: bulk, counting statistics",
+              bulk(fixedCounting));
+}
+
+Benchmark blockTransferBenchmark("LockFreeRingBuffer: 256-frame blocks",
+                                 blockTransfer);
+
+static constexpr size_t TRANSFERS = 1 << 22;
+
+/**
+ * Moves single elements from a producer to a consumer thread, where both spin
+ * on a full or empty buffer, so that the cost is dominated by the exchange of
+ * the indices between the cores.
+ */
+template <class Buffer> double twoThreads(Buffer &buffer) {
+  return nanosPerOperation(TRANSFERS, REPEATS, [&]() {
+    std::thread producer([&]() {
+      for (size_t i = 0; i < TRANSFERS; i++) {
+        while (!buffer.write(float(i))) {
+          std::this_thread::yield();
+        }
+      }
+    });
+    float sum = 0;
+    float value;
+    for (size_t i = 0; i < TRANSFERS; i++) {
+      while (!buffer.read(value)) {
+        std::this_thread::yield();
+      }
+      sum += value;
+    }
+    producer.join();
+    doNotOptimize(sum);
+  });
+}
+
+void twoThreadTransfer(std::ostream &out) {
+  RingBufferLockFreeFixedSize<float, CAPACITY> fixed;
+  RingBufferLockFreeFixedSizePadded<float, CAPACITY> fixedPadded;
+  float data[CAPACITY];
+  RingBufferLockFree<float>::Metric metric(CAPACITY);
+  RingBufferLockFree<float> variable(metric, data);
+  float paddedData[CAPACITY];
+  RingBufferLockFreePadded<float> variablePadded(metric, paddedData);
+
+  printResult(out, "MonotonicFixed: shared indices", twoThreads(fixed));
+  printResult(out, "MonotonicFixed: padded indices", twoThreads(fixedPadded));
+  printResult(out, "Monotonic: shared indices", twoThreads(variable));
+  printResult(out, "Monotonic: padded indices", twoThreads(variablePadded));
+
+  using SharedAcqRel =
+      LockFreeRingBuffer::SharedIndices<LockFreeRingBuffer::AcquireRelease>;
+  using PaddedAcqRel =
+      LockFreeRingBuffer::PaddedIndices<LockFreeRingBuffer::AcquireRelease>;
+  LockFreeRingBuffer::MonotonicFixed<float, CAPACITY, SharedAcqRel> fixedAcqRel;
+  LockFreeRingBuffer::MonotonicFixed<float, CAPACITY, PaddedAcqRel>
+      fixedPaddedAcqRel;
+  printResult(out, "MonotonicFixed: shared indices, acquire/release",
+              twoThreads(fixedAcqRel));
+  printResult(out, "MonotonicFixed: padded indices, acquire/release",
+              twoThreads(fixedPaddedAcqRel));
+}
+
+Benchmark twoThreadBenchmark("LockFreeRingBuffer: producer and consumer thread",
+                             twoThreadTransfer);
+
+} // namespace
@@ -0,0 +1,71 @@
+//
+// Created by michel on 15-10-26.
+//
+
+#include "benchmark.h"
+#include <org-simple/NumArray.h>
+#include <string>
+#include <vector>
+
+using namespace org::simple;
+using namespace org::simple::benchmark;
+
+namespace {
+
+static constexpr size_t FRAMES = 32;
+static constexpr size_t ROUNDS = 16000;
+static constexpr size_t REPEATS = 5;
+static constexpr size_t ALIGNMENT = 32;
+
+/**
+ * Mixes two frames of ELEMENTS channels with a gain each, for a period of
+ * frames. Evaluated eagerly, <code>a * g + b * h</code> stores two
+ * temporaries and reads them back, so per element it does four loads and
+ * three stores, plus the copy into the output. The fused expression does two
+ * loads and one store. The period is small enough to stay in the L1 cache, so
+ * that the difference is not hidden behind memory bandwidth.
+ */
+template <size_t ELEMENTS, bool fused> double mix() {
+  using Frame = NumArray<float, ELEMENTS, ALIGNMENT>;
+  std::vector<Frame> a(FRAMES);
+  std::vector<Frame> b(FRAMES);
+  std::vector<Frame> out(FRAMES);
+  for (size_t frame = 0; frame < FRAMES; frame++) {
+    a[frame].fill(float(frame));
+    b[frame].fill(1.0f / float(frame + 1));
+  }
+  return nanosPerOperation(ROUNDS * FRAMES, REPEATS, [&]() {
+    for (size_t round = 0; round < ROUNDS; round++) {
+      // Gains that change, like they do when automated
+      float g = 0.75f + 1e-6f * float(round);
+      float h = 1.0f - g;
+      for (size_t frame = 0; frame < FRAMES; frame++) {
+        if constexpr (fused) {
+          out[frame] = a[frame].lazy() * g + b[frame].lazy() * h;
+        } else {
+          out[frame] = a[frame] * g + b[frame] * h;
+        }
+      }
+      doNotOptimize(out[round % FRAMES][0]);
+    }
+  });
+}
+
+template <size_t ELEMENTS> void measure(std::ostream &out) {
+  std::string suffix = ": " + std::to_string(ELEMENTS) + " elements";
+  printResult(out, ("eager operators" + suffix).c_str(),
+              mix<ELEMENTS, false>(), "ns/frame");
+  printResult(out, ("fused expression" + suffix).c_str(),
+              mix<ELEMENTS, true>(), "ns/frame");
+}
+
+void sizes(std::ostream &out) {
+  measure<8>(out);
+  measure<16>(out);
+  measure<32>(out);
+  measure<64>(out);
+}
+
+Benchmark sizesBenchmark("NumArray: a * g + b * h, eager versus fused", sizes);
+
+} // namespace
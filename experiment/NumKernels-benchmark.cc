@@ -0,0 +1,129 @@
+//
+// Created by michel on 15-10-26.
+//
+
+#include "benchmark.h"
+#include <complex>
+#include <org-simple/AlignedData.h>
+#include <org-simple/NumKernels.h>
+#include <string>
+
+using namespace org::simple;
+using namespace org::simple::benchmark;
+
+namespace {
+
+static constexpr size_t ELEMENTS = 1024;
+static constexpr size_t ROUNDS = 2000;
+static constexpr size_t REPEATS = 5;
+static constexpr size_t ALIGNMENT = 64;
+
+using Floats = AlignedArray<float, ELEMENTS, ALIGNMENT>;
+using Complexes = AlignedArray<std::complex<float>, ELEMENTS / 2, ALIGNMENT>;
+
+struct Data {
+  Floats a;
+  Floats b;
+  Floats c;
+  Floats d;
+  Complexes x;
+  Complexes y;
+  Complexes z;
+
+  Data() {
+    for (size_t i = 0; i < ELEMENTS; i++) {
+      a[i] = float(i % 17) / 16;
+      b[i] = float(i % 13) / 12;
+      c[i] = 0.5f;
+    }
+    for (size_t i = 0; i < ELEMENTS / 2; i++) {
+      x[i] = {a[i], b[i]};
+      y[i] = {b[i], a[i]};
+    }
+  }
+};
+
+/**
+ * The loops that the kernels replace, as the compiler vectorizes them for the
+ * baseline of the target.
+ */
+struct Loops {
+  static float dot(const float *a, const float *b, size_t count) {
+    float sum = 0;
+    for (size_t i = 0; i < count; i++) {
+      sum += a[i] * b[i];
+    }
+    return sum;
+  }
+  static void fma(float *d, const float *a, const float *b, const float *c,
+                  size_t count) {
+    for (size_t i = 0; i < count; i++) {
+      d[i] = a[i] * b[i] + c[i];
+    }
+  }
+  static void multiply(std::complex<float> *z, const std::complex<float> *x,
+                       const std::complex<float> *y, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+      z[i] = x[i] * y[i];
+    }
+  }
+};
+
+template <class Real, class Complex>
+void measure(std::ostream &out, const char *name, Real real, Complex complex) {
+  Data data;
+  std::string suffix = std::string(": ") + name;
+  printResult(out, ("float dot" + suffix).c_str(),
+              nanosPerOperation(ROUNDS * ELEMENTS, REPEATS,
+                                [&]() {
+                                  float sum = 0;
+                                  for (size_t r = 0; r < ROUNDS; r++) {
+                                    sum += real.dot(data.a.data(),
+                                                    data.b.data(), ELEMENTS);
+                                    doNotOptimize(sum);
+                                  }
+                                }),
+              "ns/element");
+  printResult(out, ("float fma" + suffix).c_str(),
+              nanosPerOperation(ROUNDS * ELEMENTS, REPEATS,
+                                [&]() {
+                                  for (size_t r = 0; r < ROUNDS; r++) {
+                                    real.fma(data.d.data(), data.a.data(),
+                                             data.b.data(), data.c.data(),
+                                             ELEMENTS);
+                                    doNotOptimize(data.d[r % ELEMENTS]);
+                                  }
+                                }),
+              "ns/element");
+  printResult(out, ("complex float multiply" + suffix).c_str(),
+              nanosPerOperation(ROUNDS * ELEMENTS / 2, REPEATS,
+                                [&]() {
+                                  for (size_t r = 0; r < ROUNDS; r++) {
+                                    complex.multiply(
+                                        data.z.data(), data.x.data(),
+                                        data.y.data(), ELEMENTS / 2);
+                                    doNotOptimize(data.z[r % 8]);
+                                  }
+                                }),
+              "ns/element");
+}
+
+void instructionSets(std::ostream &out) {
+  measure(out, "plain loops", Loops(), Loops());
+  for (auto instructions :
+       {SimdInstructions::SCALAR, SimdInstructions::VECTOR128,
+        SimdInstructions::AVX2, SimdInstructions::AVX512}) {
+    if (num_kernels::isSupported(instructions)) {
+      measure(out, num_kernels::name(instructions),
+              NumKernels<float, ALIGNMENT>::functions(instructions),
+              NumKernels<std::complex<float>, ALIGNMENT>::functions(
+                  instructions));
+    }
+  }
+}
+
+Benchmark instructionSetsBenchmark(
+    "NumKernels: plain loops versus kernels per instruction set",
+    instructionSets);
+
+} // namespace
@@ -0,0 +1,78 @@
+//
+// Created by michel on 15-10-26.
+//
+
+#include "benchmark.h"
+#include <algorithm>
+#include <org-simple/AlignedData.h>
+#include <org-simple/NumKernels.h>
+#include <string>
+#include <vector>
+
+using namespace org::simple;
+using namespace org::simple::benchmark;
+
+namespace {
+
+static constexpr size_t TOTAL = 1 << 22;
+static constexpr size_t REPEATS = 5;
+static constexpr size_t ALIGNMENT = 64;
+
+/**
+ * Statistics the way metering code often gathers them: a pass per value, each
+ * of them a single dependency chain that the compiler may not reorder.
+ */
+NumStatistics<float> separatePasses(const float *a, size_t count) {
+  NumStatistics<float> result;
+  result.count = count;
+  if (!count) {
+    return result;
+  }
+  result.minimum = *std::min_element(a, a + count);
+  result.maximum = *std::max_element(a, a + count);
+  for (size_t i = 0; i < count; i++) {
+    result.sum += a[i];
+  }
+  for (size_t i = 0; i < count; i++) {
+    result.sum_of_squares += a[i] * a[i];
+  }
+  return result;
+}
+
+template <class Statistics>
+double measure(const std::vector<float, AlignedAllocator<float, ALIGNMENT>> &a,
+               size_t count, Statistics statistics) {
+  const size_t rounds = TOTAL / count;
+  return nanosPerOperation(rounds * count, REPEATS, [&]() {
+    for (size_t round = 0; round < rounds; round++) {
+      auto result = statistics(a.data(), count);
+      doNotOptimize(result.sum);
+      doNotOptimize(result.maximum);
+    }
+  });
+}
+
+void sizes(std::ostream &out) {
+  static constexpr size_t MAX_COUNT = 4096;
+  std::vector<float, AlignedAllocator<float, ALIGNMENT>> a(MAX_COUNT);
+  fillSignal(a);
+  const auto &scalar = NumKernels<float, ALIGNMENT>::functions(
+      SimdInstructions::SCALAR);
+  const auto &best = NumKernels<float, ALIGNMENT>::functions();
+  std::string bestName =
+      std::string("fused ") + num_kernels::name(num_kernels::best());
+  for (size_t count = 4; count <= MAX_COUNT; count *= 4) {
+    std::string suffix = ": " + std::to_string(count) + " elements";
+    printResult(out, ("separate passes" + suffix).c_str(),
+                measure(a, count, separatePasses), "ns/element");
+    printResult(out, ("fused scalar" + suffix).c_str(),
+                measure(a, count, scalar.statistics), "ns/element");
+    printResult(out, (bestName + suffix).c_str(),
+                measure(a, count, best.statistics), "ns/element");
+  }
+}
+
+Benchmark sizesBenchmark(
+    "NumStatistics: separate passes versus fused compensated kernels", sizes);
+
+} // namespace
@@ -0,0 +1,95 @@
+//
+// Created by michel on 15-10-26.
+//
+
+#include "benchmark.h"
+#include <org-simple/ObjectPool.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace org::simple;
+using namespace org::simple::benchmark;
+
+namespace {
+
+static constexpr size_t BATCH = 16;
+static constexpr size_t ROUNDS = 1 << 15;
+static constexpr size_t REPEATS = 3;
+
+struct Message {
+  size_t id;
+  float payload[12];
+  explicit Message(size_t i) : id(i), payload{} {}
+};
+
+using Pool = ObjectPool<Message>;
+
+struct NewDelete {
+  Message *create(size_t id) { return new Message(id); }
+  void destroy(Message *message) { delete message; }
+};
+
+struct Shared {
+  Pool &pool;
+  Message *create(size_t id) { return pool.create(id); }
+  void destroy(Message *message) { pool.destroy(message); }
+};
+
+struct Cached {
+  Pool::Magazine magazine;
+  explicit Cached(Pool &pool) : magazine(pool) {}
+  Message *create(size_t id) { return magazine.create(id); }
+  void destroy(Message *message) { magazine.destroy(message); }
+};
+
+/**
+ * Lets \c threads threads each create and destroy batches of BATCH messages,
+ * where each thread obtains its allocator from \c make. The result is the
+ * wall-clock time per create and destroy pair.
+ */
+template <class Make> double churn(size_t threads, Make make) {
+  return nanosPerOperation(threads * ROUNDS * BATCH, REPEATS, [&]() {
+    std::vector<std::thread> workers;
+    for (size_t t = 0; t < threads; t++) {
+      workers.emplace_back([&]() {
+        auto allocator = make();
+        Message *messages[BATCH];
+        size_t sum = 0;
+        for (size_t round = 0; round < ROUNDS; round++) {
+          for (size_t i = 0; i < BATCH; i++) {
+            messages[i] = allocator.create(i);
+          }
+          for (size_t i = 0; i < BATCH; i++) {
+            sum += messages[i]->id;
+            allocator.destroy(messages[i]);
+          }
+        }
+        doNotOptimize(sum);
+      });
+    }
+    for (auto &worker : workers) {
+      worker.join();
+    }
+  });
+}
+
+void scaling(std::ostream &out) {
+  size_t maxThreads = std::max(4u, std::thread::hardware_concurrency());
+  for (size_t threads = 1; threads <= maxThreads; threads *= 2) {
+    // Magazines can hold slots that other threads cannot get
+    Pool pool(threads * (BATCH + 32));
+    std::string suffix = ": " + std::to_string(threads) + " threads";
+    printResult(out, ("new/delete" + suffix).c_str(),
+                churn(threads, []() { return NewDelete(); }));
+    printResult(out, ("pool, shared list" + suffix).c_str(),
+                churn(threads, [&pool]() { return Shared{pool}; }));
+    printResult(out, ("pool, magazines" + suffix).c_str(),
+                churn(threads, [&pool]() { return Cached(pool); }));
+  }
+}
+
+Benchmark scalingBenchmark("ObjectPool: create and destroy from 1 to N threads",
+                           scaling);
+
+} // namespace
@@ -0,0 +1,303 @@
+//
+// Created by michel on 15-10-26.
+//
+
+#include "benchmark.h"
+#include <org-simple/AlignedData.h>
+#include <org-simple/SampleLayout.h>
+#include <string>
+#include <vector>
+
+using namespace org::simple;
+using namespace org::simple::benchmark;
+
+namespace {
+
+static constexpr size_t TOTAL = 1 << 22;
+static constexpr size_t REPEATS = 5;
+
+using Buffer = std::vector<float, AlignedAllocator<float, 64>>;
+
+/**
+ * The loops that SampleLayout had before it used vectors.
+ */
+struct Loops {
+  static void toInterleaved(const float **channel_ptr, float *&output,
+                            size_t channels, size_t frames) {
+    for (size_t frame = 0; frame < frames; frame++) {
+      for (size_t channel = 0; channel < channels; channel++) {
+        *output++ = *channel_ptr[channel]++;
+      }
+    }
+  }
+  static void toChannels(const float *&input, float **channel_ptr,
+                         size_t channels, size_t frames) {
+    for (size_t frame = 0; frame < frames; frame++) {
+      for (size_t channel = 0; channel < channels; channel++) {
+        *channel_ptr[channel]++ = *input++;
+      }
+    }
+  }
+};
+
+template <size_t CHANNELS, size_t FRAMES> struct Data {
+  std::vector<Buffer> buffers;
+  Buffer interleaved;
+  const float *inputs[CHANNELS];
+  float *outputs[CHANNELS];
+
+  Data() : buffers(CHANNELS, Buffer(FRAMES)), interleaved(CHANNELS * FRAMES) {
+    for (size_t channel = 0; channel < CHANNELS; channel++) {
+      for (size_t frame = 0; frame < FRAMES; frame++) {
+        buffers[channel][frame] = float(channel * FRAMES + frame);
+      }
+    }
+  }
+
+  void reset() {
+    for (size_t channel = 0; channel < CHANNELS; channel++) {
+      inputs[channel] = buffers[channel].data();
+      outputs[channel] = buffers[channel].data();
+    }
+  }
+};
+
+template <size_t CHANNELS, size_t FRAMES, class Move>
+double measure(Data<CHANNELS, FRAMES> &data, Move move) {
+  static constexpr size_t ROUNDS = TOTAL / CHANNELS / FRAMES + 1;
+  return nanosPerOperation(ROUNDS * FRAMES, REPEATS, [&]() {
+    for (size_t round = 0; round < ROUNDS; round++) {
+      data.reset();
+      move();
+      doNotOptimize(data.interleaved[round % FRAMES]);
+    }
+  });
+}
+
+template <size_t CHANNELS, size_t FRAMES> void measure(std::ostream &out) {
+  Data<CHANNELS, FRAMES> data;
+  std::string suffix = ": " + std::to_string(CHANNELS) + " channels, " +
+                       std::to_string(FRAMES) + " frames";
+  auto interleave = [&](auto variant) {
+    return measure(data, [&]() {
+      float *output = data.interleaved.data();
+      variant(data.inputs, output);
+    });
+  };
+  auto deinterleave = [&](auto variant) {
+    return measure(data, [&]() {
+      const float *input = data.interleaved.data();
+      variant(input, data.outputs);
+    });
+  };
+  printResult(out, ("interleave loops" + suffix).c_str(),
+              interleave([](const float **c, float *&o) {
+                Loops::toInterleaved(c, o, CHANNELS, FRAMES);
+              }),
+              "ns/frame");
+  printResult(out, ("interleave runtime channels" + suffix).c_str(),
+              interleave([](const float **c, float *&o) {
+                SampleLayout::channel_buffers_to_interleaved(c, o, CHANNELS,
+                                                             FRAMES);
+              }),
+              "ns/frame");
+  printResult(out, ("interleave compile-time channels" + suffix).c_str(),
+              interleave([](const float **c, float *&o) {
+                SampleLayout::channel_buffers_to_interleaved<float, CHANNELS,
+                                                             FRAMES>(c, o);
+              }),
+              "ns/frame");
+  printResult(out, ("deinterleave loops" + suffix).c_str(),
+              deinterleave([](const float *&i, float **c) {
+                Loops::toChannels(i, c, CHANNELS, FRAMES);
+              }),
+              "ns/frame");
+  printResult(out, ("deinterleave runtime channels" + suffix).c_str(),
+              deinterleave([](const float *&i, float **c) {
+                SampleLayout::interleaved_to_channel_buffers(i, c, CHANNELS,
+                                                             FRAMES);
+              }),
+              "ns/frame");
+  printResult(out, ("deinterleave compile-time channels" + suffix).c_str(),
+              deinterleave([](const float *&i, float **c) {
+                SampleLayout::interleaved_to_channel_buffers<float, CHANNELS,
+                                                             FRAMES>(i, c);
+              }),
+              "ns/frame");
+}
+
+template <size_t CHANNELS> void measureFrames(std::ostream &out) {
+  measure<CHANNELS, 64>(out);
+  measure<CHANNELS, 512>(out);
+  measure<CHANNELS, 4096>(out);
+}
+
+void channels(std::ostream &out) {
+  measureFrames<2>(out);
+  measureFrames<6>(out);
+  measureFrames<8>(out);
+  measureFrames<32>(out);
+}
+
+Benchmark channelsBenchmark(
+    "SampleLayout: interleaving with loops versus vectors", channels);
+
+/**
+ * Interleaves a planar view with a channel count that is only known at
+ * runtime, sample by sample and with SampleLayout::copy, that uses kernels
+ * for a compile-time number of channels when it can.
+ */
+void views(std::ostream &out) {
+  static constexpr size_t FRAMES = 512;
+  for (size_t channels : {2, 6, 8, 12, 32}) {
+    Buffer planar(channels * FRAMES, 0.5f);
+    Buffer interleaved(channels * FRAMES);
+    auto source = SampleView<const float>::planar(planar.data(), channels,
+                                                  FRAMES);
+    auto destination =
+        SampleView<float>::interleaved(interleaved.data(), channels, FRAMES);
+    const size_t rounds = TOTAL / channels / FRAMES + 1;
+    std::string suffix = ": " + std::to_string(channels) + " channels";
+    printResult(out, ("sample by sample" + suffix).c_str(),
+                nanosPerOperation(rounds * FRAMES, REPEATS,
+                                  [&]() {
+                                    for (size_t r = 0; r < rounds; r++) {
+                                      for (size_t f = 0; f < FRAMES; f++) {
+                                        for (size_t c = 0; c < channels; c++) {
+                                          destination(c, f) = source(c, f);
+                                        }
+                                      }
+                                      doNotOptimize(interleaved[r % FRAMES]);
+                                    }
+                                  }),
+                "ns/frame");
+    printResult(out, ("copy" + suffix).c_str(),
+                nanosPerOperation(rounds * FRAMES, REPEATS,
+                                  [&]() {
+                                    for (size_t r = 0; r < rounds; r++) {
+                                      SampleLayout::copy(source, destination);
+                                      doNotOptimize(interleaved[r % FRAMES]);
+                                    }
+                                  }),
+                "ns/frame");
+  }
+}
+
+Benchmark viewsBenchmark(
+    "SampleLayout: planar to interleaved view of 512 frames", views);
+
+/**
+ * Converts an interleaved period of PCM samples to float channel buffers and
+ * back, in two passes over an interleaved float period or fused.
+ */
+template <class Format>
+void measurePcm(std::ostream &out, const char *format, size_t channels,
+                size_t frames) {
+  using word = typename Format::word;
+  using Conversion = sample_layout::PcmConversion<Format, float>;
+  const size_t samples = channels * frames;
+  const size_t rounds = TOTAL / samples + 1;
+  std::vector<word> pcm(samples * Format::WORDS);
+  for (size_t i = 0; i < samples; i++) {
+    Format::write(pcm.data() + i * Format::WORDS, int32_t(i * 7919 % 32768));
+  }
+  Buffer interleaved(samples);
+  std::vector<Buffer> buffers(channels, Buffer(frames));
+  std::vector<float *> outputs(channels);
+  std::vector<const float *> inputs(channels);
+  auto reset = [&]() {
+    for (size_t channel = 0; channel < channels; channel++) {
+      outputs[channel] = buffers[channel].data();
+      inputs[channel] = buffers[channel].data();
+    }
+  };
+  std::string suffix = std::string(": ") + format + ", " +
+                       std::to_string(channels) + " channels, " +
+                       std::to_string(frames) + " frames";
+  printResult(out, ("to channels in two passes" + suffix).c_str(),
+              nanosPerOperation(rounds * frames, REPEATS,
+                                [&]() {
+                                  for (size_t r = 0; r < rounds; r++) {
+                                    reset();
+                                    Conversion::toFloats(interleaved.data(),
+                                                         pcm.data(), samples);
+                                    const float *input = interleaved.data();
+                                    SampleLayout::
+                                        interleaved_to_channel_buffers(
+                                            input, outputs.data(), channels,
+                                            frames);
+                                    doNotOptimize(buffers[0][r % frames]);
+                                  }
+                                }),
+              "ns/frame");
+  printResult(out, ("to channels fused" + suffix).c_str(),
+              nanosPerOperation(rounds * frames, REPEATS,
+                                [&]() {
+                                  for (size_t r = 0; r < rounds; r++) {
+                                    reset();
+                                    const word *input = pcm.data();
+                                    SampleLayout::pcm_to_channel_buffers<
+                                        Format>(input, outputs.data(),
+                                                channels, frames);
+                                    doNotOptimize(buffers[0][r % frames]);
+                                  }
+                                }),
+              "ns/frame");
+  printResult(out, ("from channels in two passes" + suffix).c_str(),
+              nanosPerOperation(rounds * frames, REPEATS,
+                                [&]() {
+                                  for (size_t r = 0; r < rounds; r++) {
+                                    reset();
+                                    float *output = interleaved.data();
+                                    SampleLayout::
+                                        channel_buffers_to_interleaved(
+                                            inputs.data(), output, channels,
+                                            frames);
+                                    Conversion::template fromFloats<false>(
+                                        pcm.data(), interleaved.data(),
+                                        nullptr, samples);
+                                    doNotOptimize(pcm[r % samples]);
+                                  }
+                                }),
+              "ns/frame");
+  printResult(out, ("from channels fused" + suffix).c_str(),
+              nanosPerOperation(rounds * frames, REPEATS,
+                                [&]() {
+                                  for (size_t r = 0; r < rounds; r++) {
+                                    reset();
+                                    word *output = pcm.data();
+                                    SampleLayout::channel_buffers_to_pcm<
+                                        Format>(inputs.data(), output,
+                                                channels, frames);
+                                    doNotOptimize(pcm[r % samples]);
+                                  }
+                                }),
+              "ns/frame");
+  sample_layout::TpdfDither dither;
+  printResult(out, ("from channels fused with dither" + suffix).c_str(),
+              nanosPerOperation(rounds * frames, REPEATS,
+                                [&]() {
+                                  for (size_t r = 0; r < rounds; r++) {
+                                    reset();
+                                    word *output = pcm.data();
+                                    SampleLayout::channel_buffers_to_pcm<
+                                        Format>(inputs.data(), output,
+                                                channels, frames, &dither);
+                                    doNotOptimize(pcm[r % samples]);
+                                  }
+                                }),
+              "ns/frame");
+}
+
+void pcm(std::ostream &out) {
+  for (size_t frames : {256, 4096}) {
+    measurePcm<sample_layout::Pcm16>(out, "int16", 8, frames);
+    measurePcm<sample_layout::PackedPcm24>(out, "packed int24", 8, frames);
+    measurePcm<sample_layout::Pcm32>(out, "int32", 8, frames);
+  }
+}
+
+Benchmark pcmBenchmark(
+    "SampleLayout: PCM conversion in two passes versus fused", pcm);
+
+} // namespace
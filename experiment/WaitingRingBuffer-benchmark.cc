@@ -0,0 +1,119 @@
+//
+// Created by michel on 15-10-26.
+//
+
+#include "benchmark.h"
+#include <ctime>
+#include <org-simple/WaitingRingBuffer.h>
+#include <string>
+#include <thread>
+
+using namespace org::simple;
+using namespace org::simple::benchmark;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+using Buffer = WaitingRingBuffer<RingBufferLockFreeFixedSize<int64_t, 256>>;
+
+static constexpr int MESSAGES = 2000;
+static constexpr std::chrono::microseconds INTERVAL{200};
+
+int64_t nowNanos() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             Clock::now().time_since_epoch())
+      .count();
+}
+
+double threadCpuNanos() {
+  timespec t;
+  clock_gettime(CLOCK_THREAD_CPUTIME_ID, &t);
+  return 1e9 * t.tv_sec + t.tv_nsec;
+}
+
+/**
+ * A producer sends a time stamp every INTERVAL, while the consumer obtains it
+ * with \c receive. Reports the average latency between sending and receiving
+ * and the fraction of a core that the consumer used while doing so.
+ */
+template <class Receive>
+void measure(std::ostream &out, const char *name, Receive receive) {
+  Buffer buffer;
+  std::thread producer([&buffer]() {
+    auto next = Clock::now();
+    for (int i = 0; i < MESSAGES; i++) {
+      next += INTERVAL;
+      std::this_thread::sleep_until(next);
+      buffer.write(nowNanos());
+    }
+  });
+  double latency = 0;
+  auto start = Clock::now();
+  double cpuStart = threadCpuNanos();
+  for (int i = 0; i < MESSAGES; i++) {
+    int64_t sent = receive(buffer);
+    latency += nowNanos() - sent;
+  }
+  double cpu = threadCpuNanos() - cpuStart;
+  std::chrono::duration<double, std::nano> wall = Clock::now() - start;
+  producer.join();
+
+  std::string label = name;
+  printResult(out, (label + ": latency").c_str(), 1e-3 * latency / MESSAGES,
+              "us");
+  printResult(out, (label + ": consumer CPU").c_str(),
+              100.0 * cpu / wall.count(), "%");
+}
+
+void waitingVersusPolling(std::ostream &out) {
+  measure(out, "Busy polling", [](Buffer &buffer) {
+    int64_t value;
+    while (!buffer.read(value)) {
+    }
+    return value;
+  });
+  measure(out, "Polling with 50us sleep", [](Buffer &buffer) {
+    int64_t value;
+    while (!buffer.read(value)) {
+      std::this_thread::sleep_for(std::chrono::microseconds(50));
+    }
+    return value;
+  });
+  measure(out, "read_wait", [](Buffer &buffer) {
+    int64_t value = 0;
+    buffer.read_wait(value, TimeoutNever::instance());
+    return value;
+  });
+}
+
+Benchmark waitingBenchmark("WaitingRingBuffer: latency and CPU usage",
+                           waitingVersusPolling);
+
+/**
+ * Writes and reads a value in a single thread, so that nobody is ever parked
+ * and only the cost of notifying remains.
+ */
+template <class B> double notifyCost() {
+  static constexpr size_t OPERATIONS = 1 << 22;
+  B buffer;
+  return nanosPerOperation(OPERATIONS, 5, [&buffer]() {
+    int64_t value = 0;
+    for (size_t i = 0; i < OPERATIONS; i++) {
+      buffer.write(value);
+      buffer.read(value);
+      doNotOptimize(value);
+    }
+  });
+}
+
+void notifyWithoutWaiters(std::ostream &out) {
+  printResult(out, "RingBufferLockFreeFixedSize write and read",
+              notifyCost<RingBufferLockFreeFixedSize<int64_t, 256>>(), "ns");
+  printResult(out, "WaitingRingBuffer write and read", notifyCost<Buffer>(),
+              "ns");
+}
+
+Benchmark notifyBenchmark("WaitingRingBuffer: cost of notify without waiters",
+                          notifyWithoutWaiters);
+
+} // namespace
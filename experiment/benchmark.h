@@ -0,0 +1,120 @@
+#ifndef ORG_SIMPLE_BENCHMARK_H
+#define ORG_SIMPLE_BENCHMARK_H
+/*
+ * org-simple/benchmark.h
+ *
+ * Added by michel on 2026-10-15
+ * Copyright (C) 2015-2026 Michel Fleur.
+ * Source https://github.com/emmef/org-simple
+ * Email org-simple@emmef.org
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+
+namespace org::simple::benchmark {
+
+/**
+ * A named benchmark that registers itself on construction, so that a benchmark
+ * source file only needs to define a static instance to be picked up by the
+ * benchmark runner.
+ */
+class Benchmark {
+public:
+  typedef void (*Function)(std::ostream &out);
+
+  Benchmark(const char *name, Function function)
+      : name_(name), function_(function), next_(first()) {
+    first() = this;
+  }
+
+  const char *name() const { return name_; }
+  void run(std::ostream &out) const { function_(out); }
+  const Benchmark *next() const { return next_; }
+
+  static Benchmark *&first() {
+    static Benchmark *instance = nullptr;
+    return instance;
+  }
+
+private:
+  const char *name_;
+  Function function_;
+  const Benchmark *next_;
+};
+
+/**
+ * Prevents the compiler from optimizing away the computation of \c value.
+ */
+template <typename T> inline void doNotOptimize(const T &value) {
+  asm volatile("" : : "r,m"(value) : "memory");
+}
+
+/**
+ * Runs \c function, that performs \c operations operations, \c repeats times
+ * and returns the lowest measured time per operation in nanoseconds.
+ * @param operations The number of operations performed by one invocation.
+ * @param repeats The number of times to invoke the function.
+ * @param function The function to measure.
+ * @return The lowest measured number of nanoseconds per operation.
+ */
+template <class F>
+double nanosPerOperation(size_t operations, size_t repeats, F function) {
+  using clock = std::chrono::steady_clock;
+  double best = std::numeric_limits<double>::max();
+  for (size_t repeat = 0; repeat < repeats; repeat++) {
+    auto start = clock::now();
+    function();
+    std::chrono::duration<double, std::nano> elapsed = clock::now() - start;
+    best = std::min(best, elapsed.count() / std::max(operations, size_t(1)));
+  }
+  return best;
+}
+
+/**
+ * Returns sample \c index of a deterministic, noise-like input signal in the
+ * range [-1, 1], so that benchmarks are repeatable.
+ */
+template <typename T> inline T signalSample(size_t index) {
+  return T(int(index * 7919 % 2001) - 1000) / 1000;
+}
+
+/**
+ * Fills \c buffer with signalSample(), starting at sample \c offset.
+ */
+template <class Buffer> void fillSignal(Buffer &buffer, size_t offset = 0) {
+  using T = typename Buffer::value_type;
+  for (size_t i = 0; i < buffer.size(); i++) {
+    buffer[i] = signalSample<T>(offset + i);
+  }
+}
+
+/**
+ * Prints a single result line with a label, the value and its unit.
+ */
+inline void printResult(std::ostream &out, const char *label, double value,
+                        const char *unit = "ns/op") {
+  out << "  " << std::left << std::setw(48) << label << std::right
+      << std::setw(12) << std::fixed << std::setprecision(3) << value << " "
+      << unit << std::endl;
+}
+
+} // namespace org::simple::benchmark
+
+#endif // ORG_SIMPLE_BENCHMARK_H
@@ -0,0 +1,35 @@
+//
+// Created by michel on 15-10-26.
+//
+
+#include "benchmark.h"
+#include <cstring>
+#include <vector>
+
+using org::simple::benchmark::Benchmark;
+
+/**
+ * Runs all registered benchmarks in order of name, or only those whose name
+ * contains one of the command line arguments.
+ */
+int main(int argc, char **argv) {
+  std::vector<const Benchmark *> benchmarks;
+  for (const Benchmark *b = Benchmark::first(); b; b = b->next()) {
+    bool selected = argc < 2;
+    for (int i = 1; i < argc && !selected; i++) {
+      selected = strstr(b->name(), argv[i]) != nullptr;
+    }
+    if (selected) {
+      benchmarks.push_back(b);
+    }
+  }
+  std::sort(benchmarks.begin(), benchmarks.end(),
+            [](const Benchmark *b1, const Benchmark *b2) {
+              return strcmp(b1->name(), b2->name()) < 0;
+            });
+  for (const Benchmark *b : benchmarks) {
+    std::cout << b->name() << std::endl;
+    b->run(std::cout);
+  }
+  return 0;
+}
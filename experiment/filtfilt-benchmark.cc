@@ -0,0 +1,68 @@
+//
+// Created by michel on 16-10-26.
+//
+
+#include "benchmark.h"
+#include <org-simple/AlignedData.h>
+#include <org-simple/dsp/filtfilt.h>
+#include <vector>
+
+using namespace org::simple;
+using namespace org::simple::benchmark;
+using namespace org::simple::dsp;
+
+namespace {
+
+static constexpr size_t REPEATS = 5;
+
+using Buffer = std::vector<float, AlignedAllocator<float, 64>>;
+
+Buffer signal(size_t len) {
+  Buffer x(len);
+  fillSignal(x);
+  return x;
+}
+
+/**
+ * Filters forward into an intermediate buffer of the full length and then
+ * backward into the output, without padding.
+ */
+double twoPasses(size_t len, const BiQuad::Coefficients<float> &coefficients) {
+  Buffer x = signal(len);
+  Buffer forward(len);
+  Buffer y(len);
+  return nanosPerOperation(len, REPEATS, [&]() {
+    BiQuad::History<float> history;
+    coefficients.applyWithHistory(x.data(), forward.data(), len, history);
+    history.zero();
+    coefficients.applyBackwardsWithHistory(forward.data(), y.data(), len,
+                                           history);
+    doNotOptimize(y[len / 2]);
+  });
+}
+
+double fused(size_t len, const BiQuad::Coefficients<float> &coefficients) {
+  Buffer x = signal(len);
+  Buffer y(len);
+  return nanosPerOperation(len, REPEATS, [&]() {
+    filtfilt(coefficients, x.data(), y.data(), len);
+    doNotOptimize(y[len / 2]);
+  });
+}
+
+void zeroPhase(std::ostream &out) {
+  BiQuad::Coefficients<float> coefficients;
+  BiQuad::Butterworth::configureLowPass(coefficients, 48000, 1000);
+  for (size_t len : {size_t(1) << 12, size_t(1) << 24}) {
+    const std::string suffix = " " + std::to_string(len) + " samples";
+    printResult(out, ("two passes" + suffix).c_str(),
+                twoPasses(len, coefficients), "ns/sample");
+    printResult(out, ("filtfilt" + suffix).c_str(), fused(len, coefficients),
+                "ns/sample");
+  }
+}
+
+Benchmark zeroPhaseBenchmark(
+    "Zero-phase BiQuad: two full-length passes versus filtfilt", zeroPhase);
+
+} // namespace
@@ -0,0 +1,90 @@
+//
+// Created by michel on 16-10-26.
+//
+
+#include "benchmark.h"
+#include <cmath>
+#include <org-simple/dsp/iir-filter.h>
+#include <string>
+#include <vector>
+
+using namespace org::simple::benchmark;
+using namespace org::simple::dsp;
+
+namespace {
+
+static constexpr size_t LEN = 4096;
+static constexpr size_t ROUNDS = 256;
+static constexpr size_t REPEATS = 5;
+
+template <size_t ORDER> struct Filter {
+  double ff[ORDER + 1];
+  double fb[ORDER + 1] = {1};
+  std::vector<double> x;
+  std::vector<double> y;
+  double xHistory[ORDER] = {};
+  double yHistory[ORDER] = {};
+
+  Filter() : x(LEN + ORDER), y(LEN + ORDER) {
+    for (size_t k = 0; k < ORDER; k++) {
+      const double p = 0.9 * std::cos(M_PI * (k + 0.5) / ORDER);
+      for (size_t j = k + 1; j > 0; j--) {
+        fb[j] -= p * fb[j - 1];
+      }
+    }
+    for (size_t j = 0; j <= ORDER; j++) {
+      ff[j] = 1.0 / double(j + 2);
+    }
+    fillSignal(x);
+  }
+
+  template <class Function> double measure(Function function) {
+    return nanosPerOperation(ROUNDS * LEN, REPEATS, [&]() {
+      for (size_t round = 0; round < ROUNDS; round++) {
+        function();
+        doNotOptimize(y[round % LEN]);
+      }
+    });
+  }
+};
+
+template <size_t ORDER> void measureOrder(std::ostream &out) {
+  Filter<ORDER> filter;
+  const std::string suffix = " order " + std::to_string(ORDER);
+  printResult(out, ("filter_single_fo" + suffix).c_str(),
+              filter.measure([&]() {
+                for (size_t i = 0; i < LEN; i++) {
+                  filter.y[i] = filter_single_fo<double, double, ORDER>(
+                      filter.xHistory, filter.yHistory, filter.ff, filter.fb,
+                      filter.x[i]);
+                }
+              }),
+              "ns/sample");
+  printResult(out, ("filter_forward_foo" + suffix).c_str(),
+              filter.measure([&]() {
+                filter_forward_foo<double, double, ORDER>(
+                    LEN, filter.ff, filter.fb, filter.x.data(),
+                    filter.y.data());
+              }),
+              "ns/sample");
+  printResult(out, ("filter_forward_foh" + suffix).c_str(),
+              filter.measure([&]() {
+                filter_forward_foh<double, double, ORDER>(
+                    LEN, filter.ff, filter.fb, filter.x.data(),
+                    filter.y.data(), filter.xHistory, filter.yHistory);
+              }),
+              "ns/sample");
+}
+
+void fixedOrder(std::ostream &out) {
+  measureOrder<1>(out);
+  measureOrder<2>(out);
+  measureOrder<4>(out);
+  measureOrder<8>(out);
+}
+
+Benchmark fixedOrderBenchmark(
+    "IIR filter of fixed order: shifting, offsets and unrolled kernel",
+    fixedOrder);
+
+} // namespace
@@ -26,8 +26,23 @@
 #include <cstdint>
 #include <limits>
 
+/**
+ * The assumed size of a cache line, used to separate data that is written by
+ * different threads. This is the value of \c
+ * std::hardware_destructive_interference_size on most platforms, but as that
+ * value may differ between compilers and tuning flags, it is not used directly
+ * so that it cannot silently change the layout of types. Define this when
+ * building for a platform with a different cache line size.
+ */
+#ifndef ORG_SIMPLE_CACHE_LINE_SIZE
+#define ORG_SIMPLE_CACHE_LINE_SIZE 64
+#endif
+
 namespace org::simple {
 struct Align {
+  static constexpr size_t cacheLine = ORG_SIMPLE_CACHE_LINE_SIZE;
+  static_assert(std::has_single_bit(cacheLine));
+
   static constexpr size_t max =
       std::bit_floor(std::numeric_limits<unsigned short>::max()) >> 1;
 
@@ -21,6 +21,9 @@
  * limitations under the License.
  */
 
+#include <limits>
+#include <memory>
+#include <new>
 #include <org-simple/Align.h>
 
 namespace org::simple {
@@ -70,11 +73,8 @@ public:
   [[nodiscard]] inline constexpr Type *allocate(size_t elements) {
     static_assert(sizeof(Type) != 0, "cannot allocate incomplete types");
 
-    if (elements > Align::maxElements<Type>()) {
-      if (elements > std::numeric_limits<size_t>::max() / sizeof(Type)) {
-        throw std::bad_array_new_length();
-      }
-      throw std::bad_alloc();
+    if (elements > std::numeric_limits<size_t>::max() / sizeof(Type)) {
+      throw std::bad_array_new_length();
     }
     const size_t bytes = elements * sizeof(Type);
     if (alignment > Align::maxNatural) {
@@ -27,7 +27,10 @@
 #include <array>
 #include <iterator>
 #include <memory>
+#include <ranges>
 #include <span>
+#include <stdexcept>
+#include <type_traits>
 #include <vector>
 
 namespace org::simple {
@@ -80,6 +83,14 @@ template <class Container> class AlignedContainerInfo {
       static constexpr size_t subst(const AlignedAllocator<T, AL> *) {
         return AL;
       }
+      // Other allocators, like ArenaAllocator and HugePageAllocator, expose
+      // their alignment as a member.
+      template <class A>
+      static constexpr size_t subst(const A *)
+        requires std::is_same_v<decltype(A::alignment), const size_t>
+      {
+        return A::alignment;
+      }
 
       static constexpr size_t subst(...) { return 0; }
       typedef typename Z::allocator_type AllocatorType;
@@ -166,18 +177,28 @@ public:
   typedef typename GetInfo<Container>::valueType valueType;
 };
 
-template <typename Type, size_t ALIGNMENT>
-class AlignedVector
-    : public std::vector<Type, AlignedAllocator<Type, ALIGNMENT>> {
+/**
+ * A vector whose data is aligned to \c ALIGNMENT.
+ * @tparam Allocator The allocator, that must guarantee at least \c ALIGNMENT,
+ * like AlignedAllocator or ArenaAllocator.
+ */
+template <typename Type, size_t ALIGNMENT,
+          class Allocator = AlignedAllocator<Type, ALIGNMENT>>
+class AlignedVector : public std::vector<Type, Allocator> {
+  static_assert(Allocator::alignment >= ALIGNMENT);
 
 public:
-  typedef std::vector<Type, AlignedAllocator<Type, ALIGNMENT>> Base;
+  typedef std::vector<Type, Allocator> Base;
   typedef AlignedType<Type, ALIGNMENT> Alignment;
 
   AlignedVector() = default;
 
-  AlignedVector(Base::size_type length, const Base::value_type &value)
-      : Base(length, value) {}
+  explicit AlignedVector(const Allocator &allocator) noexcept
+      : Base(allocator) {}
+
+  AlignedVector(Base::size_type length, const Base::value_type &value,
+                const Allocator &allocator = Allocator())
+      : Base(length, value, allocator) {}
 
   template <class Alloc>
   AlignedVector(const std::vector<typename Base::value_type, Alloc> &source)
@@ -250,14 +271,32 @@ public:
   // All the rest is inherited
 };
 
-template <typename T, size_t Size, size_t ALIGNMENT>
+/**
+ * An array whose data is aligned to \c ALIGNMENT.
+ * @tparam Allocator The allocator for arrays that are created with new, that
+ * must guarantee at least \c ALIGNMENT, like AlignedAllocator or
+ * HugePageAllocator.
+ */
+template <typename T, size_t Size, size_t ALIGNMENT,
+          class Allocator = AlignedAllocator<T, ALIGNMENT>>
 class alignas(ALIGNMENT) AlignedArray : public std::array<T, Size> {
   static_assert(Align::isValid<T>(ALIGNMENT));
+  static_assert(Allocator::alignment >= ALIGNMENT);
+  using ByteAllocator = typename std::allocator_traits<
+      Allocator>::template rebind_alloc<unsigned char>;
 
 public:
   typedef std::array<T, Size> Base;
   typedef AlignedType<T, ALIGNMENT> Alignment;
 
+  static void *operator new(size_t bytes) {
+    return ByteAllocator().allocate(bytes);
+  }
+
+  static void operator delete(void *memory, size_t bytes) {
+    ByteAllocator().deallocate(static_cast<unsigned char *>(memory), bytes);
+  }
+
   template <typename... Args>
   AlignedArray(Args... args) : std::array<T, Size>(args...) {}
 
@@ -385,359 +424,294 @@ private:
   std::unique_ptr<Base> base_;
 };
 
-// template <class T, size_t ELEMENTS, size_t ALIGNMENT, class Storage>
-// struct AlignedAccess {
-//   static constexpr size_t elements = ELEMENTS;
-//   typedef T Type;
-//   static constexpr size_t alignment = ALIGNMENT;
-//
-//   T *data() noexcept {
-//     return std::assume_aligned<ALIGNMENT>(
-//         static_cast<Storage *>(this)->getInternalStorage().data());
-//   }
-//
-//   const T *data() const noexcept {
-//     return std::assume_aligned<ALIGNMENT>(
-//         static_cast<const Storage *>(this)->getInternalStorage().data());
-//   }
-//
-//   T *begin() noexcept { return data(); }
-//   const T *begin() const noexcept { return data(); }
-//   T *end() noexcept { return data() + ELEMENTS; }
-//   const T *end() const noexcept { return data() + ELEMENTS; }
-//   T &operator[](size_t i) { return data()[i]; }
-//   const T &operator[](size_t i) const { return data()[i]; }
-//   T &at(size_t i) { return data()[Index::checked(i, ELEMENTS)]; }
-//   const T &at(size_t i) const { return data()[Index::checked(i, ELEMENTS)]; }
-//
-//   [[nodiscard]] constexpr size_t capacity() const {
-//     if constexpr (elements > 0) {
-//       return elements;
-//     } else {
-//       static_cast<const Storage *>(this)->getInternalCapacity();
-//     }
-//   }
-//   [[nodiscard]] constexpr size_t size() const { return capacity(); }
-//
-//   [[nodiscard]] constexpr size_t getAlignment() const { return alignment; }
-//
-//   template <class FROM, class TO>
-//     requires(std::is_base_of_v<AlignedAccess, FROM> &&
-//              std::is_base_of_v<AlignedAccess, TO>)
-//   static constexpr inline void alignedStorageTypeCopy(const FROM &from,
-//                                                       TO &to) noexcept {
-//     std::copy(std::assume_aligned<ALIGNMENT>(from.getInternalStorage().begin()),
-//               std::assume_aligned<ALIGNMENT>(from.getInternalStorage().end()),
-//               std::assume_aligned<ALIGNMENT>(to.getInternalStorage().begin()));
-//   }
-//
-//   template <class FROM, class TO>
-//     requires(std::is_base_of_v<AlignedAccess, FROM> &&
-//              std::is_base_of_v<AlignedAccess, TO>)
-//   static constexpr inline void alignedStorageTypeMove(const FROM &from,
-//                                                       TO &to) noexcept {
-//     std::move(std::assume_aligned<ALIGNMENT>(from.getInternalStorage().begin()),
-//               std::assume_aligned<ALIGNMENT>(from.getInternalStorage().end()),
-//               std::assume_aligned<ALIGNMENT>(to.getInternalStorage().begin()));
-//   }
-// };
-//
-// enum class AlignedDataType { NONE, ARRAY, ALLOCATED_ARRAY, REFERENCE };
-//
-// template <class T, size_t ELEMENTS, size_t ALIGNMENT, AlignedDataType TYPE,
-//           bool isConst>
-// struct AlignedData;
-//
-// struct AlignedDataInfo {
-//   bool isAlignedData = false;
-//   size_t alignment = 0;
-//   size_t elements = 0;
-//   AlignedDataType type = AlignedDataType::NONE;
-//   bool isConst = false;
-//
-//   template <class C> static constexpr AlignedDataInfo get() {
-//     return check(static_cast<const C *>(nullptr));
-//   }
-//
-//   template <class C> static constexpr bool is() {
-//     return get<C>().isAlignedData;
-//   }
-//
-// private:
-//   static constexpr AlignedDataInfo check(...) { return {}; }
-//
-//   template <class T, size_t ELEMENTS, size_t ALIGNMENT, AlignedDataType TYPE,
-//             bool isConst>
-//   static constexpr AlignedDataInfo
-//   check(const AlignedData<T, ELEMENTS, ALIGNMENT, TYPE, isConst> *const) {
-//     return {true, ALIGNMENT, ELEMENTS, TYPE, isConst};
-//   }
-// };
-//
-// template <class T, size_t ELEMENTS, size_t ALIGNMENT>
-// struct AlignedData<T, ELEMENTS, ALIGNMENT, AlignedDataType::ARRAY, false>
-//     : public AlignedAccess<
-//           T, ELEMENTS, ALIGNMENT,
-//           AlignedData<T, ELEMENTS, ALIGNMENT, AlignedDataType::ARRAY, false>>
-//           {
-//   static constexpr size_t elements =
-//       std::max(ELEMENTS, static_cast<size_t>(1u));
-//   typedef T Type;
-//   typedef AlignedAccess<
-//       T, elements, ALIGNMENT,
-//       AlignedData<T, elements, ALIGNMENT, AlignedDataType::ARRAY, false>>
-//       Access;
-//   typedef std::array<Type, elements> DataType;
-//   using Access::alignment;
-//
-//   DataType &getInternalStorage() noexcept { return data_; }
-//   const DataType &getInternalStorage() const noexcept { return data_; }
-//
-//   AlignedData() = default;
-//
-//   template <AlignedDataType type, bool isConst>
-//   explicit AlignedData(const AlignedData<T, elements, alignment, type,
-//   isConst>
-//                            &source) noexcept {
-//     Access::alignedStorageTypeCopy(source, *this);
-//   }
-//
-//   AlignedData(AlignedData &&original) noexcept {
-//     Access::alignedStorageTypeCopy(original, *this);
-//   }
-//
-//   template <class Source> explicit AlignedData(const Source &source) {
-//     if (source.size() != elements) {
-//       throw std::invalid_argument(
-//           "AlignedStorage: Source size does not match my size");
-//     }
-//     std::copy(source.begin(), source.end(), getInternalStorage().begin());
-//   }
-//
-// private:
-//   alignas(AlignedType<T, alignment>::alignment) DataType data_;
-// };
-//
-// template <class T, size_t ELEMENTS, size_t ALIGNMENT>
-// struct AlignedData<T, ELEMENTS, ALIGNMENT, AlignedDataType::ALLOCATED_ARRAY,
-//                    false>
-//     : public AlignedAccess<
-//           T, ELEMENTS, ALIGNMENT,
-//           AlignedData<T, ELEMENTS, ALIGNMENT,
-//           AlignedDataType::ALLOCATED_ARRAY,
-//                       false>> {
-//   static constexpr size_t elements = ELEMENTS;
-//   typedef T Type;
-//   typedef AlignedAccess<T, elements, ALIGNMENT,
-//                         AlignedData<T, elements, ALIGNMENT,
-//                                     AlignedDataType::ALLOCATED_ARRAY, false>>
-//       Access;
-//   using Access::alignment;
-//   typedef typename AlignedData<T, ELEMENTS, ALIGNMENT,
-//   AlignedDataType::ARRAY,
-//                                false>::DataType DataType;
-//
-//   DataType &getInternalStorage() noexcept { return *data_.get(); }
-//   const DataType &getInternalStorage() const noexcept { return *data_.get();
-//   }
-//
-//   AlignedData() = default;
-//
-//   template <AlignedDataType type, bool isConst>
-//   explicit AlignedData(
-//       const AlignedData<T, elements, alignment, type, isConst> &source) {
-//     Access::alignedStorageTypeCopy(source, *this);
-//   }
-//
-//   AlignedData(AlignedData &&original) noexcept : data_(original.data_) {}
-//
-//   template <class Source> explicit AlignedData(const Source &source) {
-//     if (source.size() != elements) {
-//       throw std::invalid_argument(
-//           "AlignedStorage: Source size does not match my size");
-//     }
-//     std::copy(source.begin(), source.end(), getInternalStorage().begin());
-//   }
-//
-// private:
-//   typedef AlignedData<T, elements, alignment, AlignedDataType::ARRAY, false>
-//       InternalDataType;
-//   std::unique_ptr<InternalDataType> data_ =
-//       std::unique_ptr<InternalDataType>(new InternalDataType);
-// };
-//
-// template <class T, size_t ELEMENTS, bool isConst> struct
-// AlignedReferenceData; template <class T, size_t ELEMENTS> struct
-// AlignedReferenceData<T, ELEMENTS, false> {
-//   typedef std::span<T, ELEMENTS> DataType;
-//
-//   DataType data_;
-//
-//   explicit AlignedReferenceData(T *externalData)
-//       : data_(create(externalData)) {}
-//
-//   void assign(T *externalData) { data_ = create(externalData); }
-//
-//   static DataType create(T *p) {
-//     struct Iterator {
-//       T *begin() { return p; }
-//       T *end() { return p + ELEMENTS; }
-//       T *p;
-//     };
-//     Iterator i = {p};
-//     DataType d{i};
-//     return d;
-//   }
-// };
-//
-// template <class T, size_t ELEMENTS>
-// struct AlignedReferenceData<T, ELEMENTS, true> {
-//   typedef std::span<const T, ELEMENTS> DataType;
-//
-//   DataType data_;
-//
-//   explicit AlignedReferenceData(const T *externalData)
-//       : data_(create(externalData)) {}
-//
-//   void assign(const T *externalData) { data_ = create(externalData); }
-//
-//   static DataType create(T *p) {
-//     struct Iterator {
-//       T *begin() { return p; }
-//       T *end() { return p + ELEMENTS; }
-//       T *p;
-//     };
-//     Iterator i = {p};
-//     DataType d{i};
-//     return d;
-//   }
-// };
-//
-// template <class T, size_t ELEMENTS, size_t ALIGNMENT, bool isConst>
-// struct AlignedData<T, ELEMENTS, ALIGNMENT, AlignedDataType::REFERENCE,
-// isConst>
-//     : public AlignedAccess<T, ELEMENTS, ALIGNMENT,
-//                            AlignedData<T, ELEMENTS, ALIGNMENT,
-//                                        AlignedDataType::REFERENCE, isConst>>,
-//       private AlignedReferenceData<T, ELEMENTS, isConst> {
-//
-//   static constexpr size_t elements = ELEMENTS;
-//   typedef T Type;
-//   typedef AlignedAccess<
-//       T, ELEMENTS, ALIGNMENT,
-//       AlignedData<T, ELEMENTS, ALIGNMENT, AlignedDataType::REFERENCE,
-//       isConst>> Access;
-//   typedef
-//       typename AlignedReferenceData<T, ELEMENTS, isConst>::DataType DataType;
-//   template <size_t ownerElements, AlignedDataType type, bool constOwner>
-//   using OwnerStorage =
-//       AlignedAccess<T, ownerElements, ALIGNMENT,
-//                     AlignedData<T, ownerElements, ALIGNMENT, type,
-//                     constOwner>>;
-//
-//   DataType &getInternalStorage() noexcept {
-//     return AlignedReferenceData<T, ELEMENTS, isConst>::data_;
-//   }
-//   const DataType &getInternalStorage() const noexcept {
-//     return AlignedReferenceData<T, ELEMENTS, isConst>::data_;
-//   }
-//
-//   template <class O> static constexpr bool isAssignableOwner() {
-//     const AlignedDataInfo info = AlignedDataInfo::get<O>();
-//     if (!info.isAlignedData) {
-//       return false;
-//     }
-//     const bool sameAligned = info.alignment == ALIGNMENT;
-//     const bool validElements = info.elements >= ELEMENTS;
-//     return sameAligned && validElements && (!info.isConst || isConst);
-//   }
-//
-//   template <class O>
-//   static constexpr bool isValidElementIndex(const size_t elementIndex) {
-//     const auto ownerElements = AlignedDataInfo::get<O>().elements;
-//     return ownerElements >= ELEMENTS &&
-//            ownerElements - ELEMENTS >= elementIndex &&
-//            AlignedType<T, ALIGNMENT>::alignedElements() % elementIndex == 0;
-//   }
-//
-//   template <typename P> static constexpr bool isConstPointer() {
-//     return std::is_same_v<const T *, P>;
-//   }
-//
-//   template <typename P> static constexpr bool isNonConstPointer() {
-//     return std::is_same_v<T *, P>;
-//   }
-//
-//   template <typename P> static constexpr bool isPointerAssignable() {
-//     return isNonConstPointer<P>() ? true : isConstPointer<P>() && isConst;
-//   }
-//
-//   template <typename P>
-//     requires(isPointerAssignable<P>())
-//   explicit AlignedData(P pointer)
-//       : AlignedReferenceData<T, ELEMENTS, isConstPointer<P>()>(
-//             {checkAligned(pointer)}) {}
-//
-//   template <typename P>
-//     requires(isPointerAssignable<P>() && !isConst)
-//   void set(P pointer) {
-//     AlignedReferenceData<T, ELEMENTS,
-//     isConst>::assign(checkAligned(pointer));
-//   }
-//
-//   template <class O>
-//     requires(isAssignableOwner<O>())
-//   AlignedData(O &owner, size_t elementIndex)
-//       : AlignedReferenceData<T, ELEMENTS, isConst>(
-//             owner.data() + checkValidElementIndex<O>(elementIndex)) {}
-//
-//   template <class O>
-//     requires(isAssignableOwner<O>() && !isConst)
-//   void set(O &owner, size_t elementIndex) {
-//     AlignedReferenceData<T, ELEMENTS, isConst>::data_ =
-//         owner.data() + isValidElementIndex<O>(elementIndex);
-//   }
-//
-// private:
-//   template <class O>
-//     requires(AlignedDataInfo::get<O>().isAlignedData)
-//   static constexpr bool isValidOwnerElements() {
-//     return AlignedDataInfo::get<O>().elements >= ELEMENTS;
-//   }
-//
-//   template <typename P> static constexpr P checkAligned(P pointer) {
-//     if (AlignedType<T, ALIGNMENT>::isAlignedPointer(pointer)) {
-//       return pointer;
-//     }
-//     throw std::invalid_argument("AlignedStorage: pointer is not aligned");
-//   }
-//
-//   template <class O>
-//   static constexpr size_t checkValidElementIndex(size_t elementIndex) {
-//     if (isValidElementIndex<O>(elementIndex)) {
-//       return elementIndex;
-//     }
-//     throw std::invalid_argument(
-//         "AlignedStorage: elementIndex not on aligned boundary");
-//   }
-// };
-//
-// template <typename T, size_t ELEMENTS, size_t ALIGNMENT = alignof(T)>
-// using AlignedAllocatedStorage =
-//     AlignedData<T, ELEMENTS, ALIGNMENT, AlignedDataType::ALLOCATED_ARRAY,
-//                 false>;
-//
-// template <typename T, size_t ELEMENTS, size_t ALIGNMENT = alignof(T)>
-// using AlignedLocalStorage =
-//     AlignedData<T, ELEMENTS, ALIGNMENT, AlignedDataType::ARRAY, false>;
-//
-// template <typename T, size_t ELEMENTS, size_t ALIGNMENT = alignof(T)>
-// using AlignedReferencedStorage =
-//     AlignedData<T, ELEMENTS, ALIGNMENT, AlignedDataType::REFERENCE, false>;
-//
-// template <typename T, size_t ELEMENTS, size_t ALIGNMENT = alignof(T)>
-// using AlignedConstReferencedStorage =
-//     AlignedData<T, ELEMENTS, ALIGNMENT, AlignedDataType::REFERENCE, true>;
+enum class AlignedDataType { NONE, ARRAY, ALLOCATED_ARRAY, REFERENCE };
+
+/**
+ * A fixed number of \c ELEMENTS elements of type \c T, aligned to \c
+ * ALIGNMENT, that are stored locally (ARRAY), on the heap (ALLOCATED_ARRAY) or
+ * elsewhere (REFERENCE). All variants offer the same element access through
+ * AlignedDataAccess, so that algorithms like those of NumArray can work on any
+ * of them.
+ */
+template <class T, size_t ELEMENTS, size_t ALIGNMENT, AlignedDataType TYPE,
+          bool isConst>
+class AlignedData;
+
+/**
+ * Describes whether a type is, or derives from, an AlignedData and if so,
+ * with what properties.
+ */
+struct AlignedDataInfo {
+  bool isAlignedData = false;
+  size_t alignment = 0;
+  size_t elements = 0;
+  AlignedDataType type = AlignedDataType::NONE;
+  bool isConst = false;
+
+  template <class C> static constexpr AlignedDataInfo get() {
+    return check(static_cast<const std::remove_cvref_t<C> *>(nullptr));
+  }
+
+  template <class C> static constexpr bool is() {
+    return get<C>().isAlignedData;
+  }
+
+private:
+  static constexpr AlignedDataInfo check(...) { return {}; }
+
+  template <class T, size_t ELEMENTS, size_t ALIGNMENT, AlignedDataType TYPE,
+            bool isConst>
+  static constexpr AlignedDataInfo
+  check(const AlignedData<T, ELEMENTS, ALIGNMENT, TYPE, isConst> *const) {
+    return {true, ALIGNMENT, ELEMENTS, TYPE, isConst};
+  }
+};
+
+/**
+ * The element access that all AlignedData variants share. The \c Storage
+ * must have a member raw() that returns the pointer to the elements.
+ * @tparam V The type of elements, that is const for read-only references.
+ */
+template <class V, size_t ELEMENTS, size_t ALIGNMENT, class Storage>
+class AlignedDataAccess {
+  static_assert(ELEMENTS > 0);
+  static_assert(Align::isValid<V>(ALIGNMENT));
+
+public:
+  typedef std::remove_const_t<V> Type;
+  typedef Type type;
+  static constexpr size_t elements = ELEMENTS;
+  static constexpr size_t alignment = ALIGNMENT;
+
+  V *data() noexcept {
+    return std::assume_aligned<ALIGNMENT>(static_cast<Storage *>(this)->raw());
+  }
+  const Type *data() const noexcept {
+    return std::assume_aligned<ALIGNMENT>(
+        static_cast<const Storage *>(this)->raw());
+  }
+
+  V *begin() noexcept { return data(); }
+  const Type *begin() const noexcept { return data(); }
+  V *end() noexcept { return data() + ELEMENTS; }
+  const Type *end() const noexcept { return data() + ELEMENTS; }
+  V &operator[](size_t i) noexcept { return data()[i]; }
+  const Type &operator[](size_t i) const noexcept { return data()[i]; }
+  V &at(size_t i) { return data()[Index::checked(i, ELEMENTS)]; }
+  const Type &at(size_t i) const { return data()[Index::checked(i, ELEMENTS)]; }
+
+  static constexpr size_t size() noexcept { return ELEMENTS; }
+  static constexpr size_t capacity() noexcept { return ELEMENTS; }
+
+  /**
+   * Copies the elements of \c source, like another AlignedData or a standard
+   * container, that must have the same number of elements.
+   * @throws std::invalid_argument if the number of elements differs.
+   */
+  template <class Source> void assign(const Source &source) {
+    if (std::size(source) != ELEMENTS) {
+      throw std::invalid_argument(
+          "org::simple::AlignedData: source size does not match my size");
+    }
+    if (static_cast<const void *>(&*std::begin(source)) != data()) {
+      std::copy(std::begin(source), std::end(source), begin());
+    }
+  }
+};
+
+template <class T, size_t ELEMENTS, size_t ALIGNMENT>
+class AlignedData<T, ELEMENTS, ALIGNMENT, AlignedDataType::ARRAY, false>
+    : public AlignedDataAccess<
+          T, ELEMENTS, ALIGNMENT,
+          AlignedData<T, ELEMENTS, ALIGNMENT, AlignedDataType::ARRAY, false>> {
+  typedef AlignedDataAccess<T, ELEMENTS, ALIGNMENT, AlignedData> Access;
+  friend Access;
+
+  alignas(ALIGNMENT) std::array<T, ELEMENTS> data_;
+
+  T *raw() noexcept { return data_.data(); }
+  const T *raw() const noexcept { return data_.data(); }
+
+public:
+  AlignedData() = default;
+  AlignedData(const AlignedData &) = default;
+  AlignedData &operator=(const AlignedData &) = default;
+
+  /**
+   * Creates a copy of the elements of \c source.
+   * @throws std::invalid_argument if the number of elements differs.
+   */
+  template <class Source>
+    requires(!std::is_same_v<Source, AlignedData> &&
+             std::ranges::sized_range<const Source>)
+  explicit AlignedData(const Source &source) {
+    Access::assign(source);
+  }
+};
+
+template <class T, size_t ELEMENTS, size_t ALIGNMENT>
+class AlignedData<T, ELEMENTS, ALIGNMENT, AlignedDataType::ALLOCATED_ARRAY,
+                  false>
+    : public AlignedDataAccess<T, ELEMENTS, ALIGNMENT,
+                               AlignedData<T, ELEMENTS, ALIGNMENT,
+                                           AlignedDataType::ALLOCATED_ARRAY,
+                                           false>> {
+  typedef AlignedDataAccess<T, ELEMENTS, ALIGNMENT, AlignedData> Access;
+  friend Access;
+  typedef AlignedData<T, ELEMENTS, ALIGNMENT, AlignedDataType::ARRAY, false>
+      Local;
+
+  std::unique_ptr<Local> data_;
+
+  T *raw() noexcept { return data_->data(); }
+  const T *raw() const noexcept { return data_->data(); }
+
+public:
+  AlignedData() : data_(new Local) {}
+  AlignedData(const AlignedData &source) : AlignedData() {
+    Access::assign(source);
+  }
+  /**
+   * Takes over the elements of \c original, that has no elements afterwards,
+   * until something is assigned to it.
+   */
+  AlignedData(AlignedData &&original) noexcept = default;
+
+  AlignedData &operator=(const AlignedData &source) {
+    if (!data_) {
+      data_.reset(new Local);
+    }
+    Access::assign(source);
+    return *this;
+  }
+  AlignedData &operator=(AlignedData &&original) noexcept = default;
+
+  /**
+   * Creates a copy of the elements of \c source.
+   * @throws std::invalid_argument if the number of elements differs.
+   */
+  template <class Source>
+    requires(!std::is_same_v<Source, AlignedData> &&
+             std::ranges::sized_range<const Source>)
+  explicit AlignedData(const Source &source) : AlignedData() {
+    Access::assign(source);
+  }
+};
+
+/**
+ * Refers to \c ELEMENTS aligned elements that are owned by something else,
+ * like the buffer of an audio period or another AlignedData, so that they can
+ * be processed in place.
+ *
+ * Copies refer to the same elements, but assignment copies the elements of
+ * the source into the referred elements, like it does for the other variants.
+ * Use set() to refer to other elements.
+ */
+template <class T, size_t ELEMENTS, size_t ALIGNMENT, bool isConst>
+class AlignedData<T, ELEMENTS, ALIGNMENT, AlignedDataType::REFERENCE, isConst>
+    : public AlignedDataAccess<std::conditional_t<isConst, const T, T>,
+                               ELEMENTS, ALIGNMENT,
+                               AlignedData<T, ELEMENTS, ALIGNMENT,
+                                           AlignedDataType::REFERENCE,
+                                           isConst>> {
+  typedef std::conditional_t<isConst, const T, T> V;
+  typedef AlignedDataAccess<V, ELEMENTS, ALIGNMENT, AlignedData> Access;
+  friend Access;
+
+  V *data_;
+
+  V *raw() const noexcept { return data_; }
+
+  static V *checked(V *pointer) {
+    if (pointer && Align::isAlignedPointer(pointer, ALIGNMENT)) {
+      return pointer;
+    }
+    throw std::invalid_argument(
+        "org::simple::AlignedData: pointer is null or not aligned");
+  }
+
+  template <class O> static size_t checked_offset(size_t offset) {
+    if (offset <= O::elements - ELEMENTS &&
+        (offset * sizeof(T)) % ALIGNMENT == 0) {
+      return offset;
+    }
+    throw std::invalid_argument(
+        "org::simple::AlignedData: offset out of range or not aligned");
+  }
+
+public:
+  /**
+   * Returns whether this can refer to the elements of an \c O, which must be
+   * an AlignedData with at least as many elements of the same type and at
+   * least the same alignment, that can be written if this is not const.
+   */
+  template <class O> static constexpr bool isOwner() {
+    constexpr AlignedDataInfo info = AlignedDataInfo::get<O>();
+    if constexpr (info.isAlignedData) {
+      return std::is_same_v<typename O::type, T> && info.elements >= ELEMENTS &&
+             info.alignment >= ALIGNMENT &&
+             (isConst || (!info.isConst && !std::is_const_v<O>));
+    }
+    return false;
+  }
+
+  /**
+   * Refers to the elements at \c pointer.
+   * @throws std::invalid_argument if the pointer is null or not aligned.
+   */
+  explicit AlignedData(V *pointer) : data_(checked(pointer)) {}
+
+  /**
+   * Refers to the elements of \c owner, starting at element \c offset.
+   * @throws std::invalid_argument if the offset is not aligned or if there
+   * are not enough elements after it.
+   */
+  template <class O>
+    requires(isOwner<O>())
+  explicit AlignedData(O &owner, size_t offset = 0)
+      : data_(owner.data() + checked_offset<O>(offset)) {}
+
+  AlignedData(const AlignedData &) = default;
+
+  AlignedData &operator=(const AlignedData &source) {
+    Access::assign(source);
+    return *this;
+  }
+
+  /**
+   * Refers to the elements at \c pointer.
+   * @throws std::invalid_argument if the pointer is null or not aligned.
+   */
+  void set(V *pointer) { data_ = checked(pointer); }
+
+  /**
+   * Refers to the elements of \c owner, starting at element \c offset.
+   * @throws std::invalid_argument if the offset is not aligned or if there
+   * are not enough elements after it.
+   */
+  template <class O>
+    requires(isOwner<O>())
+  void set(O &owner, size_t offset = 0) {
+    data_ = owner.data() + checked_offset<O>(offset);
+  }
+};
+
+template <typename T, size_t ELEMENTS, size_t ALIGNMENT = alignof(T)>
+using AlignedAllocatedStorage =
+    AlignedData<T, ELEMENTS, ALIGNMENT, AlignedDataType::ALLOCATED_ARRAY,
+                false>;
+
+template <typename T, size_t ELEMENTS, size_t ALIGNMENT = alignof(T)>
+using AlignedLocalStorage =
+    AlignedData<T, ELEMENTS, ALIGNMENT, AlignedDataType::ARRAY, false>;
+
+template <typename T, size_t ELEMENTS, size_t ALIGNMENT = alignof(T)>
+using AlignedReferencedStorage =
+    AlignedData<T, ELEMENTS, ALIGNMENT, AlignedDataType::REFERENCE, false>;
+
+template <typename T, size_t ELEMENTS, size_t ALIGNMENT = alignof(T)>
+using AlignedConstReferencedStorage =
+    AlignedData<T, ELEMENTS, ALIGNMENT, AlignedDataType::REFERENCE, true>;
 
 } // namespace org::simple
 
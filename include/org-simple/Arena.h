@@ -0,0 +1,233 @@
+#ifndef ORG_SIMPLE_M_ARENA_H
+#define ORG_SIMPLE_M_ARENA_H
+/*
+ * org-simple/Arena.h
+ *
+ * Added by michel on 2026-10-15
+ * Copyright (C) 2015-2026 Michel Fleur.
+ * Source https://github.com/emmef/org-simple
+ * Email org-simple@emmef.org
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstdint>
+#include <limits>
+#include <new>
+#include <org-simple/Align.h>
+#include <type_traits>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace org::simple {
+
+/**
+ * A monotonic arena: a single block of memory that hands out aligned pieces
+ * by bumping an offset and that releases them all at once, when it is reset
+ * or destroyed.
+ *
+ * This lets the buffers of a complete processing graph be laid out
+ * contiguously at setup time, instead of scattered over the heap. The block
+ * can be prefaulted or locked in memory, so that the real-time thread does
+ * not take page faults when it first touches a buffer.
+ *
+ * Allocation is not thread-safe and is meant to be done before processing
+ * starts. As memory is never reused until reset(), containers should reserve
+ * their final size instead of growing.
+ */
+class Arena {
+  static constexpr size_t BLOCK_ALIGNMENT = Align::cacheLine;
+
+  char *data_;
+  size_t capacity_;
+  size_t used_ = 0;
+  bool locked_ = false;
+
+  static size_t page_size() noexcept {
+#if defined(__linux__)
+    long size = sysconf(_SC_PAGESIZE);
+    if (size > 0) {
+      return static_cast<size_t>(size);
+    }
+#endif
+    return 4096;
+  }
+
+public:
+  /**
+   * Creates an arena of \c capacity bytes.
+   * @throws std::bad_alloc if the block cannot be allocated.
+   */
+  explicit Arena(size_t capacity)
+      : data_(static_cast<char *>(
+            ::operator new(capacity, std::align_val_t(BLOCK_ALIGNMENT)))),
+        capacity_(capacity) {}
+
+  Arena(const Arena &) = delete;
+  Arena(Arena &&) = delete;
+  Arena &operator=(const Arena &) = delete;
+  Arena &operator=(Arena &&) = delete;
+
+  ~Arena() {
+    unlock();
+    ::operator delete(data_, std::align_val_t(BLOCK_ALIGNMENT));
+  }
+
+  size_t capacity() const noexcept { return capacity_; }
+  size_t used() const noexcept { return used_; }
+  size_t available() const noexcept { return capacity_ - used_; }
+  bool locked() const noexcept { return locked_; }
+
+  /**
+   * Returns whether \c pointer lies within the block of this arena.
+   */
+  bool contains(const void *pointer) const noexcept {
+    auto p = reinterpret_cast<uintptr_t>(pointer);
+    auto start = reinterpret_cast<uintptr_t>(data_);
+    return p >= start && p < start + capacity_;
+  }
+
+  /**
+   * Returns \c bytes bytes of memory, aligned to \c alignment, that must be a
+   * power of two.
+   * @throws std::bad_alloc if the arena has not enough space left.
+   */
+  [[nodiscard]] void *allocate(size_t bytes, size_t alignment) {
+    auto start = reinterpret_cast<uintptr_t>(data_);
+    uintptr_t aligned = (start + used_ + alignment - 1) & ~(alignment - 1);
+    size_t offset = aligned - start;
+    if (offset > capacity_ || bytes > capacity_ - offset) {
+      throw std::bad_alloc();
+    }
+    used_ = offset + bytes;
+    return data_ + offset;
+  }
+
+  /**
+   * Makes all memory available again. Objects that still live in the arena
+   * must not be used afterwards.
+   */
+  void reset() noexcept { used_ = 0; }
+
+  /**
+   * Touches every page of the block, so that it is mapped before it is used.
+   * The contents of the block, like buffers that are already filled, are
+   * preserved: each page is read and the same value is written back.
+   */
+  void prefault() noexcept {
+    if (capacity_ == 0) {
+      return;
+    }
+    const size_t page = page_size();
+    volatile char *bytes = data_;
+    for (size_t offset = 0; offset < capacity_; offset += page) {
+      bytes[offset] = bytes[offset];
+    }
+    // The block need not start on a page boundary
+    bytes[capacity_ - 1] = bytes[capacity_ - 1];
+  }
+
+  /**
+   * Locks the block in memory, which also prefaults it, so that it cannot be
+   * paged out. This can fail because of the limit on locked memory, in which
+   * case the block is still prefaulted.
+   * @returns \c true if the block is locked.
+   */
+  bool lock() noexcept {
+#if defined(__linux__)
+    if (!locked_) {
+      locked_ = mlock(data_, capacity_) == 0;
+    }
+#endif
+    if (!locked_) {
+      prefault();
+    }
+    return locked_;
+  }
+
+  /**
+   * Unlocks the block, if it was locked.
+   */
+  void unlock() noexcept {
+#if defined(__linux__)
+    if (locked_) {
+      munlock(data_, capacity_);
+    }
+#endif
+    locked_ = false;
+  }
+};
+
+/**
+ * An allocator that takes memory from an Arena, with the same alignment
+ * guarantees as AlignedAllocator, so that it can be used for an AlignedVector.
+ * Deallocation does nothing: the memory is released with the arena.
+ *
+ * Allocators compare equal if they use the same arena. The arena must outlive
+ * all containers that use it.
+ */
+template <typename Type, size_t ALIGNMENT> class ArenaAllocator {
+  static_assert(Align::isValid<Type>(ALIGNMENT));
+
+  Arena *arena_;
+
+public:
+  typedef Type value_type;
+  typedef std::size_t size_type;
+  typedef std::ptrdiff_t difference_type;
+  static constexpr size_type alignment = Align::fixed<Type>(ALIGNMENT);
+
+  typedef std::true_type propagate_on_container_copy_assignment;
+  typedef std::true_type propagate_on_container_move_assignment;
+  typedef std::true_type propagate_on_container_swap;
+  typedef std::false_type is_always_equal;
+
+  explicit ArenaAllocator(Arena &arena) noexcept : arena_(&arena) {}
+  ArenaAllocator(const ArenaAllocator &) noexcept = default;
+  template <typename OtherType>
+  ArenaAllocator(const ArenaAllocator<OtherType, ALIGNMENT> &other) noexcept
+      : arena_(&other.arena()) {}
+
+  ArenaAllocator &operator=(const ArenaAllocator &) noexcept = default;
+
+  template <typename OtherType> struct rebind {
+    typedef ArenaAllocator<OtherType, ALIGNMENT> other;
+  };
+
+  Arena &arena() const noexcept { return *arena_; }
+
+  template <typename OtherType, size_t A>
+  friend bool operator==(const ArenaAllocator &a,
+                         const ArenaAllocator<OtherType, A> &b) noexcept {
+    return &a.arena() == &b.arena();
+  }
+
+  [[nodiscard]] Type *allocate(size_t elements) {
+    static_assert(sizeof(Type) != 0, "cannot allocate incomplete types");
+
+    if (elements > std::numeric_limits<size_t>::max() / sizeof(Type)) {
+      throw std::bad_array_new_length();
+    }
+    return static_cast<Type *>(
+        arena_->allocate(elements * sizeof(Type), alignment));
+  }
+
+  void deallocate(Type *, size_type) noexcept {}
+};
+
+} // namespace org::simple
+
+#endif // ORG_SIMPLE_M_ARENA_H
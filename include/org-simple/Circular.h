@@ -21,32 +21,118 @@
  * limitations under the License.
  */
 
+#include <algorithm>
+#include <bit>
+#include <cstdint>
 #include <limits>
 #include <numeric>
 #include <type_traits>
 
 namespace org::simple {
 
-enum class WrappingType { BIT_MASK, MODULO };
+enum class WrappingType { BIT_MASK, MODULO, FAST_MODULO };
 
+#if defined(__SIZEOF_INT128__)
+static constexpr bool FAST_MODULO_INT128 = true;
+#else
+static constexpr bool FAST_MODULO_INT128 = false;
+#endif
+
+/**
+ * Computes remainders of the division by a fixed divisor with multiplications
+ * instead of a division, that costs 20 to 40 cycles. It precomputes the
+ * multiplicative inverse, as described by Lemire, Kaser and Kurz in "Faster
+ * Remainder by Direct Computation" (2019), that is exact for all values of
+ * size_type.
+ *
+ * Without a 128-bit integer type, 32-bit remainders compute the high half of
+ * a 96-bit product from the 32-bit halves of its 64-bit factor, and 64-bit
+ * remainders fall back to the modulo operator.
+ * @tparam size_type The unsigned type of divisor and values.
+ * @tparam INT128 Whether to use the 128-bit integer type, which can only be
+ * \c true if the compiler has one.
+ */
+template <typename size_type, bool INT128 = FAST_MODULO_INT128>
+struct FastModulo {
+  static_assert(std::is_integral_v<size_type> && std::is_unsigned_v<size_type>);
+  static_assert(FAST_MODULO_INT128 || !INT128);
+#if defined(__SIZEOF_INT128__)
+  __extension__ typedef std::conditional_t<INT128, unsigned __int128, uint64_t>
+      uint128;
+#else
+  typedef uint64_t uint128;
+#endif
+  static constexpr bool ENABLED =
+      INT128 || sizeof(size_type) <= sizeof(uint32_t);
+  typedef std::conditional_t<sizeof(size_type) <= sizeof(uint32_t), uint64_t,
+                             uint128>
+      magic_type;
+
+  size_type divisor;
+  magic_type magic;
+
+  constexpr FastModulo(size_t elements)
+      : divisor(std::max(static_cast<size_type>(elements), size_type(1))),
+        magic(static_cast<magic_type>(-1) / divisor + 1) {}
+
+  [[nodiscard]] constexpr size_type remainder(size_type value) const {
+    if constexpr (!ENABLED) {
+      return value % divisor;
+    } else if constexpr (sizeof(magic_type) == sizeof(uint64_t)) {
+      uint64_t low = magic * value;
+      if constexpr (INT128) {
+        return static_cast<size_type>(
+            (static_cast<uint128>(low) * divisor) >> 64);
+      } else {
+        // The divisor has 32 bits, so this sum cannot overflow
+        return static_cast<size_type>(
+            ((low >> 32) * divisor + (((low & 0xffffffffu) * divisor) >> 32)) >>
+            32);
+      }
+    } else {
+      uint128 low = magic * value;
+      uint128 bottom = (static_cast<uint64_t>(low) * uint128(divisor)) >> 64;
+      uint128 top = (low >> 64) * divisor;
+      return static_cast<size_type>((bottom + top) >> 64);
+    }
+  }
+};
+
+/**
+ * Wraps indices into a circular range of elements, where the \c mask is the
+ * bit mask for BIT_MASK, the number of elements for MODULO and a FastModulo
+ * for FAST_MODULO.
+ *
+ * The unsafe variants of inc(), dec(), add() and sub() require that the index
+ * is already wrapped and that the delta does not exceed the number of
+ * elements. For the modulo types, they then use a conditional subtraction
+ * instead of a division.
+ */
 template <WrappingType wrappingType, typename size_type>
 struct CircularAlgoBase {
   static_assert(std::is_integral_v<size_type> && std::is_unsigned_v<size_type>);
 
-  static constexpr size_type elementsForMask(size_t mask) {
+  typedef std::conditional_t<wrappingType == WrappingType::FAST_MODULO,
+                             FastModulo<size_type>, size_t>
+      mask_type;
+
+  static constexpr size_type elementsForMask(mask_type mask) {
     if constexpr (wrappingType == WrappingType::BIT_MASK) {
       return mask  + 1;
     }
+    else if constexpr (wrappingType == WrappingType::FAST_MODULO) {
+      return mask.divisor;
+    }
     else {
       return mask;
     }
   }
-  static constexpr size_type maskForElements(size_t elements) {
+  static constexpr mask_type maskForElements(size_t elements) {
     if constexpr (wrappingType == WrappingType::BIT_MASK) {
       return allocationForElements(elements) - static_cast<size_type>(1);
     }
     else {
-      return elements;
+      return mask_type(elements);
     }
   }
 
@@ -61,64 +147,98 @@ struct CircularAlgoBase {
   }
 
   [[nodiscard]] static constexpr size_type wrapped(size_type to_wrap,
-                                                   size_t mask) {
+                                                   mask_type mask) {
     if constexpr (wrappingType == WrappingType::BIT_MASK) {
       return to_wrap & mask;
+    } else if constexpr (wrappingType == WrappingType::FAST_MODULO) {
+      return mask.remainder(to_wrap);
     } else {
       return to_wrap % mask;
     }
   }
 
   [[nodiscard]] static constexpr size_type unsafe_inc(size_type index,
-                                                      size_t mask) {
-    return wrapped(index + 1, mask);
+                                                      mask_type mask) {
+    if constexpr (wrappingType == WrappingType::BIT_MASK) {
+      return wrapped(index + 1, mask);
+    } else {
+      size_type next = index + 1;
+      return next == elementsForMask(mask) ? 0 : next;
+    }
   }
 
-  [[nodiscard]] static constexpr size_type inc(size_type index, size_t mask) {
-    return unsafe_inc(index, mask);
+  [[nodiscard]] static constexpr size_type inc(size_type index,
+                                               mask_type mask) {
+    if constexpr (wrappingType == WrappingType::BIT_MASK) {
+      return unsafe_inc(index, mask);
+    } else {
+      return unsafe_inc(wrapped(index, mask), mask);
+    }
   }
 
   [[nodiscard]] static constexpr size_type unsafe_dec(size_type index,
-                                                      size_t mask) {
-    return wrapped(index - 1, mask);
+                                                      mask_type mask) {
+    if constexpr (wrappingType == WrappingType::BIT_MASK) {
+      return wrapped(index - 1, mask);
+    } else {
+      return index == 0 ? elementsForMask(mask) - 1 : index - 1;
+    }
   }
 
-  [[nodiscard]] static constexpr size_type dec(size_type index, size_t mask) {
-    return unsafe_dec(index, mask);
+  [[nodiscard]] static constexpr size_type dec(size_type index,
+                                               mask_type mask) {
+    if constexpr (wrappingType == WrappingType::BIT_MASK) {
+      return unsafe_dec(index, mask);
+    } else {
+      return unsafe_dec(wrapped(index, mask), mask);
+    }
   }
 
   [[nodiscard]] static constexpr size_type
-  unsafe_add(size_type index, size_type delta, size_t mask) {
-    return wrapped(index + delta, mask);
+  unsafe_add(size_type index, size_type delta, mask_type mask) {
+    if constexpr (wrappingType == WrappingType::BIT_MASK) {
+      return wrapped(index + delta, mask);
+    } else {
+      size_type sum = index + delta;
+      return sum >= elementsForMask(mask) ? sum - elementsForMask(mask) : sum;
+    }
   }
 
   [[nodiscard]] static constexpr size_type add(size_type index, size_type delta,
-                                               size_t mask) {
-    return unsafe_add(index, delta, mask);
+                                               mask_type mask) {
+    if constexpr (wrappingType == WrappingType::BIT_MASK) {
+      return unsafe_add(index, delta, mask);
+    } else {
+      return unsafe_add(wrapped(index, mask), wrapped(delta, mask), mask);
+    }
   }
 
   [[nodiscard]] static constexpr size_type
-  unsafe_sub(size_type index, size_type delta, size_t mask) {
-    return wrapped(index - delta, mask);
+  unsafe_sub(size_type index, size_type delta, mask_type mask) {
+    if constexpr (wrappingType == WrappingType::BIT_MASK) {
+      return wrapped(index - delta, mask);
+    } else {
+      return index >= delta ? index - delta
+                            : index + elementsForMask(mask) - delta;
+    }
   }
 
   [[nodiscard]] static constexpr size_type sub(size_type index, size_type delta,
-                                               size_t mask) {
-    return unsafe_sub(index, delta, mask);
+                                               mask_type mask) {
+    if constexpr (wrappingType == WrappingType::BIT_MASK) {
+      return unsafe_sub(index, delta, mask);
+    } else {
+      return unsafe_sub(wrapped(index, mask), wrapped(delta, mask), mask);
+    }
   }
 
   [[nodiscard]] static constexpr size_type
-  unsafe_diff(size_type hi, size_type lo, size_t mask) {
-    if constexpr (wrappingType == WrappingType::BIT_MASK) {
-      return (hi > lo ? hi : hi + mask + 1) - lo;
-    }
-    else {
-      return (hi > lo ? hi : hi + mask) - lo;
-    }
+  unsafe_diff(size_type hi, size_type lo, mask_type mask) {
+    return (hi > lo ? hi : hi + elementsForMask(mask)) - lo;
   }
 
   [[nodiscard]] static constexpr size_type diff(size_type hi, size_type lo,
-                                                size_t mask) {
+                                                mask_type mask) {
     return unsafe_diff(hi, lo, mask);
   }
 
@@ -185,14 +305,15 @@ struct CircularBase {
     }
 
   private:
-    size_type mask_;
+    typename circular::mask_type mask_;
   };
 
   template <WrappingType wrappingType, size_type ELEMENTS> struct FixedMetric {
     typedef CircularAlgoBase<wrappingType, size_type> circular;
     static_assert(circular::elementsForMask(circular::maskForElements(ELEMENTS)) >= ELEMENTS);
 
-    static constexpr size_type MASK = circular::maskForElements(ELEMENTS);
+    static constexpr typename circular::mask_type MASK =
+        circular::maskForElements(ELEMENTS);
 
     static constexpr size_type elements() { return circular::elementsForMask(MASK); }
 
@@ -250,6 +371,8 @@ struct CircularBase {
 
 typedef CircularAlgoBase<WrappingType::BIT_MASK, size_t> CircularMasked;
 typedef CircularAlgoBase<WrappingType::MODULO, size_t> CircularModulo;
+typedef CircularAlgoBase<WrappingType::FAST_MODULO, size_t>
+    CircularFastModulo;
 typedef CircularBase<size_t> Circular;
 
 } // namespace org::simple
@@ -0,0 +1,250 @@
+#ifndef ORG_SIMPLE_M_CIRCULAR_BUFFER_H
+#define ORG_SIMPLE_M_CIRCULAR_BUFFER_H
+/*
+ * org-simple/CircularBuffer.h
+ *
+ * Added by michel on 2026-10-15
+ * Copyright (C) 2015-2026 Michel Fleur.
+ * Source https://github.com/emmef/org-simple
+ * Email org-simple@emmef.org
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <org-simple/AlignedAllocator.h>
+#include <org-simple/Circular.h>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+namespace org::simple {
+
+/**
+ * A delay line that is written and read in blocks.
+ *
+ * The samples are stored in aligned memory with a mirrored tail: the first
+ * samples of the buffer are duplicated past its end. As a result, any window
+ * of at most max_window() samples is contiguous, wherever it starts, so that
+ * it can be processed with SIMD loads and without wrapping each index.
+ *
+ * Delays are expressed relative to the most recently written block: a block
+ * of \c count samples read with a delay of zero yields the last \c count
+ * written samples and a delay of \c d yields the samples written \c d samples
+ * earlier. A read must not reach back further than elements() samples.
+ *
+ * @tparam T The type of samples.
+ * @tparam Metric The metric that wraps the indices, like a
+ * Circular::Metric or Circular::FixedMetric.
+ * @tparam ALIGNMENT The alignment of the sample memory.
+ */
+template <typename T,
+          class Metric = Circular::Metric<WrappingType::FAST_MODULO>,
+          size_t ALIGNMENT = Align::cacheLine>
+class CircularBuffer {
+  /**
+   * The number of extra samples needed by cubic interpolation.
+   */
+  static constexpr size_t INTERPOLATION = 3;
+
+  Metric metric_;
+  size_t max_block_;
+  size_t head_ = 0;
+  std::vector<T, AlignedAllocator<T, ALIGNMENT>> data_;
+
+  /**
+   * Returns the start of the contiguous window of \c count samples at \c
+   * delay.
+   * @throws std::invalid_argument if the window is larger than max_window()
+   * or if \c delay + \c count exceeds elements().
+   */
+  const T *start_of(size_t delay, size_t count) const {
+    if (count > max_window() || delay > elements() - count) {
+      throw std::invalid_argument(
+          "org::simple::CircularBuffer: delay out of range.");
+    }
+    return data_.data() + metric_.unsafe_sub(head_, count + delay);
+  }
+
+  /**
+   * Returns the whole part of the fractional \c delay of an interpolated read
+   * of \c count samples.
+   * @throws std::invalid_argument if the delay is less than \c minimum or if
+   * the interpolated window does not fit in the buffer.
+   */
+  size_t whole_delay(double delay, size_t count, double minimum) const {
+    if (!(delay >= minimum) ||
+        delay + static_cast<double>(count + INTERPOLATION) >
+            static_cast<double>(elements())) {
+      throw std::invalid_argument(
+          "org::simple::CircularBuffer: interpolated delay out of range.");
+    }
+    return static_cast<size_t>(delay);
+  }
+
+public:
+  /**
+   * Creates a buffer with the number of elements of \c metric that can be
+   * written and read in blocks of at most \c max_block samples.
+   * @throws std::invalid_argument if the block with the samples needed for
+   * interpolation does not fit in the buffer.
+   */
+  CircularBuffer(const Metric &metric, size_t max_block)
+      : metric_(metric), max_block_(max_block) {
+    if (max_block == 0 || max_block + INTERPOLATION > metric_.elements()) {
+      throw std::invalid_argument(
+          "org::simple::CircularBuffer: maximum block size must be positive "
+          "and fit in the buffer with three samples to spare.");
+    }
+    data_.resize(metric_.elements() + max_window(), T(0));
+  }
+
+  /**
+   * Creates a buffer with \c elements samples, that can be written and read
+   * in blocks of at most \c max_block samples.
+   */
+  CircularBuffer(size_t elements, size_t max_block) requires
+      std::is_constructible_v<Metric, size_t>
+      : CircularBuffer(Metric(elements), max_block) {}
+
+  size_t elements() const { return metric_.elements(); }
+  size_t max_block() const { return max_block_; }
+
+  /**
+   * Returns the maximum number of samples in a window that is contiguous.
+   */
+  size_t max_window() const { return max_block_ + INTERPOLATION; }
+
+  /**
+   * Sets all samples to zero.
+   */
+  void clear() { std::fill(data_.begin(), data_.end(), T(0)); }
+
+  /**
+   * Writes a block of \c count samples, that must not exceed max_block().
+   * @param input The samples to write.
+   * @param count The number of samples to write.
+   */
+  void write(const T *input, size_t count) {
+    T *data = data_.data();
+    size_t size = elements();
+    size_t first = std::min(count, size - head_);
+    std::copy(input, input + first, data + head_);
+    std::copy(input + first, input + count, data);
+    // Keep the mirrored tail equal to the start of the buffer
+    size_t tail = max_window();
+    if (head_ < tail) {
+      size_t end = std::min(head_ + first, tail);
+      std::copy(data + head_, data + end, data + size + head_);
+    }
+    if (count > first) {
+      size_t end = std::min(count - first, tail);
+      std::copy(data, data + end, data + size);
+    }
+    head_ = metric_.unsafe_add(head_, count);
+  }
+
+  /**
+   * Returns the contiguous window of \c count samples at \c delay, where \c
+   * count must not exceed max_window().
+   * @param delay The delay in samples relative to the most recent block.
+   * @param count The number of samples.
+   * @throws std::invalid_argument if \c delay + \c count exceeds elements().
+   */
+  std::span<const T> window(size_t delay, size_t count) const {
+    return {start_of(delay, count), count};
+  }
+
+  /**
+   * Reads a block of \c count samples at \c delay.
+   * @param output Receives the samples.
+   * @param count The number of samples, at most max_block().
+   * @param delay The delay in samples relative to the most recent block.
+   * @throws std::invalid_argument if \c delay + \c count exceeds elements().
+   */
+  void read(T *output, size_t count, size_t delay) const {
+    const T *source = start_of(delay, count);
+    std::copy(source, source + count, output);
+  }
+
+  /**
+   * Reads a block of \c count samples that is the weighted sum of the
+   * samples at the delays of \c taps taps.
+   * @param output Receives the samples.
+   * @param count The number of samples, at most max_block().
+   * @param delays The delay of each tap.
+   * @param gains The gain of each tap.
+   * @param taps The number of taps.
+   * @throws std::invalid_argument if the delay of a tap + \c count exceeds
+   * elements().
+   */
+  void read_taps(T *output, size_t count, const size_t *delays,
+                 const T *gains, size_t taps) const {
+    std::fill(output, output + count, T(0));
+    for (size_t tap = 0; tap < taps; tap++) {
+      const T *source = start_of(delays[tap], count);
+      const T gain = gains[tap];
+      for (size_t i = 0; i < count; i++) {
+        output[i] += gain * source[i];
+      }
+    }
+  }
+
+  /**
+   * Reads a block of \c count samples at a fractional \c delay, with linear
+   * interpolation between the two nearest samples.
+   * @param output Receives the samples.
+   * @param count The number of samples, at most max_block().
+   * @param delay The delay in samples relative to the most recent block.
+   * @throws std::invalid_argument if the delay is negative or if \c delay +
+   * \c count + 3 exceeds elements().
+   */
+  void read_linear(T *output, size_t count, double delay) const {
+    size_t whole = whole_delay(delay, count, 0);
+    const T fraction = static_cast<T>(delay - static_cast<double>(whole));
+    const T *older = start_of(whole, count + 1);
+    for (size_t i = 0; i < count; i++) {
+      output[i] = older[i + 1] + fraction * (older[i] - older[i + 1]);
+    }
+  }
+
+  /**
+   * Reads a block of \c count samples at a fractional \c delay, with cubic
+   * Hermite (Catmull-Rom) interpolation between the four nearest samples.
+   * As that needs one more recent sample, the delay must be at least one.
+   * @param output Receives the samples.
+   * @param count The number of samples, at most max_block().
+   * @param delay The delay in samples relative to the most recent block.
+   * @throws std::invalid_argument if the delay is less than one or if \c
+   * delay + \c count + 3 exceeds elements().
+   */
+  void read_cubic(T *output, size_t count, double delay) const {
+    size_t whole = whole_delay(delay, count, 1);
+    const T f = static_cast<T>(delay - static_cast<double>(whole));
+    const T *oldest = start_of(whole - 1, count + 3);
+    for (size_t i = 0; i < count; i++) {
+      const T y2 = oldest[i];
+      const T y1 = oldest[i + 1];
+      const T y0 = oldest[i + 2];
+      const T ym1 = oldest[i + 3];
+      const T c1 = T(0.5) * (y1 - ym1);
+      const T c2 = ym1 - T(2.5) * y0 + T(2) * y1 - T(0.5) * y2;
+      const T c3 = T(0.5) * (y2 - ym1) + T(1.5) * (y0 - y1);
+      output[i] = ((c3 * f + c2) * f + c1) * f + y0;
+    }
+  }
+};
+
+} // namespace org::simple
+
+#endif // ORG_SIMPLE_M_CIRCULAR_BUFFER_H
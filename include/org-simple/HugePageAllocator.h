@@ -0,0 +1,196 @@
+#ifndef ORG_SIMPLE_M_HUGE_PAGE_ALLOCATOR_H
+#define ORG_SIMPLE_M_HUGE_PAGE_ALLOCATOR_H
+/*
+ * org-simple/HugePageAllocator.h
+ *
+ * Added by michel on 2026-10-15
+ * Copyright (C) 2015-2026 Michel Fleur.
+ * Source https://github.com/emmef/org-simple
+ * Email org-simple@emmef.org
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstdint>
+#include <limits>
+#include <new>
+#include <org-simple/Align.h>
+#include <type_traits>
+
+#if defined(__linux__)
+#include <linux/mempolicy.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace org::simple {
+
+/**
+ * A memory policy that maps large allocations on huge pages, to reduce TLB
+ * misses on buffers of many megabytes, and optionally binds them to a NUMA
+ * node.
+ *
+ * Allocations of at least \c threshold bytes are mapped with \c MAP_HUGETLB.
+ * If no huge pages are reserved, the memory is mapped on a huge page boundary
+ * with normal pages and \c madvise(MADV_HUGEPAGE) asks for transparent huge
+ * pages instead. Smaller allocations, and all allocations on systems other
+ * than Linux, use aligned operator new.
+ *
+ * Binding to \c node is a request: if the system has no such node or no NUMA
+ * support, the memory is used unbound.
+ */
+struct HugePages {
+  static constexpr size_t HUGE_PAGE = 2 * 1024 * 1024;
+  static constexpr int NO_NODE = -1;
+
+  size_t threshold = HUGE_PAGE;
+  int node = NO_NODE;
+
+  static constexpr size_t mapped_length(size_t bytes) {
+    return (bytes + HUGE_PAGE - 1) & ~(HUGE_PAGE - 1);
+  }
+
+  /**
+   * Returns \c bytes bytes of memory aligned to \c alignment.
+   * @throws std::bad_alloc if the memory cannot be allocated.
+   */
+  void *allocate(size_t bytes, size_t alignment) const {
+#if defined(__linux__)
+    if (bytes >= threshold) {
+      void *memory = map(mapped_length(bytes));
+      bind(memory, mapped_length(bytes));
+      return memory;
+    }
+#endif
+    return ::operator new(bytes, std::align_val_t(alignment));
+  }
+
+  /**
+   * Releases \c memory that was obtained with the same \c bytes and \c
+   * alignment from a policy with the same threshold.
+   */
+  void deallocate(void *memory, size_t bytes, size_t alignment) const {
+#if defined(__linux__)
+    if (bytes >= threshold) {
+      munmap(memory, mapped_length(bytes));
+      return;
+    }
+#endif
+    ::operator delete(memory, std::align_val_t(alignment));
+  }
+
+  bool operator==(const HugePages &) const = default;
+
+private:
+#if defined(__linux__)
+  static void *map(size_t length) {
+    static constexpr int PROTECTION = PROT_READ | PROT_WRITE;
+    static constexpr int FLAGS = MAP_PRIVATE | MAP_ANONYMOUS;
+    void *memory =
+        mmap(nullptr, length, PROTECTION, FLAGS | MAP_HUGETLB, -1, 0);
+    if (memory != MAP_FAILED) {
+      return memory;
+    }
+    // Map an extra huge page to trim the memory to a huge page boundary
+    void *raw = mmap(nullptr, length + HUGE_PAGE, PROTECTION, FLAGS, -1, 0);
+    if (raw == MAP_FAILED) {
+      throw std::bad_alloc();
+    }
+    auto start = reinterpret_cast<uintptr_t>(raw);
+    uintptr_t aligned = (start + HUGE_PAGE - 1) & ~(HUGE_PAGE - 1);
+    size_t head = aligned - start;
+    if (head) {
+      munmap(raw, head);
+    }
+    munmap(reinterpret_cast<void *>(aligned + length), HUGE_PAGE - head);
+    memory = reinterpret_cast<void *>(aligned);
+    madvise(memory, length, MADV_HUGEPAGE);
+    return memory;
+  }
+
+  void bind(void *memory, size_t length) const {
+    static constexpr size_t BITS = std::numeric_limits<unsigned long>::digits;
+    static constexpr size_t MAX_NODES = 1024;
+    if (node < 0 || static_cast<size_t>(node) >= MAX_NODES) {
+      return;
+    }
+    unsigned long mask[MAX_NODES / BITS] = {0};
+    mask[node / BITS] = 1ul << (node % BITS);
+    // The kernel expects one more than the number of bits in the mask
+    syscall(SYS_mbind, memory, length, MPOL_BIND, mask, MAX_NODES + 1, 0);
+  }
+#endif
+};
+
+/**
+ * An allocator that takes its memory from a HugePages policy, with the same
+ * alignment guarantees as AlignedAllocator, so that it can be used for an
+ * AlignedVector or AlignedArray.
+ *
+ * Allocators compare equal if they have the same policy.
+ */
+template <typename Type, size_t ALIGNMENT> class HugePageAllocator {
+  static_assert(Align::isValid<Type>(ALIGNMENT));
+
+  HugePages policy_;
+
+public:
+  typedef Type value_type;
+  typedef std::size_t size_type;
+  typedef std::ptrdiff_t difference_type;
+  static constexpr size_type alignment = Align::fixed<Type>(ALIGNMENT);
+
+  typedef std::true_type propagate_on_container_copy_assignment;
+  typedef std::true_type propagate_on_container_move_assignment;
+  typedef std::true_type propagate_on_container_swap;
+  typedef std::false_type is_always_equal;
+
+  HugePageAllocator() noexcept = default;
+  explicit HugePageAllocator(const HugePages &policy) noexcept
+      : policy_(policy) {}
+  template <typename OtherType>
+  HugePageAllocator(
+      const HugePageAllocator<OtherType, ALIGNMENT> &other) noexcept
+      : policy_(other.policy()) {}
+
+  template <typename OtherType> struct rebind {
+    typedef HugePageAllocator<OtherType, ALIGNMENT> other;
+  };
+
+  const HugePages &policy() const noexcept { return policy_; }
+
+  template <typename OtherType, size_t A>
+  friend bool operator==(const HugePageAllocator &a,
+                         const HugePageAllocator<OtherType, A> &b) noexcept {
+    return a.policy() == b.policy();
+  }
+
+  [[nodiscard]] Type *allocate(size_t elements) {
+    static_assert(sizeof(Type) != 0, "cannot allocate incomplete types");
+
+    if (elements > std::numeric_limits<size_t>::max() / sizeof(Type)) {
+      throw std::bad_array_new_length();
+    }
+    return static_cast<Type *>(
+        policy_.allocate(elements * sizeof(Type), alignment));
+  }
+
+  void deallocate(Type *pointer, size_type elements) noexcept {
+    policy_.deallocate(pointer, elements * sizeof(Type), alignment);
+  }
+};
+
+} // namespace org::simple
+
+#endif // ORG_SIMPLE_M_HUGE_PAGE_ALLOCATOR_H
@@ -0,0 +1,215 @@
+#ifndef ORG_SIMPLE_M_LOCKFREE_QUEUE_H
+#define ORG_SIMPLE_M_LOCKFREE_QUEUE_H
+/*
+ * org-simple/LockFreeQueue.h
+ *
+ * Added by michel on 2026-10-15
+ * Copyright (C) 2015-2026 Michel Fleur.
+ * Source https://github.com/emmef/org-simple
+ * Email org-simple@emmef.org
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <atomic>
+#include <cstddef>
+#include <org-simple/Align.h>
+#include <org-simple/Circular.h>
+
+namespace org::simple {
+
+struct LockFreeQueue {
+
+  /**
+   * The producer side of a bounded queue for multiple producers, after the
+   * design by Dmitry Vyukov. Each slot has a sequence number that tells
+   * whether it can be written for a certain position or read for it, so that
+   * producers only contend on the write position and never on the slots of
+   * consumers.
+   *
+   * A slot at position \c pos can be written when its sequence is \c pos and
+   * can be read when its sequence is \c pos + 1. After reading, the consumer
+   * sets the sequence to \c pos + capacity(), which is the next position that
+   * maps to the same slot.
+   *
+   * @tparam T The type of values in the queue.
+   * @tparam S The queue capacity, that is rounded up to a power of two.
+   */
+  template <typename T, size_t S> class BaseMultiProducer {
+  protected:
+    using Metric = ::org::simple::Circular::FixedMetric<
+        ::org::simple::WrappingType::BIT_MASK, S>;
+
+    struct Slot {
+      std::atomic_size_t sequence;
+      T value;
+    };
+
+    Slot slots[Metric::elements()];
+    alignas(Align::cacheLine) std::atomic_size_t write_at = 0;
+
+    BaseMultiProducer() {
+      for (size_t i = 0; i < Metric::elements(); i++) {
+        slots[i].sequence.store(i, std::memory_order_relaxed);
+      }
+    }
+
+    static std::ptrdiff_t distance(size_t sequence, size_t position) {
+      return static_cast<std::ptrdiff_t>(sequence - position);
+    }
+
+  public:
+    static constexpr size_t capacity() { return Metric::elements(); }
+
+    /**
+     * Pushes \c value on the queue, which fails if the queue is full. This
+     * is safe to call from multiple threads concurrently.
+     * @param value The value to push.
+     * @returns \c true if push was successful, \c false otherwise.
+     */
+    bool write(const T &value) {
+      size_t pos = write_at.load(std::memory_order_relaxed);
+      while (true) {
+        Slot &slot = slots[Metric::wrapped(pos)];
+        std::ptrdiff_t d =
+            distance(slot.sequence.load(std::memory_order_acquire), pos);
+        if (d == 0) {
+          if (write_at.compare_exchange_weak(pos, pos + 1,
+                                             std::memory_order_relaxed)) {
+            slot.value = value;
+            slot.sequence.store(pos + 1, std::memory_order_release);
+            return true;
+          }
+        } else if (d < 0) {
+          return false;
+        } else {
+          pos = write_at.load(std::memory_order_relaxed);
+        }
+      }
+    }
+  };
+
+  /**
+   * A bounded queue that is thread-safe for multiple producer and multiple
+   * consumer threads. Both producers and consumers claim a position with a
+   * compare-and-swap, after which they access the slot without further
+   * contention.
+   *
+   * The queue never blocks, but is not wait-free: a producer or consumer that
+   * is suspended after claiming a position, stalls the threads that want to
+   * use that slot a lap later.
+   *
+   * @tparam T The type of values in the queue.
+   * @tparam S The queue capacity, that is rounded up to a power of two.
+   */
+  template <typename T, size_t S>
+  class MultiProducerMultiConsumer : public BaseMultiProducer<T, S> {
+    using Base = BaseMultiProducer<T, S>;
+    using typename Base::Metric;
+    using typename Base::Slot;
+    using Base::distance;
+    using Base::slots;
+    alignas(Align::cacheLine) std::atomic_size_t read_at = 0;
+
+  public:
+    /**
+     * Returns the number of elements in the queue, which is only accurate if
+     * no threads are accessing the queue.
+     */
+    size_t size() const {
+      return Base::write_at.load(std::memory_order_relaxed) -
+             read_at.load(std::memory_order_relaxed);
+    }
+    bool empty() const { return size() == 0; }
+
+    /**
+     * Shifts a value off the queue into \c value, which fails if the queue is
+     * empty. This is safe to call from multiple threads concurrently.
+     * @param value Contains the shifted value on success.
+     * @returns \c true if shift was successful, \c false otherwise
+     */
+    bool read(T &value) {
+      size_t pos = read_at.load(std::memory_order_relaxed);
+      while (true) {
+        Slot &slot = slots[Metric::wrapped(pos)];
+        std::ptrdiff_t d =
+            distance(slot.sequence.load(std::memory_order_acquire), pos + 1);
+        if (d == 0) {
+          if (read_at.compare_exchange_weak(pos, pos + 1,
+                                            std::memory_order_relaxed)) {
+            value = slot.value;
+            slot.sequence.store(pos + Metric::elements(),
+                                std::memory_order_release);
+            return true;
+          }
+        } else if (d < 0) {
+          return false;
+        } else {
+          pos = read_at.load(std::memory_order_relaxed);
+        }
+      }
+    }
+  };
+
+  /**
+   * A bounded queue that is thread-safe for multiple producer threads and a
+   * single consumer thread. Producers behave as in MultiProducerMultiConsumer,
+   * but the consumer owns the read position and needs no compare-and-swap,
+   * which makes reading considerably cheaper. This suits many threads that
+   * send events to a single real-time thread.
+   *
+   * @tparam T The type of values in the queue.
+   * @tparam S The queue capacity, that is rounded up to a power of two.
+   */
+  template <typename T, size_t S>
+  class MultiProducerSingleConsumer : public BaseMultiProducer<T, S> {
+    using Base = BaseMultiProducer<T, S>;
+    using typename Base::Metric;
+    using typename Base::Slot;
+    using Base::slots;
+    alignas(Align::cacheLine) std::atomic_size_t read_at = 0;
+
+  public:
+    /**
+     * Returns the number of elements in the queue, which is only accurate if
+     * no threads are accessing the queue.
+     */
+    size_t size() const {
+      return Base::write_at.load(std::memory_order_relaxed) -
+             read_at.load(std::memory_order_relaxed);
+    }
+    bool empty() const { return size() == 0; }
+
+    /**
+     * Shifts a value off the queue into \c value, which fails if the queue is
+     * empty. This must only be called by the single consumer thread.
+     * @param value Contains the shifted value on success.
+     * @returns \c true if shift was successful, \c false otherwise
+     */
+    bool read(T &value) {
+      size_t pos = read_at.load(std::memory_order_relaxed);
+      Slot &slot = slots[Metric::wrapped(pos)];
+      if (slot.sequence.load(std::memory_order_acquire) != pos + 1) {
+        return false;
+      }
+      value = slot.value;
+      slot.sequence.store(pos + Metric::elements(), std::memory_order_release);
+      read_at.store(pos + 1, std::memory_order_relaxed);
+      return true;
+    }
+  };
+};
+
+} // namespace org::simple
+
+#endif // ORG_SIMPLE_M_LOCKFREE_QUEUE_H
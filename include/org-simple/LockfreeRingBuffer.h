@@ -21,27 +21,316 @@
  * limitations under the License.
  */
 
+#include <algorithm>
 #include <atomic>
 #include <cstddef>
+#include <cstring>
+#include <org-simple/Align.h>
 #include <org-simple/Circular.h>
+#include <span>
 
 namespace org::simple {
 
 struct LockFreeRingBuffer {
 
-  template <typename T, size_t S> class BaseMonotonicFixedMasked {
+  /**
+   * Describes a region of buffer elements that can be accessed without
+   * copying. Because the buffer wraps around, the region consists of at most
+   * two consecutive parts, where the second part is only non-empty if the
+   * region wraps.
+   * @tparam T The type of values in the buffer.
+   */
+  template <typename T> struct Region {
+    std::span<T> first;
+    std::span<T> second;
+
+    size_t size() const { return first.size() + second.size(); }
+    bool empty() const { return size() == 0; }
+
+    T &operator[](size_t i) const {
+      return i < first.size() ? first[i] : second[i - first.size()];
+    }
+  };
+
+  /**
+   * Accesses the indices with sequentially consistent loads and stores. The
+   * producer issues a release fence before it publishes its index and the
+   * consumer an acquire fence after it obtained the write index. This is the
+   * most conservative ordering, but on x86 every published index costs a
+   * locked instruction.
+   */
+  struct SequentiallyConsistent {
+    static constexpr std::memory_order own = std::memory_order_seq_cst;
+    static constexpr std::memory_order peer = std::memory_order_seq_cst;
+    static constexpr std::memory_order publish = std::memory_order_seq_cst;
+
+    static void release_fence() {
+      std::atomic_thread_fence(std::memory_order_release);
+    }
+    static void acquire_fence() {
+      std::atomic_thread_fence(std::memory_order_acquire);
+    }
+  };
+
+  /**
+   * Accesses the indices with the weakest ordering that is still correct for a
+   * single producer and consumer: a side loads its own index relaxed, as it is
+   * the only one that writes it, loads the peer index with acquire and
+   * publishes its own index with release. No fences are needed, which makes
+   * both sides fence-free on x86 and cheaper on weakly ordered architectures.
+   *
+   * The consumer is an exception to this rule, as the producer writes the read
+   * index when it resets the indices. The consumer therefore loads its own
+   * index with acquire as well.
+   */
+  struct AcquireRelease {
+    static constexpr std::memory_order own = std::memory_order_relaxed;
+    static constexpr std::memory_order peer = std::memory_order_acquire;
+    static constexpr std::memory_order publish = std::memory_order_release;
+
+    static void release_fence() {}
+    static void acquire_fence() {}
+  };
+
+  /**
+   * Keeps the read and write index next to each other, which is compact, but
+   * lets the producer and consumer contend for the same cache line on every
+   * operation.
+   *
+   * An index policy provides the indices to the producer and consumer side of
+   * the buffer. The producer obtains its own write index and the read index,
+   * where it may receive a cached value of the latter as long as that leaves
+   * more than \c max_used elements free. Likewise, the consumer obtains its
+   * own read index and the write index, where it may receive a cached value of
+   * the latter as long as that indicates at least \c wanted elements can be
+   * read. If the producer reset the indices after the consumer obtained its
+   * read index, the write index is unrelated to that read index, so the
+   * consumer receives its read index instead and finds nothing to read. The
+   * policy also takes care of ordering the accesses to the elements with
+   * respect to publishing and obtaining the indices.
+   *
+   * @tparam Order Determines the memory ordering of index loads and stores,
+   * either SequentiallyConsistent or AcquireRelease.
+   */
+  template <class Order = SequentiallyConsistent> class SharedIndices {
     std::atomic_size_t read_at = 0;
     std::atomic_size_t write_at = 0;
+
+  public:
+    size_t read_ptr() const { return read_at; }
+    size_t write_ptr() const { return write_at; }
+
+    size_t producer_write() const { return write_at.load(Order::own); }
+    size_t producer_read(size_t, size_t) const {
+      return read_at.load(Order::peer);
+    }
+    void publish_write(size_t wr) {
+      Order::release_fence();
+      write_at.store(wr, Order::publish);
+    }
+    void reset(size_t wr) {
+      Order::release_fence();
+      write_at.store(wr, Order::publish);
+      read_at.store(0, Order::publish);
+    }
+
+    size_t consumer_read() const { return read_at.load(Order::peer); }
+    size_t consumer_write(size_t rd, size_t) const {
+      size_t wr = write_at.load(Order::peer);
+      Order::acquire_fence();
+      // A reset stores the read index after the write index
+      return read_at.load(Order::peer) == rd ? wr : rd;
+    }
+    void publish_read(size_t rd) { read_at.store(rd, Order::publish); }
+  };
+
+  /**
+   * Keeps the producer and consumer indices on separate cache lines. The
+   * producer keeps a cached copy of the read index and the consumer a cached
+   * copy of the write index, so that the cache line of the other side is only
+   * reloaded when the buffer looks full or empty, respectively.
+   *
+   * The consumer detects that the producer reset the indices, as the read index
+   * then differs from the one it last published itself. A reset after the
+   * consumer obtained its read index is detected in the same way when it
+   * reloads the write index. Without reloading, no reset can happen, as the
+   * cached write index shows there are elements to read.
+   *
+   * @tparam Order Determines the memory ordering of index loads and stores,
+   * either SequentiallyConsistent or AcquireRelease.
+   */
+  template <class Order = SequentiallyConsistent> class PaddedIndices {
+    struct alignas(Align::cacheLine) Producer {
+      std::atomic_size_t write_at = 0;
+      size_t cached_read_at = 0;
+    };
+    struct alignas(Align::cacheLine) Consumer {
+      std::atomic_size_t read_at = 0;
+      size_t cached_write_at = 0;
+      size_t published_read_at = 0;
+    };
+    Producer producer;
+    Consumer consumer;
+
+  public:
+    size_t read_ptr() const { return consumer.read_at; }
+    size_t write_ptr() const { return producer.write_at; }
+
+    size_t producer_write() const {
+      return producer.write_at.load(Order::own);
+    }
+    size_t producer_read(size_t wr, size_t max_used) {
+      if (wr - producer.cached_read_at > max_used) {
+        producer.cached_read_at = consumer.read_at.load(Order::peer);
+      }
+      return producer.cached_read_at;
+    }
+    void publish_write(size_t wr) {
+      Order::release_fence();
+      producer.write_at.store(wr, Order::publish);
+    }
+    void reset(size_t wr) {
+      Order::release_fence();
+      producer.write_at.store(wr, Order::publish);
+      consumer.read_at.store(0, Order::publish);
+      producer.cached_read_at = 0;
+    }
+
+    size_t consumer_read() {
+      size_t rd = consumer.read_at.load(Order::peer);
+      if (rd != consumer.published_read_at) {
+        // The producer reset the indices
+        consumer.published_read_at = rd;
+        consumer.cached_write_at = rd;
+      }
+      return rd;
+    }
+    size_t consumer_write(size_t rd, size_t wanted) {
+      if (consumer.cached_write_at - rd < wanted) {
+        size_t wr = producer.write_at.load(Order::peer);
+        if (consumer.read_at.load(Order::peer) != rd) {
+          // A reset stores the read index after the write index
+          return rd;
+        }
+        consumer.cached_write_at = wr;
+      }
+      Order::acquire_fence();
+      return consumer.cached_write_at;
+    }
+    void publish_read(size_t rd) {
+      consumer.published_read_at = rd;
+      consumer.read_at.store(rd, Order::publish);
+    }
+  };
+
+  /**
+   * A snapshot of the statistics of a buffer.
+   */
+  struct StatisticsSnapshot {
+    /**
+     * The highest number of elements in the buffer, as observed by the
+     * producer. With cached indices, this may overestimate the occupancy.
+     */
+    size_t max_occupancy = 0;
+    /**
+     * The number of values that could not be written as the buffer was full.
+     */
+    size_t failed_writes = 0;
+    /**
+     * The number of values that were requested but not available to read.
+     */
+    size_t failed_reads = 0;
+    /**
+     * The total number of values written.
+     */
+    size_t written = 0;
+    /**
+     * The total number of values read.
+     */
+    size_t read = 0;
+  };
+
+  /**
+   * A statistics policy that keeps nothing, so that the buffer compiles to the
+   * same code as without statistics.
+   */
+  struct NoStatistics {
+    static constexpr bool enabled = false;
+
+    void on_write(size_t, size_t) {}
+    void on_write_failed(size_t) {}
+    void on_read(size_t) {}
+    void on_read_failed(size_t) {}
+    StatisticsSnapshot snapshot() const { return {}; }
+  };
+
+  /**
+   * A statistics policy that keeps counters for the producer and the consumer
+   * on separate cache lines. Each counter has a single writer, so it is updated
+   * with a relaxed load and store instead of a read-modify-write. A snapshot
+   * can be taken from any thread.
+   */
+  class CountingStatistics {
+    struct alignas(Align::cacheLine) Producer {
+      std::atomic_size_t max_occupancy = 0;
+      std::atomic_size_t failed_writes = 0;
+      std::atomic_size_t written = 0;
+    };
+    struct alignas(Align::cacheLine) Consumer {
+      std::atomic_size_t failed_reads = 0;
+      std::atomic_size_t read = 0;
+    };
+    Producer producer;
+    Consumer consumer;
+
+    static void add(std::atomic_size_t &counter, size_t delta) {
+      counter.store(counter.load(std::memory_order_relaxed) + delta,
+                    std::memory_order_relaxed);
+    }
+
+  public:
+    static constexpr bool enabled = true;
+
+    void on_write(size_t count, size_t occupancy) {
+      add(producer.written, count);
+      if (occupancy > producer.max_occupancy.load(std::memory_order_relaxed)) {
+        producer.max_occupancy.store(occupancy, std::memory_order_relaxed);
+      }
+    }
+    void on_write_failed(size_t count) { add(producer.failed_writes, count); }
+    void on_read(size_t count) { add(consumer.read, count); }
+    void on_read_failed(size_t count) { add(consumer.failed_reads, count); }
+
+    StatisticsSnapshot snapshot() const {
+      StatisticsSnapshot result;
+      result.max_occupancy =
+          producer.max_occupancy.load(std::memory_order_relaxed);
+      result.failed_writes =
+          producer.failed_writes.load(std::memory_order_relaxed);
+      result.failed_reads =
+          consumer.failed_reads.load(std::memory_order_relaxed);
+      result.written = producer.written.load(std::memory_order_relaxed);
+      result.read = consumer.read.load(std::memory_order_relaxed);
+      return result;
+    }
+  };
+
+  template <typename T, size_t S, class Indices = SharedIndices<>,
+            class Statistics = NoStatistics>
+  class BaseMonotonicFixedMasked {
+    Indices indices;
+    [[no_unique_address]] Statistics statistics_;
     using Metric = ::org::simple::Circular::FixedMetric<
         ::org::simple::WrappingType::BIT_MASK, S>;
 
   public:
     size_t capacity() const { return Metric::elements(); }
-    size_t size() const { return write_at - read_at; }
+    size_t size() const { return indices.write_ptr() - indices.read_ptr(); }
     bool empty() const { return size() == 0; }
     bool full() const { return size() == capacity(); }
-    size_t read_ptr() const { return read_at; }
-    size_t write_ptr() const { return write_at; }
+    size_t read_ptr() const { return indices.read_ptr(); }
+    size_t write_ptr() const { return indices.write_ptr(); }
+    StatisticsSnapshot statistics() const { return statistics_.snapshot(); }
 
     /**
      * Pushes \c value on the queue, which fails if the queue is full.
@@ -49,17 +338,79 @@ struct LockFreeRingBuffer {
      * @returns \c true if push was successful, \c false otherwise.
      */
     bool write(const T &value, T *const data) {
-      size_t wr = write_at;
-      size_t rd = read_at;
+      size_t wr = indices.producer_write();
+      size_t rd = indices.producer_read(wr, capacity() - 1);
       if (wr - rd >= capacity()) {
+        statistics_.on_write_failed(1);
         return false;
       }
       data[Metric::wrapped(wr)] = value;
-      std::atomic_thread_fence(std::memory_order_release);
-      write_at = wr + 1;
+      indices.publish_write(wr + 1);
+      statistics_.on_write(1, wr + 1 - rd);
       return true;
     }
 
+    /**
+     * Pushes as many of the \c count values in \c values on the queue as
+     * there is room for. All pushed values are published at once, with a single
+     * index store.
+     * @param values The values to push.
+     * @param count The number of values to push.
+     * @returns The number of values that was actually pushed.
+     */
+    size_t write(const T *values, size_t count, T *const data) {
+      size_t wr = indices.producer_write();
+      size_t rd = indices.producer_read(wr, max_used_for(count));
+      size_t n = std::min(count, capacity() - (wr - rd));
+      if (n < count) {
+        statistics_.on_write_failed(count - n);
+      }
+      if (n == 0) {
+        return 0;
+      }
+      size_t start = Metric::wrapped(wr);
+      size_t first = std::min(n, capacity() - start);
+      std::copy(values, values + first, data + start);
+      std::copy(values + first, values + n, data);
+      indices.publish_write(wr + n);
+      statistics_.on_write(n, wr + n - rd);
+      return n;
+    }
+
+    /**
+     * Returns the region of at most \c count elements that can be written
+     * without copying. The written values become visible to the reader after
+     * calling commit().
+     * @param count The maximum number of elements to write.
+     * @returns The region that can be written, which is empty if the queue is
+     * full.
+     */
+    Region<T> acquire_write(size_t count, T *const data) {
+      size_t wr = indices.producer_write();
+      size_t rd = indices.producer_read(wr, max_used_for(count));
+      size_t n = std::min(count, capacity() - (wr - rd));
+      if (n < count) {
+        statistics_.on_write_failed(count - n);
+      }
+      size_t start = Metric::wrapped(wr);
+      size_t first = std::min(n, capacity() - start);
+      return {{data + start, first}, {data, n - first}};
+    }
+
+    /**
+     * Publishes \c count elements that were written in a region obtained
+     * by acquire_write(). Committing more elements than the region contained
+     * leaves the queue in an undefined state.
+     * @param count The number of elements to publish.
+     */
+    void commit(size_t count) {
+      size_t wr = indices.producer_write() + count;
+      indices.publish_write(wr);
+      if constexpr (Statistics::enabled) {
+        statistics_.on_write(count, wr - indices.producer_read(wr, capacity()));
+      }
+    }
+
     /**
      * Pushes \c value on the queue, which fails if the queue is full, and if
      * the queue is empty resets read and write counters.
@@ -67,23 +418,23 @@ struct LockFreeRingBuffer {
      * @returns \c true if push was successful, \c false otherwise.
      */
     bool write_if_empty_reset(const T &value, T *const data) {
-      size_t wr = write_at;
-      size_t rd = read_at;
+      size_t wr = indices.producer_write();
+      size_t rd = indices.producer_read(wr, 0);
       size_t elements = wr - rd;
       if (elements == 0) {
         // Buffer is EMPTY, so no read can happen and resetting counters
         // can be done without a race condition
         data[Metric::wrapped(0)] = value;
-        std::atomic_thread_fence(std::memory_order_release);
-        write_at = 1;
-        read_at = 0;
+        indices.reset(1);
+        statistics_.on_write(1, 1);
         return true;
       } else if (elements >= capacity()) {
+        statistics_.on_write_failed(1);
         return false;
       }
       data[Metric::wrapped(wr)] = value;
-      std::atomic_thread_fence(std::memory_order_release);
-      write_at = wr + 1;
+      indices.publish_write(wr + 1);
+      statistics_.on_write(1, elements + 1);
       return true;
     }
 
@@ -96,24 +447,24 @@ struct LockFreeRingBuffer {
      */
     bool write_if_empty_reset_total(const T &value, T *const data,
                                     std::atomic_size_t &total) {
-      size_t wr = write_at;
-      size_t rd = read_at;
+      size_t wr = indices.producer_write();
+      size_t rd = indices.producer_read(wr, 0);
       size_t elements = wr - rd;
       if (elements == 0) {
         // Buffer is EMPTY, so no read can happen and resetting counters
         // can be done without a race condition
         total += wr;
         data[Metric::wrapped(0)] = value;
-        std::atomic_thread_fence(std::memory_order_release);
-        write_at = 1;
-        read_at = 0;
+        indices.reset(1);
+        statistics_.on_write(1, 1);
         return true;
       } else if (elements >= capacity()) {
+        statistics_.on_write_failed(1);
         return false;
       }
       data[Metric::wrapped(wr)] = value;
-      std::atomic_thread_fence(std::memory_order_release);
-      write_at = wr + 1;
+      indices.publish_write(wr + 1);
+      statistics_.on_write(1, elements + 1);
       return true;
     }
 
@@ -124,32 +475,111 @@ struct LockFreeRingBuffer {
      * @returns \c true if shift was successful, \c false otherwise
      */
     bool read(T &value, const T *const data) {
-      size_t rd = read_at;
-      size_t wr = write_at;
+      size_t rd = indices.consumer_read();
+      size_t wr = indices.consumer_write(rd, 1);
       if (wr <= rd) {
+        statistics_.on_read_failed(1);
         return false;
       }
-      std::atomic_thread_fence(std::memory_order_acquire);
       value = data[Metric::wrapped(rd)];
-      read_at = rd + 1;
+      indices.publish_read(rd + 1);
+      statistics_.on_read(1);
       return true;
     }
+
+    /**
+     * Shifts at most \c count values off the queue into \c values. All
+     * shifted values are released at once, with a single index store.
+     * @param values Contains the shifted values on success.
+     * @param count The maximum number of values to shift.
+     * @returns The number of values that was actually shifted.
+     */
+    size_t read(T *values, size_t count, const T *const data) {
+      size_t rd = indices.consumer_read();
+      size_t wr = indices.consumer_write(rd, count);
+      if (wr <= rd) {
+        statistics_.on_read_failed(count);
+        return 0;
+      }
+      size_t n = std::min(count, wr - rd);
+      if (n < count) {
+        statistics_.on_read_failed(count - n);
+      }
+      if (n == 0) {
+        return 0;
+      }
+      size_t start = Metric::wrapped(rd);
+      size_t first = std::min(n, capacity() - start);
+      std::copy(data + start, data + start + first, values);
+      std::copy(data, data + n - first, values + first);
+      indices.publish_read(rd + n);
+      statistics_.on_read(n);
+      return n;
+    }
+
+    /**
+     * Returns the region of at most \c count elements that can be read
+     * without copying. The elements are released to the writer after calling
+     * consume().
+     * @param count The maximum number of elements to read.
+     * @returns The region that can be read, which is empty if the queue is
+     * empty.
+     */
+    Region<const T> acquire_read(size_t count, const T *const data) {
+      size_t rd = indices.consumer_read();
+      size_t wr = indices.consumer_write(rd, count);
+      if (wr <= rd) {
+        statistics_.on_read_failed(count);
+        return {};
+      }
+      size_t n = std::min(count, wr - rd);
+      if (n < count) {
+        statistics_.on_read_failed(count - n);
+      }
+      size_t start = Metric::wrapped(rd);
+      size_t first = std::min(n, capacity() - start);
+      return {{data + start, first}, {data, n - first}};
+    }
+
+    /**
+     * Releases \c count elements that were read in a region obtained by
+     * acquire_read(). Consuming more elements than the region contained leaves
+     * the queue in an undefined state. Consuming nothing does not publish
+     * the read index, as the producer may have reset the indices after the
+     * region was found empty.
+     * @param count The number of elements to release.
+     */
+    void consume(size_t count) {
+      if (count == 0) {
+        return;
+      }
+      indices.publish_read(indices.consumer_read() + count);
+      statistics_.on_read(count);
+    }
+
+  private:
+    size_t max_used_for(size_t count) const {
+      return capacity() - std::min(count, capacity());
+    }
   };
 
-  template <typename T, class Metric> class BaseMonotonic {
-    std::atomic_size_t read_at = 0;
-    std::atomic_size_t write_at = 0;
+  template <typename T, class Metric, class Indices = SharedIndices<>,
+            class Statistics = NoStatistics>
+  class BaseMonotonic {
+    Indices indices;
+    [[no_unique_address]] Statistics statistics_;
     const Metric &metric;
 
   public:
     BaseMonotonic(const Metric &metric__) : metric(metric__) {}
 
     size_t capacity() const { return metric.elements(); }
-    size_t size() const { return write_at - read_at; }
+    size_t size() const { return indices.write_ptr() - indices.read_ptr(); }
     bool empty() const { return size() == 0; }
     bool full() const { return size() == capacity(); }
-    size_t read_ptr() const { return read_at; }
-    size_t write_ptr() const { return write_at; }
+    size_t read_ptr() const { return indices.read_ptr(); }
+    size_t write_ptr() const { return indices.write_ptr(); }
+    StatisticsSnapshot statistics() const { return statistics_.snapshot(); }
 
     /**
      * Pushes \c value on the queue, which fails if the queue is full.
@@ -157,17 +587,79 @@ struct LockFreeRingBuffer {
      * @returns \c true if push was successful, \c false otherwise.
      */
     bool write(const T &value, T *const data) {
-      size_t wr = write_at;
-      size_t rd = read_at;
+      size_t wr = indices.producer_write();
+      size_t rd = indices.producer_read(wr, capacity() - 1);
       if (wr - rd >= capacity()) {
+        statistics_.on_write_failed(1);
         return false;
       }
       data[metric.wrapped(wr)] = value;
-      std::atomic_thread_fence(std::memory_order_release);
-      write_at = wr + 1;
+      indices.publish_write(wr + 1);
+      statistics_.on_write(1, wr + 1 - rd);
       return true;
     }
 
+    /**
+     * Pushes as many of the \c count values in \c values on the queue as
+     * there is room for. All pushed values are published at once, with a single
+     * index store.
+     * @param values The values to push.
+     * @param count The number of values to push.
+     * @returns The number of values that was actually pushed.
+     */
+    size_t write(const T *values, size_t count, T *const data) {
+      size_t wr = indices.producer_write();
+      size_t rd = indices.producer_read(wr, max_used_for(count));
+      size_t n = std::min(count, capacity() - (wr - rd));
+      if (n < count) {
+        statistics_.on_write_failed(count - n);
+      }
+      if (n == 0) {
+        return 0;
+      }
+      size_t start = metric.wrapped(wr);
+      size_t first = std::min(n, capacity() - start);
+      std::copy(values, values + first, data + start);
+      std::copy(values + first, values + n, data);
+      indices.publish_write(wr + n);
+      statistics_.on_write(n, wr + n - rd);
+      return n;
+    }
+
+    /**
+     * Returns the region of at most \c count elements that can be written
+     * without copying. The written values become visible to the reader after
+     * calling commit().
+     * @param count The maximum number of elements to write.
+     * @returns The region that can be written, which is empty if the queue is
+     * full.
+     */
+    Region<T> acquire_write(size_t count, T *const data) {
+      size_t wr = indices.producer_write();
+      size_t rd = indices.producer_read(wr, max_used_for(count));
+      size_t n = std::min(count, capacity() - (wr - rd));
+      if (n < count) {
+        statistics_.on_write_failed(count - n);
+      }
+      size_t start = metric.wrapped(wr);
+      size_t first = std::min(n, capacity() - start);
+      return {{data + start, first}, {data, n - first}};
+    }
+
+    /**
+     * Publishes \c count elements that were written in a region obtained
+     * by acquire_write(). Committing more elements than the region contained
+     * leaves the queue in an undefined state.
+     * @param count The number of elements to publish.
+     */
+    void commit(size_t count) {
+      size_t wr = indices.producer_write() + count;
+      indices.publish_write(wr);
+      if constexpr (Statistics::enabled) {
+        statistics_.on_write(count, wr - indices.producer_read(wr, capacity()));
+      }
+    }
+
     /**
      * Pushes \c value on the queue, which fails if the queue is full, and if
      * the queue is empty resets read and write counters.
@@ -175,23 +667,23 @@ struct LockFreeRingBuffer {
      * @returns \c true if push was successful, \c false otherwise.
      */
     bool write_if_empty_reset(const T &value, T *const data) {
-      size_t wr = write_at;
-      size_t rd = read_at;
+      size_t wr = indices.producer_write();
+      size_t rd = indices.producer_read(wr, 0);
       size_t elements = wr - rd;
       if (elements == 0) {
         // Buffer is EMPTY, so no read can happen and resetting counters
         // can be done without a race condition
         data[metric.wrapped(0)] = value;
-        std::atomic_thread_fence(std::memory_order_release);
-        write_at = 1;
-        read_at = 0;
+        indices.reset(1);
+        statistics_.on_write(1, 1);
         return true;
       } else if (elements >= capacity()) {
+        statistics_.on_write_failed(1);
         return false;
       }
       data[metric.wrapped(wr)] = value;
-      std::atomic_thread_fence(std::memory_order_release);
-      write_at = wr + 1;
+      indices.publish_write(wr + 1);
+      statistics_.on_write(1, elements + 1);
       return true;
     }
 
@@ -204,24 +696,24 @@ struct LockFreeRingBuffer {
      */
     bool write_if_empty_reset_total(const T &value, T *const data,
                                     std::atomic_size_t &total) {
-      size_t wr = write_at;
-      size_t rd = read_at;
+      size_t wr = indices.producer_write();
+      size_t rd = indices.producer_read(wr, 0);
       size_t elements = wr - rd;
       if (elements == 0) {
         // Buffer is EMPTY, so no read can happen and resetting counters
         // can be done without a race condition
         total += wr;
         data[metric.wrapped(0)] = value;
-        std::atomic_thread_fence(std::memory_order_release);
-        write_at = 1;
-        read_at = 0;
+        indices.reset(1);
+        statistics_.on_write(1, 1);
         return true;
       } else if (elements >= capacity()) {
+        statistics_.on_write_failed(1);
         return false;
       }
       data[metric.wrapped(wr)] = value;
-      std::atomic_thread_fence(std::memory_order_release);
-      write_at = wr + 1;
+      indices.publish_write(wr + 1);
+      statistics_.on_write(1, elements + 1);
       return true;
     }
 
@@ -232,16 +724,92 @@ struct LockFreeRingBuffer {
      * @returns \c true if shift was successful, \c false otherwise
      */
     bool read(T &value, const T *const data) {
-      size_t rd = read_at;
-      size_t wr = write_at;
+      size_t rd = indices.consumer_read();
+      size_t wr = indices.consumer_write(rd, 1);
       if (wr <= rd) {
+        statistics_.on_read_failed(1);
         return false;
       }
-      std::atomic_thread_fence(std::memory_order_acquire);
       value = data[metric.wrapped(rd)];
-      read_at = rd + 1;
+      indices.publish_read(rd + 1);
+      statistics_.on_read(1);
       return true;
     }
+
+    /**
+     * Shifts at most \c count values off the queue into \c values. All
+     * shifted values are released at once, with a single index store.
+     * @param values Contains the shifted values on success.
+     * @param count The maximum number of values to shift.
+     * @returns The number of values that was actually shifted.
+     */
+    size_t read(T *values, size_t count, const T *const data) {
+      size_t rd = indices.consumer_read();
+      size_t wr = indices.consumer_write(rd, count);
+      if (wr <= rd) {
+        statistics_.on_read_failed(count);
+        return 0;
+      }
+      size_t n = std::min(count, wr - rd);
+      if (n < count) {
+        statistics_.on_read_failed(count - n);
+      }
+      if (n == 0) {
+        return 0;
+      }
+      size_t start = metric.wrapped(rd);
+      size_t first = std::min(n, capacity() - start);
+      std::copy(data + start, data + start + first, values);
+      std::copy(data, data + n - first, values + first);
+      indices.publish_read(rd + n);
+      statistics_.on_read(n);
+      return n;
+    }
+
+    /**
+     * Returns the region of at most \c count elements that can be read
+     * without copying. The elements are released to the writer after calling
+     * consume().
+     * @param count The maximum number of elements to read.
+     * @returns The region that can be read, which is empty if the queue is
+     * empty.
+     */
+    Region<const T> acquire_read(size_t count, const T *const data) {
+      size_t rd = indices.consumer_read();
+      size_t wr = indices.consumer_write(rd, count);
+      if (wr <= rd) {
+        statistics_.on_read_failed(count);
+        return {};
+      }
+      size_t n = std::min(count, wr - rd);
+      if (n < count) {
+        statistics_.on_read_failed(count - n);
+      }
+      size_t start = metric.wrapped(rd);
+      size_t first = std::min(n, capacity() - start);
+      return {{data + start, first}, {data, n - first}};
+    }
+
+    /**
+     * Releases \c count elements that were read in a region obtained by
+     * acquire_read(). Consuming more elements than the region contained leaves
+     * the queue in an undefined state. Consuming nothing does not publish
+     * the read index, as the producer may have reset the indices after the
+     * region was found empty.
+     * @param count The number of elements to release.
+     */
+    void consume(size_t count) {
+      if (count == 0) {
+        return;
+      }
+      indices.publish_read(indices.consumer_read() + count);
+      statistics_.on_read(count);
+    }
+
+  private:
+    size_t max_used_for(size_t count) const {
+      return capacity() - std::min(count, capacity());
+    }
   };
 
   /**
@@ -256,12 +824,19 @@ struct LockFreeRingBuffer {
    *
    * @tparam T The type of values in the buffer.
    * @tparam S The buffer capacity
+   * @tparam Indices The policy that keeps the read and write index.
+   * @tparam Statistics The policy that keeps statistics, like
+   * CountingStatistics, or NoStatistics to keep none.
    */
-  template <typename T, size_t S> class MonotonicFixed {
-    BaseMonotonicFixedMasked<T, S> base;
+  template <typename T, size_t S, class Indices = SharedIndices<>,
+            class Statistics = NoStatistics>
+  class MonotonicFixed {
+    BaseMonotonicFixedMasked<T, S, Indices, Statistics> base;
     T data[S];
 
   public:
+    using value_type = T;
+
     size_t capacity() const { return base.capacity(); }
     size_t size() const { return base.size(); }
     bool empty() const { return base.empty(); }
@@ -269,6 +844,12 @@ struct LockFreeRingBuffer {
     size_t read_ptr() const { return base.read_ptr(); }
     size_t write_ptr() const { return base.write_ptr(); }
 
+    /**
+     * Returns a snapshot of the statistics, that is empty if the buffer keeps
+     * no statistics. This can be called from any thread.
+     */
+    StatisticsSnapshot statistics() const { return base.statistics(); }
+
     void zero() { std::memset(data, 0, sizeof(data)); }
     /**
      * Pushes \c value on the queue, which fails if the queue is full.
@@ -278,6 +859,39 @@ struct LockFreeRingBuffer {
      */
     bool write(const T &value) { return base.write(value, data); }
 
+    /**
+     * Pushes as many of the \c count values in \c values on the queue as
+     * there is room for, publishing them all at once.
+     *
+     * @param values The values to push.
+     * @param count The number of values to push.
+     * @returns The number of values that was actually pushed.
+     */
+    size_t write(const T *values, size_t count) {
+      return base.write(values, count, data);
+    }
+
+    /**
+     * Returns the region of at most \c count elements that can be written
+     * without copying. The written values become visible to the reader after
+     * calling commit().
+     *
+     * @param count The maximum number of elements to write.
+     * @returns The region that can be written, which is empty if the queue is
+     * full.
+     */
+    Region<T> acquire_write(size_t count) {
+      return base.acquire_write(count, data);
+    }
+
+    /**
+     * Publishes \c count elements that were written in a region obtained
+     * by acquire_write().
+     *
+     * @param count The number of elements to publish.
+     */
+    void commit(size_t count) { base.commit(count); }
+
     /**
      * Pushes \c value on the queue, which fails if the queue is full, and if
      * the queue is empty resets read and write counters.
@@ -308,6 +922,36 @@ struct LockFreeRingBuffer {
      * @returns \c true if shift was successful, \c false otherwise
      */
     bool read(T &value) { return base.read(value, data); }
+
+    /**
+     * Shifts at most \c count values off the queue into \c values, releasing
+     * them all at once.
+     * @param values Contains the shifted values on success.
+     * @param count The maximum number of values to shift.
+     * @returns The number of values that was actually shifted.
+     */
+    size_t read(T *values, size_t count) {
+      return base.read(values, count, data);
+    }
+
+    /**
+     * Returns the region of at most \c count elements that can be read
+     * without copying. The elements are released to the writer after calling
+     * consume().
+     * @param count The maximum number of elements to read.
+     * @returns The region that can be read, which is empty if the queue is
+     * empty.
+     */
+    Region<const T> acquire_read(size_t count) {
+      return base.acquire_read(count, data);
+    }
+
+    /**
+     * Releases \c count elements that were read in a region obtained by
+     * acquire_read().
+     * @param count The number of elements to release.
+     */
+    void consume(size_t count) { base.consume(count); }
   };
 
   /**
@@ -321,13 +965,19 @@ struct LockFreeRingBuffer {
    * size_t.
    *
    * @tparam T The type of values in the buffer.
-   * @tparam S The buffer capacity
+   * @tparam M The metric that determines the buffer capacity.
+   * @tparam Indices The policy that keeps the read and write index.
+   * @tparam Statistics The policy that keeps statistics, like
+   * CountingStatistics, or NoStatistics to keep none.
    */
-  template <typename T, class M> class Monotonic {
-    BaseMonotonic<T, M> base;
+  template <typename T, class M, class Indices = SharedIndices<>,
+            class Statistics = NoStatistics>
+  class Monotonic {
+    BaseMonotonic<T, M, Indices, Statistics> base;
     T *data;
 
   public:
+    using value_type = T;
     using Metric = M;
     Monotonic(const Metric &metric, T *data__) : base(metric), data(data__) {}
 
@@ -338,6 +988,12 @@ struct LockFreeRingBuffer {
     size_t read_ptr() const { return base.read_ptr(); }
     size_t write_ptr() const { return base.write_ptr(); }
 
+    /**
+     * Returns a snapshot of the statistics, that is empty if the buffer keeps
+     * no statistics. This can be called from any thread.
+     */
+    StatisticsSnapshot statistics() const { return base.statistics(); }
+
     /**
      * Pushes \c value on the queue, which fails if the queue is full.
      *
@@ -346,6 +1002,39 @@ struct LockFreeRingBuffer {
      */
     bool write(const T &value) { return base.write(value, data); }
 
+    /**
+     * Pushes as many of the \c count values in \c values on the queue as
+     * there is room for, publishing them all at once.
+     *
+     * @param values The values to push.
+     * @param count The number of values to push.
+     * @returns The number of values that was actually pushed.
+     */
+    size_t write(const T *values, size_t count) {
+      return base.write(values, count, data);
+    }
+
+    /**
+     * Returns the region of at most \c count elements that can be written
+     * without copying. The written values become visible to the reader after
+     * calling commit().
+     *
+     * @param count The maximum number of elements to write.
+     * @returns The region that can be written, which is empty if the queue is
+     * full.
+     */
+    Region<T> acquire_write(size_t count) {
+      return base.acquire_write(count, data);
+    }
+
+    /**
+     * Publishes \c count elements that were written in a region obtained
+     * by acquire_write().
+     *
+     * @param count The number of elements to publish.
+     */
+    void commit(size_t count) { base.commit(count); }
+
     /**
      * Pushes \c value on the queue, which fails if the queue is full, and if
      * the queue is empty resets read and write counters.
@@ -376,6 +1065,36 @@ struct LockFreeRingBuffer {
      * @returns \c true if shift was successful, \c false otherwise
      */
     bool read(T &value) { return base.read(value, data); }
+
+    /**
+     * Shifts at most \c count values off the queue into \c values, releasing
+     * them all at once.
+     * @param values Contains the shifted values on success.
+     * @param count The maximum number of values to shift.
+     * @returns The number of values that was actually shifted.
+     */
+    size_t read(T *values, size_t count) {
+      return base.read(values, count, data);
+    }
+
+    /**
+     * Returns the region of at most \c count elements that can be read
+     * without copying. The elements are released to the writer after calling
+     * consume().
+     * @param count The maximum number of elements to read.
+     * @returns The region that can be read, which is empty if the queue is
+     * empty.
+     */
+    Region<const T> acquire_read(size_t count) {
+      return base.acquire_read(count, data);
+    }
+
+    /**
+     * Releases \c count elements that were read in a region obtained by
+     * acquire_read().
+     * @param count The number of elements to release.
+     */
+    void consume(size_t count) { base.consume(count); }
   };
 };
 
@@ -385,6 +1104,15 @@ template <typename T>
 using RingBufferLockFree = LockFreeRingBuffer::Monotonic<
     T, ::org::simple::Circular::Metric<
            ::org::simple::WrappingType::BIT_MASK>>;
+template <typename T, size_t S>
+using RingBufferLockFreeFixedSizePadded =
+    LockFreeRingBuffer::MonotonicFixed<T, S,
+                                       LockFreeRingBuffer::PaddedIndices<>>;
+template <typename T>
+using RingBufferLockFreePadded = LockFreeRingBuffer::Monotonic<
+    T,
+    ::org::simple::Circular::Metric<::org::simple::WrappingType::BIT_MASK>,
+    LockFreeRingBuffer::PaddedIndices<>>;
 
 } // namespace org::simple
 
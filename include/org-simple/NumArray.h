@@ -21,9 +21,12 @@
  * limitations under the License.
  */
 
+#include <algorithm>
 #include <complex>
+#include <memory>
 #include <org-simple/AlignedData.h>
 #include <org-simple/Index.h>
+#include <org-simple/NumKernels.h>
 #include <type_traits>
 
 namespace org::simple {
@@ -33,6 +36,20 @@ template <typename T, size_t ELEMENTS, class S> struct BaseNumArray;
 template <typename T, size_t S, size_t A = alignof(T)>
 using NumArray = BaseNumArray<T, S, AlignedLocalStorage<T, S, A>>;
 
+template <typename T, size_t S, size_t A = alignof(T)>
+using NumArrayAllocated = BaseNumArray<T, S, AlignedAllocatedStorage<T, S, A>>;
+
+/**
+ * A NumArray that works in place on aligned memory that is owned elsewhere,
+ * like the buffer of an audio period.
+ */
+template <typename T, size_t S, size_t A = alignof(T)>
+using NumArrayReference = BaseNumArray<T, S, AlignedReferencedStorage<T, S, A>>;
+
+template <typename T, size_t S, size_t A = alignof(T)>
+using NumArrayConstReference =
+    BaseNumArray<T, S, AlignedConstReferencedStorage<T, S, A>>;
+
 namespace concepts {
 template <class T> struct is_complex {
   static constexpr bool value = false;
@@ -53,6 +70,191 @@ concept NumberIsR2LAssignable =
 
 } // namespace concepts
 
+/**
+ * Lazily evaluated NumArray arithmetic. An expression like
+ * <code>out = a.lazy() * g + b.lazy() * h</code> builds a tree of nodes that
+ * is evaluated element by element in a single loop when it is assigned to a
+ * NumArray, instead of materializing a temporary array for each operator and
+ * passing over memory once for each.
+ *
+ * Nodes hold their operands by value and arrays by pointer, so an expression
+ * must be assigned before the arrays it refers to change or go out of scope.
+ * As element \c i of the result only depends on element \c i of the operands,
+ * the destination may also be one of the operands.
+ */
+namespace num_expression {
+
+template <class E>
+concept Node = requires {
+  typename E::value_type;
+  E::elements;
+  E::isNumExpression;
+};
+
+/**
+ * Reads the elements of an aligned array.
+ */
+template <typename T, size_t ELEMENTS, size_t ALIGNMENT> class Leaf {
+  const T *data_;
+
+public:
+  typedef T value_type;
+  static constexpr size_t elements = ELEMENTS;
+
+  static constexpr bool isNumExpression = true;
+
+  explicit Leaf(const T *data) : data_(data) {}
+
+  T operator[](size_t i) const {
+    return std::assume_aligned<ALIGNMENT>(data_)[i];
+  }
+};
+
+/**
+ * Yields the same value for every element.
+ */
+template <typename T, size_t ELEMENTS> class Scalar {
+  T value_;
+
+public:
+  typedef T value_type;
+  static constexpr size_t elements = ELEMENTS;
+
+  static constexpr bool isNumExpression = true;
+
+  explicit Scalar(T value) : value_(value) {}
+
+  T operator[](size_t) const { return value_; }
+};
+
+struct Add {
+  template <typename T> static T apply(T a, T b) { return a + b; }
+};
+
+struct Subtract {
+  template <typename T> static T apply(T a, T b) { return a - b; }
+};
+
+struct Multiply {
+  template <typename T> static T apply(T a, T b) { return a * b; }
+};
+
+struct Divide {
+  template <typename T> static T apply(T a, T b) { return a / b; }
+};
+
+template <class Operation, class L, class R> class Binary {
+  static_assert(L::elements == R::elements);
+  static_assert(
+      std::is_same_v<typename L::value_type, typename R::value_type>);
+  L left_;
+  R right_;
+
+public:
+  typedef typename L::value_type value_type;
+  static constexpr size_t elements = L::elements;
+  static constexpr bool isNumExpression = true;
+
+  Binary(const L &left, const R &right) : left_(left), right_(right) {}
+
+  value_type operator[](size_t i) const {
+    return Operation::apply(left_[i], right_[i]);
+  }
+};
+
+template <class E> class Negate {
+  E expression_;
+
+public:
+  typedef typename E::value_type value_type;
+  static constexpr size_t elements = E::elements;
+  static constexpr bool isNumExpression = true;
+
+  explicit Negate(const E &expression) : expression_(expression) {}
+
+  value_type operator[](size_t i) const { return -expression_[i]; }
+};
+
+/**
+ * Returns whether \c X can be combined with node \c E: another node or an
+ * aligned array of the same type and size, or a scalar.
+ */
+template <class X, class E> static constexpr bool isOperandFor() {
+  if constexpr (Node<X>) {
+    return X::elements == E::elements &&
+           std::is_same_v<typename X::value_type, typename E::value_type>;
+  } else if constexpr (AlignedDataInfo::is<X>()) {
+    return AlignedDataInfo::get<X>().elements == E::elements &&
+           std::is_same_v<typename X::type, typename E::value_type>;
+  } else {
+    return std::is_convertible_v<X, typename E::value_type>;
+  }
+}
+
+template <class L, class R> static constexpr bool areOperands() {
+  if constexpr (Node<L>) {
+    return isOperandFor<R, L>();
+  } else if constexpr (Node<R>) {
+    return isOperandFor<L, R>();
+  } else {
+    return false;
+  }
+}
+
+template <class E, class X> static auto operand(const X &x) {
+  if constexpr (Node<X>) {
+    return x;
+  } else if constexpr (AlignedDataInfo::is<X>()) {
+    return Leaf<typename X::type, X::elements, X::alignment>(x.data());
+  } else {
+    return Scalar<typename E::value_type, E::elements>(x);
+  }
+}
+
+template <class Operation, class L, class R>
+static auto combine(const L &l, const R &r) {
+  using E = std::conditional_t<Node<L>, L, R>;
+  auto left = operand<E>(l);
+  auto right = operand<E>(r);
+  return Binary<Operation, decltype(left), decltype(right)>(left, right);
+}
+
+template <class L, class R>
+  requires(areOperands<L, R>())
+auto operator+(const L &l, const R &r) {
+  return combine<Add>(l, r);
+}
+
+template <class L, class R>
+  requires(areOperands<L, R>())
+auto operator-(const L &l, const R &r) {
+  return combine<Subtract>(l, r);
+}
+
+template <class L, class R>
+  requires(areOperands<L, R>())
+auto operator*(const L &l, const R &r) {
+  return combine<Multiply>(l, r);
+}
+
+template <class L, class R>
+  requires(areOperands<L, R>())
+auto operator/(const L &l, const R &r) {
+  return combine<Divide>(l, r);
+}
+
+template <class E>
+  requires Node<E>
+Negate<E> operator-(const E &e) {
+  return Negate<E>(e);
+}
+
+template <class E, typename T, size_t ELEMENTS>
+concept Evaluates = Node<E> && E::elements == ELEMENTS &&
+                    std::is_same_v<typename E::value_type, T>;
+
+} // namespace num_expression
+
 template <typename T, size_t ELEMENTS, class S> struct BaseNumArray : public S {
   static_assert(AlignedDataInfo::get<S>().isAlignedData);
   static_assert(concepts::is_complex_v<T> || std::is_arithmetic_v<T>);
@@ -63,7 +265,7 @@ template <typename T, size_t ELEMENTS, class S> struct BaseNumArray : public S {
   using ResultArray = NumArray<T, ELEMENTS, Super::alignment>;
 
   template <typename X> static constexpr bool is_type_compat_arrays() {
-    const auto info = AlignedDataInfo::get<S>();
+    constexpr auto info = AlignedDataInfo::get<X>();
     if constexpr (info.isAlignedData) {
       return std::is_same_v<typename X::type, T>;
     } else {
@@ -73,28 +275,28 @@ template <typename T, size_t ELEMENTS, class S> struct BaseNumArray : public S {
 
   template <typename X> static constexpr bool SameSizeArray() {
     return is_type_compat_arrays<X>() &&
-           AlignedDataInfo::get<S>().elements == ELEMENTS;
+           AlignedDataInfo::get<X>().elements == ELEMENTS;
   }
 
   template <typename X>
   static constexpr bool NotSmallerArray =
       is_type_compat_arrays<X>() &&
-      AlignedDataInfo::get<S>().elements >= ELEMENTS;
+      AlignedDataInfo::get<X>().elements >= ELEMENTS;
 
   template <typename X>
   static constexpr bool BiggerArray =
       is_type_compat_arrays<X>() &&
-      AlignedDataInfo::get<S>().elements > ELEMENTS;
+      AlignedDataInfo::get<X>().elements > ELEMENTS;
 
   template <typename X>
   static constexpr bool NotBiggerArray =
       is_type_compat_arrays<X>() &&
-      AlignedDataInfo::get<S>().elements <= ELEMENTS;
+      AlignedDataInfo::get<X>().elements <= ELEMENTS;
 
   template <typename X>
   static constexpr bool SmallerArray =
       is_type_compat_arrays<X>() &&
-      AlignedDataInfo::get<S>().elements < ELEMENTS;
+      AlignedDataInfo::get<X>().elements < ELEMENTS;
 
   template <size_t START, size_t SRC_ELEM>
   static constexpr bool ValidForGraftArray = (START + SRC_ELEM <= ELEMENTS);
@@ -104,16 +306,41 @@ template <typename T, size_t ELEMENTS, class S> struct BaseNumArray : public S {
       AlignedDataInfo::get<X>().elements == 3 && ELEMENTS == 3;
 
   BaseNumArray() = default;
-  BaseNumArray(const BaseNumArray &source) { assign(source); }
+  BaseNumArray(const BaseNumArray &source) = default;
   BaseNumArray(BaseNumArray &&) = default;
   template <class Array>
     requires(SameSizeArray<Array>())
   BaseNumArray(const Array &array) : S(array) {}
   BaseNumArray &operator=(const BaseNumArray &source) {
-    assign(source);
+    this->assign(source);
     return *this;
   }
 
+  /**
+   * Refers to the elements at \c pointer, if the storage is a reference.
+   */
+  template <typename P>
+    requires std::is_constructible_v<S, P *>
+  explicit BaseNumArray(P *pointer) : S(pointer) {}
+
+  /**
+   * Refers to the elements of \c owner from element \c offset, if the
+   * storage is a reference.
+   */
+  template <class Owner>
+    requires std::is_constructible_v<S, Owner &, size_t>
+  BaseNumArray(Owner &owner, size_t offset) : S(owner, offset) {}
+
+  /**
+   * Evaluates \c expression into a new array.
+   */
+  template <class E>
+    requires(num_expression::Evaluates<E, T, ELEMENTS> &&
+             std::is_default_constructible_v<S>)
+  BaseNumArray(const E &expression) {
+    evaluate(expression, [](T &element, T value) { element = value; });
+  }
+
   BaseNumArray(const std::initializer_list<T> &values) {
     size_t i = 0;
     auto data = this->begin();
@@ -135,6 +362,9 @@ template <typename T, size_t ELEMENTS, class S> struct BaseNumArray : public S {
     size_t i = 0;
     auto data = this->begin();
     for (auto v : values) {
+      if (i == ELEMENTS) {
+        return;
+      }
       data[i++] = v;
     }
     while (i < ELEMENTS) {
@@ -145,6 +375,14 @@ template <typename T, size_t ELEMENTS, class S> struct BaseNumArray : public S {
   typedef T value_type;
   static constexpr size_t elements = ELEMENTS;
 
+  /**
+   * Reductions of floating point and complex arrays of at least a cache line
+   * use NumKernels, as the compiler does not vectorize them by itself.
+   */
+  static constexpr bool use_kernels =
+      std::is_floating_point_v<typename concepts::is_complex<T>::real_type> &&
+      ELEMENTS * sizeof(T) >= Align::cacheLine;
+
   void zero() {
     auto data = this->begin();
     for (size_t i = 0; i < this->capacity(); i++) {
@@ -176,13 +414,88 @@ template <typename T, size_t ELEMENTS, class S> struct BaseNumArray : public S {
     return *this;
   }
 
-  void operator>>(T *destination) {
-    const T *dst = destination;
+  void operator>>(T *destination) const {
+    T *dst = destination;
+    auto data = this->begin();
     for (size_t i = 0; i < this->capacity(); i++) {
-      dst[i] += this->data_(i);
+      dst[i] += data[i];
     }
   }
 
+  // Lazy expressions
+
+  /**
+   * Returns an expression node that reads the elements of this array, to
+   * combine with other arrays and scalars in a single fused loop.
+   */
+  num_expression::Leaf<T, ELEMENTS, Super::alignment> lazy() const {
+    return num_expression::Leaf<T, ELEMENTS, Super::alignment>(this->data());
+  }
+
+  template <class E>
+    requires(num_expression::Evaluates<E, T, ELEMENTS>)
+  BaseNumArray &operator=(const E &expression) {
+    evaluate(expression, [](T &element, T value) { element = value; });
+    return *this;
+  }
+
+  template <class E>
+    requires(num_expression::Evaluates<E, T, ELEMENTS>)
+  BaseNumArray &operator+=(const E &expression) {
+    evaluate(expression, [](T &element, T value) { element += value; });
+    return *this;
+  }
+
+  template <class E>
+    requires(num_expression::Evaluates<E, T, ELEMENTS>)
+  BaseNumArray &operator-=(const E &expression) {
+    evaluate(expression, [](T &element, T value) { element -= value; });
+    return *this;
+  }
+
+  // Ranges
+
+  /**
+   * Returns the alignment of a range that starts at element \c START.
+   */
+  template <size_t START> static constexpr size_t range_alignment() {
+    constexpr size_t offset = START * sizeof(T);
+    return offset == 0 ? Super::alignment
+                       : std::max(alignof(T),
+                                  std::min(Super::alignment, offset & -offset));
+  }
+
+  /**
+   * Returns an array that refers to the elements \c START up to and including
+   * \c END of this array, to work on them in place.
+   */
+  template <size_t START, size_t END>
+    requires(START <= END && END < ELEMENTS)
+  auto range_ref() {
+    return NumArrayReference<T, END - START + 1, range_alignment<START>()>(
+        *this, START);
+  }
+
+  template <size_t START, size_t END>
+    requires(START <= END && END < ELEMENTS)
+  auto range_ref() const {
+    return NumArrayConstReference<T, END - START + 1,
+                                  range_alignment<START>()>(*this, START);
+  }
+
+  /**
+   * Returns a copy of the elements \c START up to and including \c END of
+   * this array.
+   */
+  template <size_t START, size_t END>
+    requires(START <= END && END < ELEMENTS)
+  NumArray<T, END - START + 1> range_copy() const {
+    NumArray<T, END - START + 1> r;
+    auto data = this->begin();
+    std::copy(data + START, data + END + 1, r.begin());
+    return r;
+  }
+
   // Negate
 
   ResultArray operator-() const {
@@ -216,7 +529,7 @@ template <typename T, size_t ELEMENTS, class S> struct BaseNumArray : public S {
   }
 
   template <class Array>
-    requires SameSizeArray<Array>
+    requires(SameSizeArray<Array>())
   ResultArray operator+(const Array &o) const {
     ResultArray r = *this;
     r += o;
@@ -224,7 +537,7 @@ template <typename T, size_t ELEMENTS, class S> struct BaseNumArray : public S {
   }
 
   template <class Array>
-    requires SameSizeArray<Array>
+    requires(SameSizeArray<Array>())
   friend BaseNumArray &operator+(const Array &o, BaseNumArray &&a) {
     a += o;
     return a;
@@ -233,7 +546,7 @@ template <typename T, size_t ELEMENTS, class S> struct BaseNumArray : public S {
   // Subtract an array
 
   template <class Array>
-    requires SameSizeArray<Array>
+    requires(SameSizeArray<Array>())
   BaseNumArray &operator-=(const Array &source) {
     T *__restrict data = this->begin();
     const T *__restrict o = source.begin();
@@ -244,7 +557,7 @@ template <typename T, size_t ELEMENTS, class S> struct BaseNumArray : public S {
   }
 
   template <class Array>
-    requires SameSizeArray<Array>
+    requires(SameSizeArray<Array>())
   ResultArray operator-(const Array &o) const {
     ResultArray r = *this;
     r -= o;
@@ -252,6 +565,7 @@ template <typename T, size_t ELEMENTS, class S> struct BaseNumArray : public S {
   }
 
   template <class Array>
+    requires(SameSizeArray<Array>())
   friend BaseNumArray &operator-(const Array &o, BaseNumArray &&a) {
     T *__restrict dst = a.begin();
     const T *const src = o.begin();
@@ -318,7 +632,7 @@ template <typename T, size_t ELEMENTS, class S> struct BaseNumArray : public S {
   // Dot product
 
   template <class Array>
-    requires SameSizeArray<Array>
+    requires(SameSizeArray<Array>())
   T dot(const Array &other) const {
     auto v1 = this->begin();
     auto v2 = other.begin();
@@ -327,6 +641,11 @@ template <typename T, size_t ELEMENTS, class S> struct BaseNumArray : public S {
     static constexpr bool v2Complex =
         concepts::is_complex<typename Array::type>::value;
 
+    if constexpr (use_kernels) {
+      static constexpr size_t alignment =
+          std::min(Super::alignment, AlignedDataInfo::get<Array>().alignment);
+      return NumKernels<T, alignment>::dot(v1, v2, ELEMENTS);
+    }
     if constexpr (v1Complex) {
       T sum = 0;
       for (size_t i = 0; i < ELEMENTS; i++) {
@@ -351,8 +670,10 @@ template <typename T, size_t ELEMENTS, class S> struct BaseNumArray : public S {
   // Squared absolute value (norm)
 
   typename concepts::is_complex<T>::real_type squared_absolute() const {
-    if constexpr (concepts::is_complex<T>::value) {
-      typename concepts::is_complex<T>::value_type sum = 0;
+    if constexpr (use_kernels) {
+      return NumKernels<T, Super::alignment>::norm(this->begin(), ELEMENTS);
+    } else if constexpr (concepts::is_complex<T>::value) {
+      typename concepts::is_complex<T>::real_type sum = 0;
       const T *p = this->begin();
       for (size_t i = 0; i < ELEMENTS; i++) {
         sum += std::norm(p[i]);
@@ -368,10 +689,26 @@ template <typename T, size_t ELEMENTS, class S> struct BaseNumArray : public S {
     }
   }
 
+  /**
+   * Returns the sum, the sum of squares, the minimum and the maximum of the
+   * elements, that are obtained in a single pass.
+   */
+  NumStatistics<T> statistics() const
+    requires std::is_floating_point_v<T>
+  {
+    if constexpr (use_kernels) {
+      return NumKernels<T, Super::alignment>::statistics(this->begin(),
+                                                         ELEMENTS);
+    } else {
+      return num_kernels::Kernel<num_kernels::Scalar, T, Super::alignment>::
+          statistics(this->begin(), ELEMENTS);
+    }
+  }
+
   template <typename Array>
     requires ValidForCrossProductArray<Array>
-  BaseNumArray cross_product(const Array &source) const {
-    BaseNumArray r;
+  ResultArray cross_product(const Array &source) const {
+    ResultArray r;
     auto data = this->begin();
     auto o = source.begin();
     r[0] = data[1] * o[2] - data[2] * o[1];
@@ -379,6 +716,44 @@ template <typename T, size_t ELEMENTS, class S> struct BaseNumArray : public S {
     r[2] = data[0] * o[1] - data[1] * o[0];
     return r;
   }
+
+private:
+  /**
+   * Evaluates a block of elements before storing any of them, like the eager
+   * operators do with their temporaries. The compiler then knows that the
+   * stores cannot change elements that are still to be read, even if the
+   * destination is one of the arrays in the expression, and vectorizes each
+   * block. Blocks of the size of a wide vector register keep the values in
+   * registers, where a single block of all elements makes the vectorizer give
+   * up on larger arrays.
+   */
+  template <class E, class Apply>
+  void evaluate(const E &expression, Apply apply) {
+    static constexpr size_t BLOCK =
+        std::clamp(EVALUATION_BLOCK_BYTES / sizeof(T), size_t(1), ELEMENTS);
+    static constexpr size_t TAIL = ELEMENTS % BLOCK;
+    size_t offset = 0;
+    for (; offset + BLOCK <= ELEMENTS; offset += BLOCK) {
+      evaluate_block<BLOCK>(expression, apply, offset);
+    }
+    if constexpr (TAIL != 0) {
+      evaluate_block<TAIL>(expression, apply, offset);
+    }
+  }
+
+  template <size_t COUNT, class E, class Apply>
+  void evaluate_block(const E &expression, Apply apply, size_t offset) {
+    T values[COUNT];
+    for (size_t i = 0; i < COUNT; i++) {
+      values[i] = expression[offset + i];
+    }
+    T *data = this->data() + offset;
+    for (size_t i = 0; i < COUNT; i++) {
+      apply(data[i], values[i]);
+    }
+  }
+
+  static constexpr size_t EVALUATION_BLOCK_BYTES = 32;
 };
 
 } // namespace org::simple
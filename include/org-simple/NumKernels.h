@@ -0,0 +1,694 @@
+#ifndef ORG_SIMPLE_M_NUM_KERNELS_H
+#define ORG_SIMPLE_M_NUM_KERNELS_H
+/*
+ * org-simple/NumKernels.h
+ *
+ * Added by michel on 2026-10-15
+ * Copyright (C) 2015-2026 Michel Fleur.
+ * Source https://github.com/emmef/org-simple
+ * Email org-simple@emmef.org
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <cstddef>
+#include <org-simple/Align.h>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#if defined(__GNUC__) && defined(__x86_64__)
+#define ORG_SIMPLE_NUM_KERNELS_X86 1
+#endif
+
+namespace org::simple {
+
+/**
+ * The instruction sets that NumKernels has kernels for.
+ * - \c SCALAR: plain loops, that the compiler may vectorize or not.
+ * - \c VECTOR128: 128-bit vectors that every target of a GCC compatible
+ *   compiler has, like SSE2 on x86-64 and NEON on AArch64.
+ * - \c AVX2: 256-bit vectors with fused multiply-add.
+ * - \c AVX512: 512-bit vectors with fused multiply-add.
+ */
+enum class SimdInstructions { SCALAR, VECTOR128, AVX2, AVX512 };
+
+/**
+ * Statistics of an array of real numbers that are obtained in a single pass,
+ * like a meter needs for its peak and RMS values.
+ */
+template <typename T> struct NumStatistics {
+  size_t count = 0;
+  T sum = 0;
+  T sum_of_squares = 0;
+  T minimum = 0;
+  T maximum = 0;
+
+  /**
+   * Returns the largest absolute value.
+   */
+  T peak() const { return std::max(-minimum, maximum); }
+  T mean() const { return count ? sum / T(count) : 0; }
+  T mean_square() const { return count ? sum_of_squares / T(count) : 0; }
+  T rms() const { return std::sqrt(mean_square()); }
+};
+
+namespace num_kernels {
+
+struct Scalar {
+  static constexpr size_t WIDTH = 0;
+  static constexpr bool FUSED = false;
+};
+
+struct Vector128 {
+  static constexpr size_t WIDTH = 16;
+  static constexpr bool FUSED = false;
+};
+
+struct Avx2 {
+  static constexpr size_t WIDTH = 32;
+  static constexpr bool FUSED = true;
+};
+
+struct Avx512 {
+  static constexpr size_t WIDTH = 64;
+  static constexpr bool FUSED = true;
+};
+
+/**
+ * A vector of \c WIDTH bytes of elements of type \c T, that is loaded and
+ * stored with aligned instructions only if \c ALIGNMENT is at least \c WIDTH.
+ * Like the types of intrinsics, it may alias its elements.
+ */
+template <typename T, size_t WIDTH, size_t ALIGNMENT> struct Vector;
+
+#if defined(__GNUC__)
+template <typename T, size_t WIDTH, size_t ALIGNMENT> struct Vector {
+  typedef T type
+      __attribute__((vector_size(WIDTH), aligned(std::min(WIDTH, ALIGNMENT)),
+                     __may_alias__));
+};
+#endif
+
+static inline bool isSupported(SimdInstructions instructions) {
+  switch (instructions) {
+  case SimdInstructions::SCALAR:
+    return true;
+  case SimdInstructions::VECTOR128:
+#if defined(__GNUC__)
+    return true;
+#else
+    return false;
+#endif
+  case SimdInstructions::AVX2:
+#if defined(ORG_SIMPLE_NUM_KERNELS_X86)
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+#else
+    return false;
+#endif
+  case SimdInstructions::AVX512:
+#if defined(ORG_SIMPLE_NUM_KERNELS_X86)
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx512f") &&
+           __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+#else
+    return false;
+#endif
+  }
+  return false;
+}
+
+/**
+ * Returns the widest instruction set that this CPU supports.
+ */
+static inline SimdInstructions best() {
+  for (auto instructions : {SimdInstructions::AVX512, SimdInstructions::AVX2,
+                            SimdInstructions::VECTOR128}) {
+    if (isSupported(instructions)) {
+      return instructions;
+    }
+  }
+  return SimdInstructions::SCALAR;
+}
+
+static constexpr const char *name(SimdInstructions instructions) {
+  switch (instructions) {
+  case SimdInstructions::SCALAR:
+    return "scalar";
+  case SimdInstructions::VECTOR128:
+    return "128-bit";
+  case SimdInstructions::AVX2:
+    return "AVX2";
+  case SimdInstructions::AVX512:
+    return "AVX-512";
+  }
+  return "unknown";
+}
+
+/**
+ * A sum that keeps track of the rounding error of each addition (Neumaier's
+ * variant of Kahan summation), so that its value is accurate regardless of
+ * the number of terms.
+ */
+template <typename T> struct CompensatedSum {
+  T sum = 0;
+  T compensation = 0;
+
+  void add(T value) {
+    T t = sum + value;
+    if (std::abs(sum) >= std::abs(value)) {
+      compensation += (sum - t) + value;
+    } else {
+      compensation += (value - t) + sum;
+    }
+    sum = t;
+  }
+
+  T value() const { return sum + compensation; }
+};
+
+/**
+ * Kernels on arrays of real numbers, written once for vectors of the width of
+ * instruction set \c Isa. Each kernel has a vector loop and a scalar loop for
+ * the remaining elements. The destination may be one of the sources, but may
+ * not partially overlap with it.
+ */
+template <class Isa, typename T, size_t ALIGNMENT> struct Kernel {
+  static_assert(std::is_floating_point_v<T>);
+  using Alignment = AlignedType<T, ALIGNMENT>;
+  static constexpr size_t LANES = Isa::WIDTH ? Isa::WIDTH / sizeof(T) : 1;
+  using V = typename std::conditional_t<
+      (LANES > 1), Vector<T, Isa::WIDTH, Alignment::alignment>,
+      std::type_identity<T>>::type;
+
+  // Vectors are only passed by reference, as passing wide vectors by value
+  // from a function without the instruction set changes the ABI.
+  static const V &load(const T *p) { return *reinterpret_cast<const V *>(p); }
+  static V &store(T *p) { return *reinterpret_cast<V *>(p); }
+
+  template <class Function>
+  static void elementwise(T *destination, const T *a, const T *b, size_t count,
+                          Function function) {
+    size_t i = 0;
+    if constexpr (LANES > 1) {
+      for (; i + LANES <= count; i += LANES) {
+        function(store(destination + i), load(a + i), load(b + i));
+      }
+    }
+    for (; i < count; i++) {
+      function(destination[i], a[i], b[i]);
+    }
+  }
+
+  static void add(T *destination, const T *a, const T *b, size_t count) {
+    elementwise(destination, a, b, count,
+                [](auto &r, const auto &x, const auto &y) { r = x + y; });
+  }
+
+  static void multiply(T *destination, const T *a, const T *b, size_t count) {
+    elementwise(destination, a, b, count,
+                [](auto &r, const auto &x, const auto &y) { r = x * y; });
+  }
+
+  static void minimum(T *destination, const T *a, const T *b, size_t count) {
+    elementwise(destination, a, b, count,
+                [](auto &r, const auto &x, const auto &y) {
+                  r = y < x ? y : x;
+                });
+  }
+
+  static void maximum(T *destination, const T *a, const T *b, size_t count) {
+    elementwise(destination, a, b, count,
+                [](auto &r, const auto &x, const auto &y) {
+                  r = x < y ? y : x;
+                });
+  }
+
+  /**
+   * Sets \c destination to <code>a * b + c</code>, with a single rounding if
+   * the instruction set has fused multiply-add.
+   */
+  static void fma(T *destination, const T *a, const T *b, const T *c,
+                  size_t count) {
+    size_t i = 0;
+    if constexpr (LANES > 1) {
+      for (; i + LANES <= count; i += LANES) {
+        V x = load(a + i);
+        V y = load(b + i);
+        V z = load(c + i);
+        if constexpr (Isa::FUSED) {
+          for (size_t lane = 0; lane < LANES; lane++) {
+            z[lane] = std::fma(x[lane], y[lane], z[lane]);
+          }
+          store(destination + i) = z;
+        } else {
+          store(destination + i) = x * y + z;
+        }
+      }
+    }
+    for (; i < count; i++) {
+      if constexpr (Isa::FUSED) {
+        destination[i] = std::fma(a[i], b[i], c[i]);
+      } else {
+        destination[i] = a[i] * b[i] + c[i];
+      }
+    }
+  }
+
+  /**
+   * Returns the sum of the lanes of \c v.
+   */
+  static T lanesSum(const V &v) {
+    if constexpr (LANES == 1) {
+      return v;
+    } else {
+      T sum = 0;
+      for (size_t lane = 0; lane < LANES; lane++) {
+        sum += v[lane];
+      }
+      return sum;
+    }
+  }
+
+  static T lanesMinimum(const V &v) {
+    if constexpr (LANES == 1) {
+      return v;
+    } else {
+      T minimum = v[0];
+      for (size_t lane = 1; lane < LANES; lane++) {
+        minimum = std::min(minimum, v[lane]);
+      }
+      return minimum;
+    }
+  }
+
+  static T lanesMaximum(const V &v) {
+    if constexpr (LANES == 1) {
+      return v;
+    } else {
+      T maximum = v[0];
+      for (size_t lane = 1; lane < LANES; lane++) {
+        maximum = std::max(maximum, v[lane]);
+      }
+      return maximum;
+    }
+  }
+
+  /**
+   * Returns the sum of the products of the elements of \c a and \c b. Vector
+   * instruction sets keep a sum per lane in two accumulators, so the order of
+   * summation, and hence the rounding, differs from a plain loop.
+   */
+  static T dot(const T *a, const T *b, size_t count) {
+    T result = 0;
+    size_t i = 0;
+    if constexpr (LANES > 1) {
+      V sum1 = {};
+      V sum2 = {};
+      for (; i + 2 * LANES <= count; i += 2 * LANES) {
+        sum1 += load(a + i) * load(b + i);
+        sum2 += load(a + i + LANES) * load(b + i + LANES);
+      }
+      for (; i + LANES <= count; i += LANES) {
+        sum1 += load(a + i) * load(b + i);
+      }
+      sum1 += sum2;
+      result = lanesSum(sum1);
+    }
+    for (; i < count; i++) {
+      result += a[i] * b[i];
+    }
+    return result;
+  }
+
+  static T norm(const T *a, size_t count) { return dot(a, a, count); }
+
+  /**
+   * Returns the statistics of \c a in a single pass. Two accumulators per
+   * statistic break the dependency chains. They add up blocks of at most \c
+   * BLOCK elements, whose sums are added to compensated totals. That cascade
+   * keeps the error independent of the number of elements.
+   */
+  static NumStatistics<T> statistics(const T *a, size_t count) {
+    static constexpr size_t STEP = 2 * LANES;
+    static constexpr size_t BLOCK = std::max(size_t(256), STEP) / STEP * STEP;
+    NumStatistics<T> result;
+    result.count = count;
+    if (count == 0) {
+      return result;
+    }
+    CompensatedSum<T> total;
+    CompensatedSum<T> totalSquares;
+    T lowest = a[0];
+    T highest = a[0];
+    size_t i = 0;
+    if (count >= STEP) {
+      V minimums = load(a);
+      V maximums = minimums;
+      while (i + STEP <= count) {
+        size_t end = i + std::min(BLOCK, (count - i) / STEP * STEP);
+        V sum1 = {};
+        V sum2 = {};
+        V squares1 = {};
+        V squares2 = {};
+        for (; i < end; i += STEP) {
+          const V &x = load(a + i);
+          const V &y = load(a + i + LANES);
+          sum1 += x;
+          sum2 += y;
+          squares1 += x * x;
+          squares2 += y * y;
+          minimums = x < minimums ? x : minimums;
+          maximums = maximums < x ? x : maximums;
+          minimums = y < minimums ? y : minimums;
+          maximums = maximums < y ? y : maximums;
+        }
+        sum1 += sum2;
+        squares1 += squares2;
+        total.add(lanesSum(sum1));
+        totalSquares.add(lanesSum(squares1));
+      }
+      lowest = lanesMinimum(minimums);
+      highest = lanesMaximum(maximums);
+    }
+    // Less than a step remains, so the tail is like one more small block
+    T tail = 0;
+    T tailSquares = 0;
+    for (; i < count; i++) {
+      T x = a[i];
+      tail += x;
+      tailSquares += x * x;
+      lowest = std::min(lowest, x);
+      highest = std::max(highest, x);
+    }
+    total.add(tail);
+    totalSquares.add(tailSquares);
+    result.sum = total.value();
+    result.sum_of_squares = totalSquares.value();
+    result.minimum = lowest;
+    result.maximum = highest;
+    return result;
+  }
+};
+
+/**
+ * Kernels on arrays of complex numbers, that are stored as pairs of real and
+ * imaginary parts. Addition and the norm use the real kernels on the parts.
+ */
+template <class Isa, typename T, size_t ALIGNMENT> struct ComplexKernel {
+  using Real = Kernel<Isa, T, ALIGNMENT>;
+  using C = std::complex<T>;
+  using V = typename Real::V;
+  static constexpr size_t LANES = Real::LANES;
+
+  template <size_t... I>
+  static void evens(V &result, const V &v, std::index_sequence<I...>) {
+    result = __builtin_shufflevector(v, v, (I & ~size_t(1))...);
+  }
+  template <size_t... I>
+  static void odds(V &result, const V &v, std::index_sequence<I...>) {
+    result = __builtin_shufflevector(v, v, (I | 1)...);
+  }
+  template <size_t... I>
+  static void swapped(V &result, const V &v, std::index_sequence<I...>) {
+    result = __builtin_shufflevector(v, v, (I ^ 1)...);
+  }
+  /**
+   * Sets \c value in even lanes and minus \c value in odd lanes.
+   */
+  static void alternating(V &result, T value) {
+    for (size_t lane = 0; lane < LANES; lane++) {
+      result[lane] = lane % 2 ? -value : value;
+    }
+  }
+
+  static const T *parts(const C *c) { return reinterpret_cast<const T *>(c); }
+  static T *parts(C *c) { return reinterpret_cast<T *>(c); }
+
+  static void add(C *destination, const C *a, const C *b, size_t count) {
+    Real::add(parts(destination), parts(a), parts(b), 2 * count);
+  }
+
+  /**
+   * Multiplies without the checks for infinities and not-a-number that make
+   * the multiplication of std::complex slow and hard to vectorize.
+   */
+  static void multiply(C *destination, const C *a, const C *b, size_t count) {
+    const T *x = parts(a);
+    const T *y = parts(b);
+    T *result = parts(destination);
+    size_t i = 0;
+    if constexpr (LANES > 1) {
+      static constexpr auto lanes = std::make_index_sequence<LANES>();
+      V signs;
+      alternating(signs, -1);
+      for (; i + LANES <= 2 * count; i += LANES) {
+        const V &u = Real::load(x + i);
+        const V &v = Real::load(y + i);
+        V reals;
+        V imaginaries;
+        V crossed;
+        evens(reals, u, lanes);
+        odds(imaginaries, u, lanes);
+        swapped(crossed, v, lanes);
+        Real::store(result + i) = reals * v + imaginaries * crossed * signs;
+      }
+    }
+    for (; i < 2 * count; i += 2) {
+      T real = x[i] * y[i] - x[i + 1] * y[i + 1];
+      T imaginary = x[i] * y[i + 1] + x[i + 1] * y[i];
+      result[i] = real;
+      result[i + 1] = imaginary;
+    }
+  }
+
+  /**
+   * Returns the sum of the conjugates of \c a times \c b, like
+   * BaseNumArray::dot.
+   */
+  static C dot(const C *a, const C *b, size_t count) {
+    const T *x = parts(a);
+    const T *y = parts(b);
+    T real = 0;
+    T imaginary = 0;
+    size_t i = 0;
+    if constexpr (LANES > 1) {
+      static constexpr auto lanes = std::make_index_sequence<LANES>();
+      V reals = {};
+      V imaginaries = {};
+      for (; i + LANES <= 2 * count; i += LANES) {
+        const V &u = Real::load(x + i);
+        const V &v = Real::load(y + i);
+        V crossed;
+        swapped(crossed, v, lanes);
+        reals += u * v;
+        imaginaries += u * crossed;
+      }
+      V signs;
+      alternating(signs, 1);
+      imaginaries *= signs;
+      real = Real::lanesSum(reals);
+      imaginary = Real::lanesSum(imaginaries);
+    }
+    for (; i < 2 * count; i += 2) {
+      real += x[i] * y[i] + x[i + 1] * y[i + 1];
+      imaginary += x[i] * y[i + 1] - x[i + 1] * y[i];
+    }
+    return {real, imaginary};
+  }
+
+  static T norm(const C *a, size_t count) {
+    return Real::norm(parts(a), 2 * count);
+  }
+};
+
+/**
+ * Provides kernel \c KERNEL as compiled for instruction set \c Isa. The
+ * kernels themselves have no target, so the entry points for wider
+ * instruction sets flatten them into a function that has one.
+ */
+template <class Isa, auto KERNEL> struct Entry {
+  static constexpr auto call = KERNEL;
+};
+
+#if defined(ORG_SIMPLE_NUM_KERNELS_X86)
+template <typename R, typename... A, R (*KERNEL)(A...)>
+struct Entry<Avx2, KERNEL> {
+  [[gnu::target("avx2,fma"), gnu::flatten]] static R call(A... arguments) {
+    return KERNEL(arguments...);
+  }
+};
+
+template <typename R, typename... A, R (*KERNEL)(A...)>
+struct Entry<Avx512, KERNEL> {
+  [[gnu::target("avx512f,avx2,fma"), gnu::flatten]] static R
+  call(A... arguments) {
+    return KERNEL(arguments...);
+  }
+};
+#endif
+
+template <class Table>
+static const Table &select(SimdInstructions instructions) {
+  if (!isSupported(instructions)) {
+    throw std::invalid_argument(
+        "NumKernels: instruction set not supported on this CPU");
+  }
+  switch (instructions) {
+#if defined(ORG_SIMPLE_NUM_KERNELS_X86)
+  case SimdInstructions::AVX512:
+    return Table::template table<Avx512>();
+  case SimdInstructions::AVX2:
+    return Table::template table<Avx2>();
+#endif
+#if defined(__GNUC__)
+  case SimdInstructions::VECTOR128:
+    return Table::template table<Vector128>();
+#endif
+  default:
+    return Table::template table<Scalar>();
+  }
+}
+
+} // namespace num_kernels
+
+/**
+ * Explicitly vectorized kernels for arrays of \c T, which is \c float, \c
+ * double or a std::complex of those, that are aligned to \c ALIGNMENT bytes.
+ * They do not rely on the auto-vectorizer, that cannot reorder floating point
+ * sums without -ffast-math and that gives up on the multiplication of complex
+ * numbers.
+ *
+ * The kernels are compiled for each instruction set in NumKernels.h and the
+ * widest one that the CPU supports is selected on first use, so that a single
+ * binary uses AVX-512 where it can and still runs on a CPU without it. The
+ * loads are aligned if \c ALIGNMENT is at least the width of the vectors.
+ *
+ * The functions of another instruction set can be obtained with functions(),
+ * for instance to compare them.
+ */
+template <typename T, size_t ALIGNMENT = alignof(T)> class NumKernels {
+public:
+  struct Functions {
+    void (*add)(T *, const T *, const T *, size_t);
+    void (*multiply)(T *, const T *, const T *, size_t);
+    void (*fma)(T *, const T *, const T *, const T *, size_t);
+    void (*minimum)(T *, const T *, const T *, size_t);
+    void (*maximum)(T *, const T *, const T *, size_t);
+    T (*dot)(const T *, const T *, size_t);
+    T (*norm)(const T *, size_t);
+    NumStatistics<T> (*statistics)(const T *, size_t);
+
+    template <class Isa> static const Functions &table() {
+      using K = num_kernels::Kernel<Isa, T, ALIGNMENT>;
+      static constexpr Functions functions = {
+          num_kernels::Entry<Isa, &K::add>::call,
+          num_kernels::Entry<Isa, &K::multiply>::call,
+          num_kernels::Entry<Isa, &K::fma>::call,
+          num_kernels::Entry<Isa, &K::minimum>::call,
+          num_kernels::Entry<Isa, &K::maximum>::call,
+          num_kernels::Entry<Isa, &K::dot>::call,
+          num_kernels::Entry<Isa, &K::norm>::call,
+          num_kernels::Entry<Isa, &K::statistics>::call};
+      return functions;
+    }
+  };
+
+  /**
+   * Returns the kernels for \c instructions.
+   * @throws std::invalid_argument if the CPU does not support \c instructions.
+   */
+  static const Functions &functions(SimdInstructions instructions) {
+    return num_kernels::select<Functions>(instructions);
+  }
+
+  static const Functions &functions() {
+    static const Functions &best = functions(num_kernels::best());
+    return best;
+  }
+
+  static void add(T *destination, const T *a, const T *b, size_t count) {
+    functions().add(destination, a, b, count);
+  }
+  static void multiply(T *destination, const T *a, const T *b, size_t count) {
+    functions().multiply(destination, a, b, count);
+  }
+  static void fma(T *destination, const T *a, const T *b, const T *c,
+                  size_t count) {
+    functions().fma(destination, a, b, c, count);
+  }
+  static void minimum(T *destination, const T *a, const T *b, size_t count) {
+    functions().minimum(destination, a, b, count);
+  }
+  static void maximum(T *destination, const T *a, const T *b, size_t count) {
+    functions().maximum(destination, a, b, count);
+  }
+  static T dot(const T *a, const T *b, size_t count) {
+    return functions().dot(a, b, count);
+  }
+  static T norm(const T *a, size_t count) { return functions().norm(a, count); }
+  static NumStatistics<T> statistics(const T *a, size_t count) {
+    return functions().statistics(a, count);
+  }
+};
+
+template <typename T, size_t ALIGNMENT>
+class NumKernels<std::complex<T>, ALIGNMENT> {
+  using C = std::complex<T>;
+
+public:
+  struct Functions {
+    void (*add)(C *, const C *, const C *, size_t);
+    void (*multiply)(C *, const C *, const C *, size_t);
+    C (*dot)(const C *, const C *, size_t);
+    T (*norm)(const C *, size_t);
+
+    template <class Isa> static const Functions &table() {
+      using K = num_kernels::ComplexKernel<Isa, T, ALIGNMENT>;
+      static constexpr Functions functions = {
+          num_kernels::Entry<Isa, &K::add>::call,
+          num_kernels::Entry<Isa, &K::multiply>::call,
+          num_kernels::Entry<Isa, &K::dot>::call,
+          num_kernels::Entry<Isa, &K::norm>::call};
+      return functions;
+    }
+  };
+
+  static const Functions &functions(SimdInstructions instructions) {
+    return num_kernels::select<Functions>(instructions);
+  }
+
+  static const Functions &functions() {
+    static const Functions &best = functions(num_kernels::best());
+    return best;
+  }
+
+  static void add(C *destination, const C *a, const C *b, size_t count) {
+    functions().add(destination, a, b, count);
+  }
+  static void multiply(C *destination, const C *a, const C *b, size_t count) {
+    functions().multiply(destination, a, b, count);
+  }
+  static C dot(const C *a, const C *b, size_t count) {
+    return functions().dot(a, b, count);
+  }
+  static T norm(const C *a, size_t count) { return functions().norm(a, count); }
+};
+
+} // namespace org::simple
+
+#endif // ORG_SIMPLE_M_NUM_KERNELS_H
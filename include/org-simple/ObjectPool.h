@@ -0,0 +1,251 @@
+#ifndef ORG_SIMPLE_M_OBJECT_POOL_H
+#define ORG_SIMPLE_M_OBJECT_POOL_H
+/*
+ * org-simple/ObjectPool.h
+ *
+ * Added by michel on 2026-10-15
+ * Copyright (C) 2015-2026 Michel Fleur.
+ * Source https://github.com/emmef/org-simple
+ * Email org-simple@emmef.org
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <new>
+#include <org-simple/AlignedAllocator.h>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace org::simple {
+
+/**
+ * A pool of a fixed number of objects of type \c T, that can be created and
+ * destroyed from multiple threads without locks and without the system
+ * allocator, so that a real-time thread can use it.
+ *
+ * The objects live in cache-line aligned slots that are allocated with
+ * AlignedAllocator when the pool is constructed. Free slots form a linked list
+ * of indices. The head of that list is a single 64-bit word with the index of
+ * the first free slot and a generation that changes on every update, so that
+ * a compare-and-swap fails if the head was taken and returned in the
+ * meantime (the ABA problem).
+ *
+ * Threads that create and destroy many objects should use a Magazine: a small
+ * cache of free slots owned by one thread, that only goes to the shared list
+ * to take or return half of its slots at a time.
+ *
+ * All objects must be destroyed before the pool is.
+ *
+ * @tparam T The type of objects.
+ * @tparam MAGAZINE The number of slots that a Magazine can hold.
+ */
+template <typename T, size_t MAGAZINE = 32> class ObjectPool {
+  static_assert(MAGAZINE >= 2);
+  static constexpr uint32_t NONE = std::numeric_limits<uint32_t>::max();
+
+  struct alignas(Align::cacheLine) Slot {
+    alignas(T) unsigned char storage[sizeof(T)];
+    std::atomic<uint32_t> next;
+  };
+
+  std::vector<Slot, AlignedAllocator<Slot, alignof(Slot)>> slots_;
+  alignas(Align::cacheLine) std::atomic<uint64_t> head_;
+
+  static uint32_t index_of(uint64_t head) {
+    return static_cast<uint32_t>(head);
+  }
+
+  static uint64_t tagged(uint32_t index, uint64_t previous) {
+    return (((previous >> 32) + 1) << 32) | index;
+  }
+
+  static size_t valid_capacity(size_t capacity) {
+    if (capacity == 0 || capacity >= NONE) {
+      throw std::invalid_argument(
+          "org::simple::ObjectPool: capacity must be positive and less than "
+          "2^32 - 1.");
+    }
+    return capacity;
+  }
+
+  uint32_t slot_of(const T *object) const {
+    auto offset = reinterpret_cast<const unsigned char *>(object) -
+                  reinterpret_cast<const unsigned char *>(slots_.data());
+    return static_cast<uint32_t>(static_cast<size_t>(offset) / sizeof(Slot));
+  }
+
+  /*
+   * Takes a chain of at most \c count slots from the free list with a single
+   * compare-and-swap and writes their indices to \c indices.
+   * @returns The number of slots taken.
+   */
+  size_t pop(uint32_t *indices, size_t count) {
+    uint64_t head = head_.load(std::memory_order_acquire);
+    while (true) {
+      size_t taken = 0;
+      uint32_t next = index_of(head);
+      // If another thread took slots of this chain in the meantime, the links
+      // can be anything, but then the generation changed and the exchange
+      // fails.
+      while (taken < count && next != NONE) {
+        indices[taken++] = next;
+        next = slots_[next].next.load(std::memory_order_relaxed);
+      }
+      if (taken == 0) {
+        return 0;
+      }
+      if (head_.compare_exchange_weak(head, tagged(next, head),
+                                      std::memory_order_acquire,
+                                      std::memory_order_acquire)) {
+        return taken;
+      }
+    }
+  }
+
+  /*
+   * Returns the chain of slots from \c first to \c last, that are already
+   * linked, to the free list.
+   */
+  void push(uint32_t first, uint32_t last) {
+    uint64_t head = head_.load(std::memory_order_relaxed);
+    do {
+      slots_[last].next.store(index_of(head), std::memory_order_relaxed);
+    } while (!head_.compare_exchange_weak(head, tagged(first, head),
+                                          std::memory_order_release,
+                                          std::memory_order_relaxed));
+  }
+
+  template <typename... Args> T *construct(uint32_t index, Args &&...args) {
+    try {
+      return new (slots_[index].storage) T(std::forward<Args>(args)...);
+    } catch (...) {
+      push(index, index);
+      throw;
+    }
+  }
+
+public:
+  /**
+   * Creates a pool for \c capacity objects.
+   * @throws std::invalid_argument if capacity is zero or too large to index.
+   */
+  explicit ObjectPool(size_t capacity) : slots_(valid_capacity(capacity)) {
+    for (size_t i = 0; i < capacity; i++) {
+      slots_[i].next.store(i + 1 < capacity ? i + 1 : NONE,
+                           std::memory_order_relaxed);
+    }
+    head_.store(0, std::memory_order_release);
+  }
+
+  ObjectPool(const ObjectPool &) = delete;
+  ObjectPool &operator=(const ObjectPool &) = delete;
+
+  size_t capacity() const { return slots_.size(); }
+
+  /**
+   * Creates an object in a free slot with \c args. This is safe to call from
+   * multiple threads concurrently.
+   * @returns The object or \c nullptr if the pool is exhausted.
+   */
+  template <typename... Args> T *create(Args &&...args) {
+    uint32_t index;
+    return pop(&index, 1) ? construct(index, std::forward<Args>(args)...)
+                          : nullptr;
+  }
+
+  /**
+   * Destroys \c object, that must have been created by this pool, and returns
+   * its slot. This is safe to call from multiple threads concurrently.
+   */
+  void destroy(T *object) {
+    object->~T();
+    uint32_t index = slot_of(object);
+    push(index, index);
+  }
+
+  /**
+   * A cache of free slots that is owned by a single thread, to take and
+   * return slots without touching the shared list most of the time. Slots in
+   * the cache are returned to the pool when the magazine is destroyed.
+   */
+  class Magazine {
+    ObjectPool &pool_;
+    uint32_t cached_[MAGAZINE];
+    size_t count_ = 0;
+
+    void refill() {
+      if (count_ < MAGAZINE / 2) {
+        count_ += pool_.pop(cached_ + count_, MAGAZINE / 2 - count_);
+      }
+    }
+
+    void flush(size_t keep) {
+      if (count_ <= keep) {
+        return;
+      }
+      for (size_t i = keep; i + 1 < count_; i++) {
+        pool_.slots_[cached_[i]].next.store(cached_[i + 1],
+                                            std::memory_order_relaxed);
+      }
+      pool_.push(cached_[keep], cached_[count_ - 1]);
+      count_ = keep;
+    }
+
+  public:
+    explicit Magazine(ObjectPool &pool) : pool_(pool) {}
+    Magazine(const Magazine &) = delete;
+    Magazine &operator=(const Magazine &) = delete;
+    ~Magazine() { flush(0); }
+
+    /**
+     * Returns the number of free slots in this magazine.
+     */
+    size_t cached() const { return count_; }
+
+    /**
+     * Creates an object in a free slot with \c args, taking slots from the
+     * pool if the magazine is empty.
+     * @returns The object or \c nullptr if the pool is exhausted.
+     */
+    template <typename... Args> T *create(Args &&...args) {
+      if (count_ == 0) {
+        refill();
+        if (count_ == 0) {
+          return nullptr;
+        }
+      }
+      return pool_.construct(cached_[--count_], std::forward<Args>(args)...);
+    }
+
+    /**
+     * Destroys \c object, that must have been created by the same pool, and
+     * keeps its slot, returning half of the slots to the pool if the magazine
+     * is full.
+     */
+    void destroy(T *object) {
+      object->~T();
+      if (count_ == MAGAZINE) {
+        flush(MAGAZINE / 2);
+      }
+      cached_[count_++] = pool_.slot_of(object);
+    }
+  };
+};
+
+} // namespace org::simple
+
+#endif // ORG_SIMPLE_M_OBJECT_POOL_H
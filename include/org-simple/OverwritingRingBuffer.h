@@ -0,0 +1,196 @@
+#ifndef ORG_SIMPLE_M_OVERWRITING_RING_BUFFER_H
+#define ORG_SIMPLE_M_OVERWRITING_RING_BUFFER_H
+/*
+ * org-simple/OverwritingRingBuffer.h
+ *
+ * Added by michel on 2026-10-15
+ * Copyright (C) 2015-2026 Michel Fleur.
+ * Source https://github.com/emmef/org-simple
+ * Email org-simple@emmef.org
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <org-simple/Align.h>
+#include <org-simple/Circular.h>
+
+namespace org::simple {
+
+/**
+ * A ring buffer for a single producer that never blocks and never fails: when
+ * the buffer is full, the oldest values are overwritten. This suits metering
+ * and logging, where the newest window of values is more important than
+ * values that a stalled reader did not get to.
+ *
+ * Writing is wait-free. Before the producer overwrites a slot, it publishes
+ * the position it claims, so that readers can detect afterwards whether the
+ * values they copied were overwritten while they copied them. Readers only
+ * read the shared state, so any number of readers can follow the buffer, each
+ * with its own Reader cursor, and they never delay the producer.
+ *
+ * The values are kept in relaxed atomics, so that a reader that races with the
+ * producer has no undefined behavior. For the intended sample types this
+ * compiles to plain loads and stores.
+ *
+ * @tparam T The type of values, that must be lock-free as an atomic.
+ * @tparam S The capacity, that is rounded up to a power of two.
+ */
+template <typename T, size_t S> class OverwritingRingBuffer {
+  static_assert(std::atomic<T>::is_always_lock_free);
+  using Metric = ::org::simple::Circular::FixedMetric<
+      ::org::simple::WrappingType::BIT_MASK, S>;
+
+  std::atomic<T> data[Metric::elements()];
+  alignas(Align::cacheLine) std::atomic_size_t claimed_at = 0;
+  std::atomic_size_t write_at = 0;
+
+  void claim(size_t position) {
+    claimed_at.store(position, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+  }
+
+public:
+  static constexpr size_t capacity() { return Metric::elements(); }
+
+  /**
+   * Returns the total number of values written.
+   */
+  size_t write_ptr() const { return write_at.load(std::memory_order_acquire); }
+
+  /**
+   * Writes \c value, overwriting the oldest value if the buffer is full. This
+   * must only be called by the single producer thread.
+   * @param value The value to write.
+   */
+  void write(const T &value) {
+    size_t wr = write_at.load(std::memory_order_relaxed);
+    claim(wr + 1);
+    data[Metric::wrapped(wr)].store(value, std::memory_order_relaxed);
+    write_at.store(wr + 1, std::memory_order_release);
+  }
+
+  /**
+   * Writes \c count values, overwriting the oldest values if the buffer gets
+   * full. If \c count exceeds the capacity, only the last capacity() values
+   * are actually stored. This must only be called by the single producer
+   * thread.
+   * @param values The values to write.
+   * @param count The number of values to write.
+   */
+  void write(const T *values, size_t count) {
+    size_t wr = write_at.load(std::memory_order_relaxed);
+    size_t skip = count > capacity() ? count - capacity() : 0;
+    claim(wr + count);
+    for (size_t i = skip; i < count; i++) {
+      data[Metric::wrapped(wr + i)].store(values[i], std::memory_order_relaxed);
+    }
+    write_at.store(wr + count, std::memory_order_release);
+  }
+
+  /**
+   * Follows the values written to the buffer for a single reader thread. When
+   * the reader is lapped by the producer, it resynchronises to the oldest
+   * value that is still available and accounts for the values it lost.
+   */
+  class Reader {
+    const OverwritingRingBuffer &ring;
+    size_t read_at;
+    size_t lost_ = 0;
+
+  public:
+    /**
+     * Creates a reader that starts at the newest value that is written after
+     * its construction.
+     */
+    explicit Reader(const OverwritingRingBuffer &buffer)
+        : ring(buffer), read_at(buffer.write_ptr()) {}
+
+    /**
+     * Returns the position of the next value to read, that is the total
+     * number of values read or lost.
+     */
+    size_t read_ptr() const { return read_at; }
+
+    /**
+     * Returns the total number of values that were overwritten before this
+     * reader could read them.
+     */
+    size_t lost() const { return lost_; }
+
+    /**
+     * Reads at most \c count of the oldest unread values that are still
+     * available into \c values. Values that were overwritten are skipped and
+     * counted as lost, also when that happens while they are being read.
+     * @param values Receives the read values.
+     * @param count The maximum number of values to read.
+     * @returns The number of values read.
+     */
+    size_t read(T *values, size_t count) {
+      size_t wr = ring.write_at.load(std::memory_order_acquire);
+      if (wr - read_at > capacity()) {
+        lost_ += wr - capacity() - read_at;
+        read_at = wr - capacity();
+      }
+      size_t n = std::min(count, wr - read_at);
+      for (size_t i = 0; i < n; i++) {
+        values[i] = ring.data[Metric::wrapped(read_at + i)].load(
+            std::memory_order_relaxed);
+      }
+      // Any value copied from a slot that the producer started to overwrite,
+      // makes this load observe at least the position it claimed for that.
+      std::atomic_thread_fence(std::memory_order_acquire);
+      size_t claimed = ring.claimed_at.load(std::memory_order_relaxed);
+      if (claimed - read_at > capacity()) {
+        size_t invalid = std::min(n, claimed - capacity() - read_at);
+        std::copy(values + invalid, values + n, values);
+        n -= invalid;
+        lost_ += invalid;
+        read_at += invalid;
+      }
+      read_at += n;
+      return n;
+    }
+
+    /**
+     * Reads the oldest unread value that is still available into \c value.
+     * @param value Receives the read value.
+     * @returns \c true if a value was read, \c false otherwise.
+     */
+    bool read(T &value) { return read(&value, 1) == 1; }
+
+    /**
+     * Reads the newest \c count values, or fewer if not that many values are
+     * available, into \c values, oldest first. Unread values before those are
+     * counted as lost.
+     * @param values Receives the read values.
+     * @param count The maximum number of values to read.
+     * @returns The number of values read.
+     */
+    size_t read_latest(T *values, size_t count) {
+      size_t wr = ring.write_at.load(std::memory_order_acquire);
+      size_t window = std::min(count, capacity());
+      if (wr - read_at > window) {
+        lost_ += wr - window - read_at;
+        read_at = wr - window;
+      }
+      return read(values, count);
+    }
+  };
+};
+
+} // namespace org::simple
+
+#endif // ORG_SIMPLE_M_OVERWRITING_RING_BUFFER_H
@@ -0,0 +1,184 @@
+#ifndef ORG_SIMPLE_M_PARKING_H
+#define ORG_SIMPLE_M_PARKING_H
+/*
+ * org-simple/Parking.h
+ *
+ * Added by michel on 2026-10-15
+ * Copyright (C) 2015-2026 Michel Fleur.
+ * Source https://github.com/emmef/org-simple
+ * Email org-simple@emmef.org
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <org-simple/Timeout.h>
+#include <thread>
+
+#if defined(__linux__)
+#include <ctime>
+#include <linux/futex.h>
+#include <linux/membarrier.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace org::simple {
+
+/**
+ * Lets a thread wait for a condition that another thread makes true, where the
+ * other thread only pays for a notification if the waiting thread is actually
+ * parked. That keeps the notifying side wait-free, which is a requirement if
+ * it is a real-time thread.
+ *
+ * A waiting thread first spins for a short while. It then announces that it
+ * is parked and sleeps on a futex, in slices of at most PARK_SLICE, so that a
+ * Timeout is honoured even if no notification arrives. It announces again
+ * only after a notification cleared the announcement, so that a slice that
+ * expires does not disturb the other threads. This is preferred over
+ * std::atomic::wait, that has no timed variant. On systems without futexes the
+ * thread sleeps for a slice instead of parking.
+ *
+ * The announcement and the check of the condition must be ordered with
+ * respect to the change of the condition and the check of the announcement,
+ * or a notification can get lost. On Linux, the waiting thread orders both
+ * sides with an expedited membarrier after its announcement, which executes a
+ * full barrier on every running thread of the process. The notifying thread
+ * then only needs a compiler barrier, so that a notification without a parked
+ * thread costs a relaxed load. Where membarrier is unavailable, both sides
+ * issue a sequentially consistent fence instead.
+ */
+class Parking {
+  std::atomic<uint32_t> parked = 0;
+  const bool asymmetric = register_membarrier();
+
+  /**
+   * Registers the process for expedited private membarriers once.
+   * @returns Whether the waiting side can use them.
+   */
+  static bool register_membarrier() {
+#if defined(__linux__)
+    static const bool registered =
+        syscall(SYS_membarrier, MEMBARRIER_CMD_REGISTER_PRIVATE_EXPEDITED, 0,
+                0) == 0;
+    return registered;
+#else
+    return false;
+#endif
+  }
+
+  void announce() {
+    parked.store(1, std::memory_order_relaxed);
+#if defined(__linux__)
+    if (asymmetric) {
+      syscall(SYS_membarrier, MEMBARRIER_CMD_PRIVATE_EXPEDITED, 0, 0);
+      return;
+    }
+#endif
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+  }
+
+  static void relax() {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__)
+    asm volatile("yield");
+#endif
+  }
+
+  void park() {
+#if defined(__linux__)
+    static_assert(sizeof(parked) == sizeof(uint32_t));
+    auto nanos =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(PARK_SLICE);
+    timespec slice{0, static_cast<long>(nanos.count())};
+    syscall(SYS_futex, reinterpret_cast<uint32_t *>(&parked),
+            FUTEX_WAIT_PRIVATE, 1, &slice, nullptr, 0);
+#else
+    std::this_thread::sleep_for(PARK_SLICE);
+#endif
+  }
+
+  void wake() {
+#if defined(__linux__)
+    syscall(SYS_futex, reinterpret_cast<uint32_t *>(&parked),
+            FUTEX_WAKE_PRIVATE, 1, nullptr, nullptr, 0);
+#endif
+  }
+
+public:
+  static constexpr unsigned SPINS = 256;
+  static constexpr std::chrono::microseconds PARK_SLICE{1000};
+
+  /**
+   * Waits until \c ready returns \c true or the timeout expires. The
+   * predicate is evaluated repeatedly and should perform the operation that is
+   * waited for, like reading from a buffer.
+   * @param ready The predicate that returns \c true on success.
+   * @param timeout Determines when to give up.
+   * @returns \c true if \c ready returned \c true, \c false on timeout.
+   */
+  template <class Ready> bool wait(Ready ready, Timeout &timeout) {
+    for (unsigned i = 0; i < SPINS; i++) {
+      if (ready()) {
+        return true;
+      }
+      relax();
+    }
+    timeout.start();
+    announce();
+    while (true) {
+      if (ready()) {
+        parked.store(0, std::memory_order_relaxed);
+        return true;
+      }
+      if (timeout.timed_out()) {
+        parked.store(0, std::memory_order_relaxed);
+        return ready();
+      }
+      park();
+      // While still announced, the barrier of the announcement still makes a
+      // later notification see it: only announce again if it was cleared.
+      if (parked.load(std::memory_order_relaxed) == 0) {
+        announce();
+      }
+    }
+  }
+
+  /**
+   * Wakes the waiting thread if it is parked, which is wait-free and cheap if
+   * it is not. This must be called after making the condition true.
+   */
+  void notify() {
+    if (asymmetric) {
+      std::atomic_signal_fence(std::memory_order_seq_cst);
+    } else {
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+    }
+    if (parked.load(std::memory_order_relaxed)) {
+      parked.store(0, std::memory_order_relaxed);
+      wake();
+    }
+  }
+
+  /**
+   * Returns whether a thread is parked, or about to.
+   */
+  bool is_parked() const { return parked.load(std::memory_order_relaxed); }
+};
+
+} // namespace org::simple
+
+#endif // ORG_SIMPLE_M_PARKING_H
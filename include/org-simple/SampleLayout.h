@@ -21,10 +21,609 @@
  * limitations under the License.
  */
 
+#include <bit>
+#include <cstdint>
+#include <cstring>
 #include <org-simple/NumArray.h>
+#include <org-simple/NumKernels.h>
+#include <stdexcept>
+#include <type_traits>
 
 namespace org::simple {
 
+namespace sample_layout {
+
+/**
+ * Whether samples of type \c S can be moved with the vectors of Vectorized.
+ */
+template <typename S>
+static constexpr bool vectorizable =
+#if defined(__GNUC__)
+    std::is_arithmetic_v<S> && !std::is_same_v<S, bool> && sizeof(S) < 16 &&
+    16 % sizeof(S) == 0;
+#else
+    false;
+#endif
+
+/**
+ * Interleaves and deinterleaves groups of channels with 128-bit vectors, a
+ * width that every target of a GCC compatible compiler has. The samples of a
+ * block of GROUP channels by LANES frames are interleaved by log2(GROUP)
+ * stages that each zip the first half of the vectors with the second half.
+ * Each stage is a perfect shuffle of the samples in the block and the stages
+ * together rotate the sample index from channel-major to frame-major.
+ * Deinterleaving does the inverse stages that unzip pairs of vectors.
+ */
+template <typename S> struct Vectorized {
+  static_assert(vectorizable<S>);
+  static constexpr size_t LANES = 16 / sizeof(S);
+  static constexpr size_t MAX_GROUP = 8;
+  using V = typename num_kernels::Vector<S, 16, alignof(S)>::type;
+
+  template <size_t GROUP>
+  static constexpr bool isGroup =
+      GROUP >= 2 && GROUP <= MAX_GROUP && (GROUP & (GROUP - 1)) == 0;
+
+  // Vectors are only passed by reference, as in NumKernels.
+  static const V &load(const S *p) { return *reinterpret_cast<const V *>(p); }
+  static V &store(S *p) { return *reinterpret_cast<V *>(p); }
+
+  template <size_t... I>
+  static void zip(V &low, V &high, const V &a, const V &b,
+                  std::index_sequence<I...>) {
+    low = __builtin_shufflevector(a, b, (I / 2 + (I % 2) * LANES)...);
+    high = __builtin_shufflevector(a, b,
+                                   (LANES / 2 + I / 2 + (I % 2) * LANES)...);
+  }
+
+  template <size_t... I>
+  static void unzip(V &evens, V &odds, const V &a, const V &b,
+                    std::index_sequence<I...>) {
+    evens = __builtin_shufflevector(a, b, (2 * I)...);
+    odds = __builtin_shufflevector(a, b, (2 * I + 1)...);
+  }
+
+  /**
+   * Interleaves the GROUP vectors of \c v. If there are more vectors than
+   * lanes, squares of LANES channels are transposed apart and their vectors
+   * are reordered, which takes less shuffles than zipping them all.
+   */
+  template <size_t GROUP> static void interleave(V (&v)[GROUP]) {
+    if constexpr (GROUP > LANES) {
+      static constexpr size_t SQUARES = GROUP / LANES;
+      V w[GROUP];
+      for (size_t square = 0; square < SQUARES; square++) {
+        V u[LANES];
+        for (size_t i = 0; i < LANES; i++) {
+          u[i] = v[square * LANES + i];
+        }
+        interleave(u);
+        for (size_t frame = 0; frame < LANES; frame++) {
+          w[frame * SQUARES + square] = u[frame];
+        }
+      }
+      for (size_t i = 0; i < GROUP; i++) {
+        v[i] = w[i];
+      }
+    } else {
+      static constexpr auto lanes = std::make_index_sequence<LANES>();
+      for (size_t stage = 1; stage < GROUP; stage *= 2) {
+        V w[GROUP];
+        for (size_t i = 0; i < GROUP / 2; i++) {
+          zip(w[2 * i], w[2 * i + 1], v[i], v[i + GROUP / 2], lanes);
+        }
+        for (size_t i = 0; i < GROUP; i++) {
+          v[i] = w[i];
+        }
+      }
+    }
+  }
+
+  template <size_t GROUP> static void deinterleave(V (&v)[GROUP]) {
+    if constexpr (GROUP > LANES) {
+      static constexpr size_t SQUARES = GROUP / LANES;
+      V w[GROUP];
+      for (size_t square = 0; square < SQUARES; square++) {
+        V u[LANES];
+        for (size_t frame = 0; frame < LANES; frame++) {
+          u[frame] = v[frame * SQUARES + square];
+        }
+        deinterleave(u);
+        for (size_t i = 0; i < LANES; i++) {
+          w[square * LANES + i] = u[i];
+        }
+      }
+      for (size_t i = 0; i < GROUP; i++) {
+        v[i] = w[i];
+      }
+    } else {
+      static constexpr auto lanes = std::make_index_sequence<LANES>();
+      for (size_t stage = 1; stage < GROUP; stage *= 2) {
+        V w[GROUP];
+        for (size_t i = 0; i < GROUP / 2; i++) {
+          unzip(w[i], w[i + GROUP / 2], v[2 * i], v[2 * i + 1], lanes);
+        }
+        for (size_t i = 0; i < GROUP; i++) {
+          v[i] = w[i];
+        }
+      }
+    }
+  }
+
+  /**
+   * Interleaves LANES frames from \c frame on of the GROUP channels in \c
+   * channels into \c output, where consecutive frames are \c stride samples
+   * apart.
+   */
+  template <size_t GROUP>
+  static void toInterleaved(const S *const *channels, size_t frame, S *output,
+                            size_t stride) {
+    static_assert(isGroup<GROUP>);
+    V v[GROUP];
+    for (size_t channel = 0; channel < GROUP; channel++) {
+      v[channel] = load(channels[channel] + frame);
+    }
+    interleave(v);
+    if constexpr (GROUP % LANES == 0) {
+      // The samples of each frame are whole vectors
+      static constexpr size_t PER_FRAME = GROUP / LANES;
+      for (size_t frame = 0; frame < LANES; frame++) {
+        for (size_t i = 0; i < PER_FRAME; i++) {
+          store(output + frame * stride + i * LANES) =
+              v[frame * PER_FRAME + i];
+        }
+      }
+      return;
+    }
+    if (stride == GROUP) {
+      for (size_t i = 0; i < GROUP; i++) {
+        store(output + i * LANES) = v[i];
+      }
+      return;
+    }
+    const S *samples = reinterpret_cast<const S *>(v);
+    for (size_t i = 0; i < LANES; i++) {
+      std::memcpy(output + i * stride, samples + i * GROUP, GROUP * sizeof(S));
+    }
+  }
+
+  /**
+   * Deinterleaves LANES frames from \c input, where consecutive frames are \c
+   * stride samples apart, to the GROUP channels in \c channels from \c frame
+   * on.
+   */
+  template <size_t GROUP>
+  static void toChannels(const S *input, size_t stride, S *const *channels,
+                         size_t frame) {
+    static_assert(isGroup<GROUP>);
+    V v[GROUP];
+    if constexpr (GROUP % LANES == 0) {
+      static constexpr size_t PER_FRAME = GROUP / LANES;
+      for (size_t frame = 0; frame < LANES; frame++) {
+        for (size_t i = 0; i < PER_FRAME; i++) {
+          v[frame * PER_FRAME + i] = load(input + frame * stride + i * LANES);
+        }
+      }
+    } else if (stride == GROUP) {
+      for (size_t i = 0; i < GROUP; i++) {
+        v[i] = load(input + i * LANES);
+      }
+    } else {
+      S *samples = reinterpret_cast<S *>(v);
+      for (size_t i = 0; i < LANES; i++) {
+        std::memcpy(samples + i * GROUP, input + i * stride, GROUP * sizeof(S));
+      }
+    }
+    deinterleave(v);
+    for (size_t channel = 0; channel < GROUP; channel++) {
+      store(channels[channel] + frame) = v[channel];
+    }
+  }
+};
+
+/**
+ * Interleaves \c frames frames of the \c channels buffers in \c inputs into
+ * \c output, where consecutive frames are \c stride samples apart. Channels
+ * are interleaved with vectors in groups of eight, four and two. If CHANNELS
+ * is not zero, it is the number of channels, so that the groups are known at
+ * compile time.
+ */
+template <size_t CHANNELS, typename S>
+static void interleave(const S *const *inputs, S *output, size_t channels,
+                       size_t frames, size_t stride) {
+  if constexpr (CHANNELS != 0) {
+    channels = CHANNELS;
+  }
+  size_t frame = 0;
+  if constexpr (vectorizable<S>) {
+    using Vectorized = sample_layout::Vectorized<S>;
+    static constexpr size_t LANES = Vectorized::LANES;
+    const size_t vectorEnd = frames - frames % LANES;
+    for (; channels > 1 && frame < vectorEnd; frame += LANES) {
+      S *frames_output = output + frame * stride;
+      size_t channel = 0;
+      for (; channel + 8 <= channels; channel += 8) {
+        Vectorized::template toInterleaved<8>(
+            inputs + channel, frame, frames_output + channel, stride);
+      }
+      if (channel + 4 <= channels) {
+        Vectorized::template toInterleaved<4>(
+            inputs + channel, frame, frames_output + channel, stride);
+        channel += 4;
+      }
+      if (channel + 2 <= channels) {
+        Vectorized::template toInterleaved<2>(
+            inputs + channel, frame, frames_output + channel, stride);
+        channel += 2;
+      }
+      if (channel < channels) {
+        for (size_t i = 0; i < LANES; i++) {
+          frames_output[i * stride + channel] = inputs[channel][frame + i];
+        }
+      }
+    }
+  }
+  for (; frame < frames; frame++) {
+    for (size_t channel = 0; channel < channels; channel++) {
+      output[frame * stride + channel] = inputs[channel][frame];
+    }
+  }
+}
+
+/**
+ * Deinterleaves \c frames frames from \c input, where consecutive frames are
+ * \c stride samples apart, into the \c channels buffers in \c outputs, like
+ * interleave() does the other way around.
+ */
+template <size_t CHANNELS, typename S>
+static void deinterleave(const S *input, size_t stride, S *const *outputs,
+                         size_t channels, size_t frames) {
+  if constexpr (CHANNELS != 0) {
+    channels = CHANNELS;
+  }
+  size_t frame = 0;
+  if constexpr (vectorizable<S>) {
+    using Vectorized = sample_layout::Vectorized<S>;
+    static constexpr size_t LANES = Vectorized::LANES;
+    const size_t vectorEnd = frames - frames % LANES;
+    for (; channels > 1 && frame < vectorEnd; frame += LANES) {
+      const S *frames_input = input + frame * stride;
+      size_t channel = 0;
+      for (; channel + 8 <= channels; channel += 8) {
+        Vectorized::template toChannels<8>(frames_input + channel, stride,
+                                           outputs + channel, frame);
+      }
+      if (channel + 4 <= channels) {
+        Vectorized::template toChannels<4>(frames_input + channel, stride,
+                                           outputs + channel, frame);
+        channel += 4;
+      }
+      if (channel + 2 <= channels) {
+        Vectorized::template toChannels<2>(frames_input + channel, stride,
+                                           outputs + channel, frame);
+        channel += 2;
+      }
+      if (channel < channels) {
+        for (size_t i = 0; i < LANES; i++) {
+          outputs[channel][frame + i] = frames_input[i * stride + channel];
+        }
+      }
+    }
+  }
+  for (; frame < frames; frame++) {
+    for (size_t channel = 0; channel < channels; channel++) {
+      outputs[channel][frame] = input[frame * stride + channel];
+    }
+  }
+}
+
+/**
+ * Integer PCM formats, with the conversion of a sample from and to a 32-bit
+ * integer. Formats with a word of the size of the sample use the byte order
+ * of the host, like the native S16 and S32 formats of ALSA. Packed 24-bit
+ * samples are three bytes in little-endian order, like S24_3LE.
+ *
+ * Besides single samples, formats convert groups of four samples from and to
+ * a vector of 32-bit integers. Those may touch the first SPARE samples after
+ * the group, that must exist and that are rewritten later.
+ */
+template <typename WORD, size_t BITS_> struct Pcm {
+  using word = WORD;
+  static constexpr size_t BITS = BITS_;
+  static constexpr size_t WORDS = 1;
+  static constexpr size_t SPARE = 0;
+  static constexpr int32_t MAXIMUM = int32_t((int64_t(1) << (BITS - 1)) - 1);
+  static constexpr int32_t MINIMUM = -MAXIMUM - 1;
+
+  static int32_t read(const word *input) { return *input; }
+  static void write(word *output, int32_t value) { *output = word(value); }
+
+  template <class Words> static void read4(Words &values, const word *input) {
+    using W = typename num_kernels::Vector<word, 4 * sizeof(word),
+                                           alignof(word)>::type;
+    values = __builtin_convertvector(*reinterpret_cast<const W *>(input),
+                                     Words);
+  }
+  template <class Words>
+  static void write4(word *output, const Words &values) {
+    using W = typename num_kernels::Vector<word, 4 * sizeof(word),
+                                           alignof(word)>::type;
+    *reinterpret_cast<W *>(output) = __builtin_convertvector(values, W);
+  }
+};
+
+using Pcm16 = Pcm<int16_t, 16>;
+using Pcm32 = Pcm<int32_t, 32>;
+
+struct PackedPcm24 : public Pcm<uint8_t, 24> {
+  static constexpr size_t WORDS = 3;
+  static constexpr size_t SPARE = 1;
+
+  static int32_t read(const word *input) {
+    return int32_t(uint32_t(input[0]) << 8 | uint32_t(input[1]) << 16 |
+                   uint32_t(input[2]) << 24) >>
+           8;
+  }
+  static void write(word *output, int32_t value) {
+    output[0] = word(value);
+    output[1] = word(value >> 8);
+    output[2] = word(value >> 16);
+  }
+
+  /**
+   * Reads a sample with its next byte as a little-endian 32-bit integer per
+   * lane. This is much faster than a byte shuffle on targets that do not have
+   * one, like x86-64 without SSSE3.
+   */
+  template <class Words> static void read4(Words &values, const word *input) {
+    static_assert(std::endian::native == std::endian::little);
+    int32_t lanes[4];
+    std::memcpy(&lanes[0], input, 4);
+    std::memcpy(&lanes[1], input + 3, 4);
+    std::memcpy(&lanes[2], input + 6, 4);
+    std::memcpy(&lanes[3], input + 9, 4);
+    values = Words{lanes[0], lanes[1], lanes[2], lanes[3]} << 8 >> 8;
+  }
+
+  /**
+   * Writes each lane as a little-endian 32-bit integer, whose last byte is
+   * overwritten by the next lane, or the next sample for the last one.
+   */
+  template <class Words>
+  static void write4(word *output, const Words &values) {
+    static_assert(std::endian::native == std::endian::little);
+    for (size_t lane = 0; lane < 4; lane++) {
+      int32_t value = values[lane];
+      std::memcpy(output + 3 * lane, &value, 4);
+    }
+  }
+};
+
+/**
+ * Converts samples of format \c Format from and to floating point values,
+ * where full scale is one. Groups of four samples are converted with vectors,
+ * as the compiler does not vectorize the conversion from floating point to
+ * integers, which may trap for values that are out of range.
+ */
+template <class Format, typename S> struct PcmConversion {
+  static_assert(std::is_floating_point_v<S>);
+  using word = typename Format::word;
+  static constexpr S SCALE = S(int64_t(1) << (Format::BITS - 1));
+  static constexpr S LOWEST = S(Format::MINIMUM);
+
+  /**
+   * Returns the largest integer that \c S represents exactly and that is not
+   * larger than the maximum of the format, like 2^31 - 128 for float and
+   * 32-bit samples.
+   */
+  static constexpr S highest() {
+    for (size_t shift = 0;; shift++) {
+      int64_t candidate = int64_t(Format::MAXIMUM) >> shift << shift;
+      if (int64_t(S(candidate)) == candidate) {
+        return S(candidate);
+      }
+    }
+  }
+  static constexpr S HIGHEST = highest();
+
+  // Packed formats only have vectors on hosts with their byte order
+  static constexpr bool VECTORS =
+      vectorizable<S> &&
+      (Format::WORDS == 1 || std::endian::native == std::endian::little);
+
+  static void toFloats(S *output, const word *input, size_t count) {
+    size_t i = 0;
+    // The compiler vectorizes the conversion of whole words itself
+    if constexpr (VECTORS && Format::WORDS > 1) {
+      using Words = typename num_kernels::Vector<int32_t, 16, 4>::type;
+      using Floats =
+          typename num_kernels::Vector<S, 4 * sizeof(S), alignof(S)>::type;
+      for (; i + 4 + Format::SPARE <= count; i += 4) {
+        Words values;
+        Format::read4(values, input + i * Format::WORDS);
+        *reinterpret_cast<Floats *>(output + i) =
+            __builtin_convertvector(values, Floats) / SCALE;
+      }
+    }
+    for (; i < count; i++) {
+      output[i] = S(Format::read(input + i * Format::WORDS)) / SCALE;
+    }
+  }
+
+  /**
+   * Scales, adds the \c noise that is in units of the least significant bit
+   * if it is given, clips and rounds to nearest.
+   */
+  template <bool DITHER>
+  static void fromFloats(word *output, const S *input, const S *noise,
+                         size_t count) {
+    size_t i = 0;
+    if constexpr (VECTORS) {
+      using Words = typename num_kernels::Vector<int32_t, 16, 4>::type;
+      using Floats =
+          typename num_kernels::Vector<S, 4 * sizeof(S), alignof(S)>::type;
+      static constexpr Floats lowest = {LOWEST, LOWEST, LOWEST, LOWEST};
+      static constexpr Floats highest = {HIGHEST, HIGHEST, HIGHEST, HIGHEST};
+      static constexpr Floats half = {0.5, 0.5, 0.5, 0.5};
+      for (; i + 4 + Format::SPARE <= count; i += 4) {
+        Floats x = *reinterpret_cast<const Floats *>(input + i) * SCALE;
+        if constexpr (DITHER) {
+          x += *reinterpret_cast<const Floats *>(noise + i);
+        }
+        x = x < lowest ? lowest : x;
+        x = x > highest ? highest : x;
+        x += x < 0 ? -half : half;
+        Words values = __builtin_convertvector(x, Words);
+        Format::write4(output + i * Format::WORDS, values);
+      }
+    }
+    for (; i < count; i++) {
+      S x = input[i] * SCALE;
+      if constexpr (DITHER) {
+        x += noise[i];
+      }
+      x = std::clamp(x, LOWEST, HIGHEST);
+      Format::write(output + i * Format::WORDS,
+                    int32_t(x + (x < 0 ? S(-0.5) : S(0.5))));
+    }
+  }
+};
+
+/**
+ * Generates noise with a triangular probability density between minus one
+ * and one, that is added as dither in units of the least significant bit.
+ * Each value is the difference of the two 16-bit halves of a xorshift
+ * generator. There are several independent generators, so that the compiler
+ * can generate values in vectors.
+ */
+class TpdfDither {
+  static constexpr size_t GENERATORS = 16;
+  uint32_t state[GENERATORS];
+
+public:
+  explicit TpdfDither(uint32_t seed = 1) {
+    for (size_t i = 0; i < GENERATORS; i++) {
+      // Generators that are never zero and that do not start in step
+      state[i] = (seed + uint32_t(i)) * 2654435761u | 1;
+    }
+  }
+
+  template <typename S> void generate(S *noise, size_t count) {
+    static constexpr S SCALE = S(1) / 65536;
+    for (size_t i = 0; i < count; i += GENERATORS) {
+      uint32_t values[GENERATORS];
+      for (size_t j = 0; j < GENERATORS; j++) {
+        uint32_t x = state[j];
+        x ^= x << 13;
+        x ^= x >> 17;
+        x ^= x << 5;
+        state[j] = x;
+        values[j] = x;
+      }
+      size_t end = std::min(GENERATORS, count - i);
+      for (size_t j = 0; j < end; j++) {
+        noise[i + j] =
+            S(int32_t(values[j] & 0xffff) - int32_t(values[j] >> 16)) * SCALE;
+      }
+    }
+  }
+};
+
+} // namespace sample_layout
+
+/**
+ * A view on the samples of a number of channels by a number of frames that are
+ * known at runtime, like the number of channels of a device. The sample of a
+ * channel and frame is at <code>channel * channel_stride() + frame *
+ * frame_stride()</code> from data(). Interleaved views have a channel stride
+ * of one and planar views a frame stride of one. Strides may be larger than
+ * needed, to view part of a larger buffer.
+ * @tparam S Type of samples, that is const for a view that is only read.
+ */
+template <typename S> class SampleView {
+  S *data_;
+  size_t channels_;
+  size_t frames_;
+  size_t channel_stride_;
+  size_t frame_stride_;
+
+public:
+  SampleView(S *data, size_t channels, size_t frames, size_t channel_stride,
+             size_t frame_stride)
+      : data_(data), channels_(channels), frames_(frames),
+        channel_stride_(channel_stride), frame_stride_(frame_stride) {
+    if (channels > 1 && frames > 0 && channel_stride == 0) {
+      throw std::invalid_argument("SampleView: channels overlap.");
+    }
+    if (frames > 1 && channels > 0 && frame_stride == 0) {
+      throw std::invalid_argument("SampleView: frames overlap.");
+    }
+  }
+
+  template <typename T>
+  requires(std::is_same_v<const T, S>) SampleView(const SampleView<T> &view)
+      : SampleView(view.data(), view.channels(), view.frames(),
+                   view.channel_stride(), view.frame_stride()) {}
+
+  /**
+   * Returns a view on frames of \c channels samples that are \c frame_stride
+   * samples apart, which is the number of channels if it is zero.
+   */
+  static SampleView interleaved(S *data, size_t channels, size_t frames,
+                                size_t frame_stride = 0) {
+    if (frame_stride == 0) {
+      frame_stride = channels;
+    } else if (frame_stride < channels) {
+      throw std::invalid_argument("SampleView: frames overlap.");
+    }
+    return {data, channels, frames, 1, frame_stride};
+  }
+
+  /**
+   * Returns a view on channels of \c frames samples that are \c
+   * channel_stride samples apart, which is the number of frames if it is zero.
+   */
+  static SampleView planar(S *data, size_t channels, size_t frames,
+                           size_t channel_stride = 0) {
+    if (channel_stride == 0) {
+      channel_stride = frames;
+    } else if (channel_stride < frames) {
+      throw std::invalid_argument("SampleView: channels overlap.");
+    }
+    return {data, channels, frames, channel_stride, 1};
+  }
+
+  S *data() const { return data_; }
+  size_t channels() const { return channels_; }
+  size_t frames() const { return frames_; }
+  size_t channel_stride() const { return channel_stride_; }
+  size_t frame_stride() const { return frame_stride_; }
+  bool is_interleaved() const { return channel_stride_ == 1; }
+  bool is_planar() const { return frame_stride_ == 1; }
+
+  S &operator()(size_t channel, size_t frame) const {
+    return data_[channel * channel_stride_ + frame * frame_stride_];
+  }
+
+  /**
+   * Returns a pointer to the first sample of \c channel, whose samples are
+   * consecutive if the view is planar.
+   */
+  S *channel(size_t channel) const { return data_ + channel * channel_stride_; }
+
+  /**
+   * Returns a view on \c count frames from \c frame on, like a period of a
+   * larger buffer.
+   */
+  SampleView frame_range(size_t frame, size_t count) const {
+    if (frame > frames_ || count > frames_ - frame) {
+      throw std::out_of_range("SampleView: frame range out of range.");
+    }
+    return {data_ + frame * frame_stride_, channels_, count, channel_stride_,
+            frame_stride_};
+  }
+};
+
 struct SampleLayout {
 
   /**
@@ -52,11 +651,33 @@ struct SampleLayout {
   template <typename S, size_t CHANNELS, size_t FRAMES>
   static void channel_buffers_to_interleaved(S const **channel_ptr,
                                              S *&interleaved_output) {
-    for (size_t frame = 0; frame < FRAMES; frame++) {
-      for (size_t channel = 0; channel < CHANNELS; channel++) {
-        *interleaved_output++ = *channel_ptr[channel]++;
-      }
-    }
+    sample_layout::interleave<CHANNELS>(channel_ptr, interleaved_output,
+                                        CHANNELS, FRAMES, CHANNELS);
+    advance(channel_ptr, CHANNELS, FRAMES);
+    interleaved_output += CHANNELS * FRAMES;
+  }
+
+  /**
+   * Moves samples from \c channels channel-buffers with each \c frames
+   * samples to an interleaved output, like the variant with a compile-time
+   * number of channels and frames. Groups of eight, four and two channels are
+   * interleaved with vectors, and the samples of each frame in a group are
+   * written together.
+   * @param channel_ptr pointer to \c channels pointers to buffers of \c frames
+   * samples each, that are updated like in the compile-time variant.
+   * @param interleaved_output a consecutive buffer of \c channels * \c frames
+   * samples, that is updated like in the compile-time variant.
+   * @param channels The number of channels per frame.
+   * @param frames The number of frames.
+   */
+  template <typename S>
+  static void channel_buffers_to_interleaved(S const **channel_ptr,
+                                             S *&interleaved_output,
+                                             size_t channels, size_t frames) {
+    sample_layout::interleave<0>(channel_ptr, interleaved_output, channels,
+                                 frames, channels);
+    advance(channel_ptr, channels, frames);
+    interleaved_output += channels * frames;
   }
 
   /**
@@ -85,6 +706,12 @@ struct SampleLayout {
   template <typename S, size_t CHANNELS, size_t FRAMES>
   static void channel_buffers_to_frames(S const **channel_ptr,
                                         NumArray<S, CHANNELS> *&frames) {
+    if constexpr (sizeof(NumArray<S, CHANNELS>) == CHANNELS * sizeof(S)) {
+      S *output = frames->data();
+      channel_buffers_to_interleaved<S, CHANNELS, FRAMES>(channel_ptr, output);
+      frames += FRAMES;
+      return;
+    }
     for (size_t frame = 0; frame < FRAMES; frame++) {
       NumArray<S, CHANNELS> &output = *frames++;
       for (size_t channel = 0; channel < CHANNELS; channel++) {
@@ -119,11 +746,33 @@ struct SampleLayout {
   template <typename S, size_t CHANNELS, size_t FRAMES>
   static void interleaved_to_channel_buffers(const S *&interleaved_input,
                                              S **channel_ptr) {
-    for (size_t frame = 0; frame < FRAMES; frame++) {
-      for (size_t channel = 0; channel < CHANNELS; channel++) {
-        *channel_ptr[channel]++ = *interleaved_input++;
-      }
-    }
+    sample_layout::deinterleave<CHANNELS>(interleaved_input, CHANNELS,
+                                          channel_ptr, CHANNELS, FRAMES);
+    advance(channel_ptr, CHANNELS, FRAMES);
+    interleaved_input += CHANNELS * FRAMES;
+  }
+
+  /**
+   * Moves samples from an interleaved input with \c channels samples per
+   * frame to \c channels channel-buffers with each \c frames samples, like
+   * the variant with a compile-time number of channels and frames. Groups of
+   * eight, four and two channels are deinterleaved with vectors, and the
+   * samples of each frame in a group are read together.
+   * @param interleaved_input a consecutive buffer of \c channels * \c frames
+   * samples, that is updated like in the compile-time variant.
+   * @param channel_ptr pointer to \c channels pointers to buffers of \c frames
+   * samples each, that are updated like in the compile-time variant.
+   * @param channels The number of channels per frame.
+   * @param frames The number of frames.
+   */
+  template <typename S>
+  static void interleaved_to_channel_buffers(const S *&interleaved_input,
+                                             S **channel_ptr, size_t channels,
+                                             size_t frames) {
+    sample_layout::deinterleave<0>(interleaved_input, channels, channel_ptr,
+                                   channels, frames);
+    advance(channel_ptr, channels, frames);
+    interleaved_input += channels * frames;
   }
 
   /**
@@ -147,6 +796,12 @@ struct SampleLayout {
   template <typename S, size_t CHANNELS, size_t FRAMES>
   static void interleaved_to_channel_buffers(
       const NumArray<S, CHANNELS> *&interleaved_input, S **channel_ptr) {
+    if constexpr (sizeof(NumArray<S, CHANNELS>) == CHANNELS * sizeof(S)) {
+      const S *input = interleaved_input->data();
+      interleaved_to_channel_buffers<S, CHANNELS, FRAMES>(input, channel_ptr);
+      interleaved_input += FRAMES;
+      return;
+    }
     for (size_t frame = 0; frame < FRAMES; frame++) {
       const NumArray<S, CHANNELS> &input = *interleaved_input++;
       for (size_t channel = 0; channel < CHANNELS; channel++) {
@@ -154,6 +809,195 @@ struct SampleLayout {
       }
     }
   }
+
+  /**
+   * Converts interleaved integer PCM samples of format \c Format to floating
+   * point samples in \c channels channel-buffers, where full scale is one.
+   * The samples are converted a few kilobytes at a time into a buffer that
+   * stays in the first level cache, and then deinterleaved with vectors, so
+   * that the samples are read and written once.
+   * @tparam Format The PCM format, like sample_layout::Pcm16,
+   * sample_layout::PackedPcm24 or sample_layout::Pcm32.
+   * @param pcm_input a consecutive buffer of \c channels * \c frames samples
+   * of Format::WORDS words each, that is updated like in the other variants.
+   * @param channel_ptr pointer to \c channels pointers to buffers of \c frames
+   * samples each, that are updated like in the other variants.
+   * @param channels The number of channels per frame, at most 512.
+   * @param frames The number of frames.
+   */
+  template <class Format, typename S>
+  static void pcm_to_channel_buffers(const typename Format::word *&pcm_input,
+                                     S **channel_ptr, size_t channels,
+                                     size_t frames) {
+    using Conversion = sample_layout::PcmConversion<Format, S>;
+    S buffer[PCM_BUFFER_SAMPLES];
+    const size_t chunk = pcm_chunk_frames(channels);
+    for (size_t frame = 0; frame < frames; frame += chunk) {
+      size_t count = std::min(chunk, frames - frame);
+      Conversion::toFloats(buffer, pcm_input, count * channels);
+      const S *input = buffer;
+      interleaved_to_channel_buffers(input, channel_ptr, channels, count);
+      pcm_input += count * channels * Format::WORDS;
+    }
+  }
+
+  /**
+   * Converts floating point samples in \c channels channel-buffers to
+   * interleaved integer PCM samples of format \c Format, where full scale is
+   * one. Samples are clipped to the range of the format and rounded to
+   * nearest, after adding triangular dither if \c dither is given. The
+   * samples are interleaved with vectors a few kilobytes at a time into a
+   * buffer that stays in the first level cache and then converted, so that
+   * they are read and written once.
+   * @tparam Format The PCM format, like sample_layout::Pcm16,
+   * sample_layout::PackedPcm24 or sample_layout::Pcm32.
+   * @param channel_ptr pointer to \c channels pointers to buffers of \c frames
+   * samples each, that are updated like in the other variants.
+   * @param pcm_output a consecutive buffer of \c channels * \c frames samples
+   * of Format::WORDS words each, that is updated like in the other variants.
+   * @param channels The number of channels per frame, at most 512.
+   * @param frames The number of frames.
+   * @param dither generator of dither, or \c nullptr for none.
+   */
+  template <class Format, typename S>
+  static void channel_buffers_to_pcm(S const **channel_ptr,
+                                     typename Format::word *&pcm_output,
+                                     size_t channels, size_t frames,
+                                     sample_layout::TpdfDither *dither =
+                                         nullptr) {
+    using Conversion = sample_layout::PcmConversion<Format, S>;
+    S buffer[PCM_BUFFER_SAMPLES];
+    S noise[PCM_BUFFER_SAMPLES];
+    const size_t chunk = pcm_chunk_frames(channels);
+    for (size_t frame = 0; frame < frames; frame += chunk) {
+      size_t count = std::min(chunk, frames - frame);
+      size_t samples = count * channels;
+      S *output = buffer;
+      channel_buffers_to_interleaved(channel_ptr, output, channels, count);
+      if (dither) {
+        dither->generate(noise, samples);
+        Conversion::template fromFloats<true>(pcm_output, buffer, noise,
+                                              samples);
+      } else {
+        Conversion::template fromFloats<false>(pcm_output, buffer, nullptr,
+                                               samples);
+      }
+      pcm_output += samples * Format::WORDS;
+    }
+  }
+
+  /**
+   * Copies the samples of \c source to \c destination, that must have the
+   * same number of channels and frames and may not overlap. Between planar
+   * and interleaved views, channels are (de)interleaved with vectors. Views
+   * with up to eight channels use kernels where the number of channels is
+   * known at compile time, which is faster for the common ones. Other strided
+   * views are copied sample by sample.
+   * @throws std::invalid_argument if the views have different sizes.
+   */
+  template <typename T, typename S>
+  static void copy(const SampleView<T> &source,
+                   const SampleView<S> &destination) {
+    static_assert(std::is_same_v<std::remove_const_t<T>, S>);
+    const size_t channels = source.channels();
+    const size_t frames = source.frames();
+    if (channels != destination.channels() || frames != destination.frames()) {
+      throw std::invalid_argument("SampleLayout: views differ in size.");
+    }
+    if (channels == 0 || frames == 0) {
+      return;
+    }
+    if (source.is_planar() && destination.is_planar()) {
+      for (size_t channel = 0; channel < channels; channel++) {
+        std::copy_n(source.channel(channel), frames,
+                    destination.channel(channel));
+      }
+    } else if (source.is_planar() && destination.is_interleaved()) {
+      for (size_t first = 0; first < channels; first += VIEW_CHANNELS) {
+        size_t count = std::min(VIEW_CHANNELS, channels - first);
+        const S *inputs[VIEW_CHANNELS];
+        for (size_t i = 0; i < count; i++) {
+          inputs[i] = source.channel(first + i);
+        }
+        with_channels(count, [&](auto constant) {
+          sample_layout::interleave<constant()>(
+              inputs, destination.channel(first), count, frames,
+              destination.frame_stride());
+        });
+      }
+    } else if (source.is_interleaved() && destination.is_planar()) {
+      for (size_t first = 0; first < channels; first += VIEW_CHANNELS) {
+        size_t count = std::min(VIEW_CHANNELS, channels - first);
+        S *outputs[VIEW_CHANNELS];
+        for (size_t i = 0; i < count; i++) {
+          outputs[i] = destination.channel(first + i);
+        }
+        with_channels(count, [&](auto constant) {
+          sample_layout::deinterleave<constant()>(
+              source.channel(first), source.frame_stride(), outputs, count,
+              frames);
+        });
+      }
+    } else if (source.is_interleaved() && destination.is_interleaved()) {
+      for (size_t frame = 0; frame < frames; frame++) {
+        std::copy_n(&source(0, frame), channels, &destination(0, frame));
+      }
+    } else {
+      for (size_t channel = 0; channel < channels; channel++) {
+        for (size_t frame = 0; frame < frames; frame++) {
+          destination(channel, frame) = source(channel, frame);
+        }
+      }
+    }
+  }
+
+private:
+  static constexpr size_t PCM_BUFFER_SAMPLES = 512;
+  static constexpr size_t VIEW_CHANNELS = 64;
+
+  /**
+   * Invokes \c function with the number of channels as a compile-time
+   * constant for common numbers of channels, and with zero otherwise.
+   */
+  template <class Function>
+  static void with_channels(size_t channels, Function function) {
+    switch (channels) {
+    case 1:
+      return function(std::integral_constant<size_t, 1>());
+    case 2:
+      return function(std::integral_constant<size_t, 2>());
+    case 4:
+      return function(std::integral_constant<size_t, 4>());
+    case 6:
+      return function(std::integral_constant<size_t, 6>());
+    case 8:
+      return function(std::integral_constant<size_t, 8>());
+    default:
+      return function(std::integral_constant<size_t, 0>());
+    }
+  }
+
+  template <typename P>
+  static void advance(P **channel_ptr, size_t channels, size_t frames) {
+    for (size_t channel = 0; channel < channels; channel++) {
+      channel_ptr[channel] += frames;
+    }
+  }
+
+  /**
+   * Returns the number of frames that fit the conversion buffer, rounded down
+   * to a multiple of 16 frames if possible, so that chunks have no frames
+   * that are moved without vectors.
+   * @throws std::invalid_argument if a frame does not fit the buffer.
+   */
+  static size_t pcm_chunk_frames(size_t channels) {
+    if (channels == 0 || channels > PCM_BUFFER_SAMPLES) {
+      throw std::invalid_argument(
+          "SampleLayout: PCM conversion needs 1 to 512 channels.");
+    }
+    size_t frames = PCM_BUFFER_SAMPLES / channels;
+    return frames >= 16 ? frames / 16 * 16 : frames;
+  }
 };
 
 } // namespace org::simple
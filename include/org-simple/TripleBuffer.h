@@ -0,0 +1,127 @@
+#ifndef ORG_SIMPLE_M_TRIPLE_BUFFER_H
+#define ORG_SIMPLE_M_TRIPLE_BUFFER_H
+/*
+ * org-simple/TripleBuffer.h
+ *
+ * Added by michel on 2026-10-15
+ * Copyright (C) 2015-2026 Michel Fleur.
+ * Source https://github.com/emmef/org-simple
+ * Email org-simple@emmef.org
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <atomic>
+#include <org-simple/Align.h>
+
+namespace org::simple {
+
+/**
+ * A latest-value mailbox for a single writer and a single reader thread, that
+ * is wait-free for both. It is intended to hand large structures, like a
+ * complete filter configuration, to a real-time thread without copying them
+ * through a queue.
+ *
+ * There are three slots: one that the writer owns, one that the reader owns
+ * and one in the middle. The writer fills its slot in place and publishes it
+ * by exchanging it with the middle slot. The reader exchanges its slot with
+ * the middle slot only if that contains a newer value and then uses it in
+ * place. Values that the reader did not pick up in time are skipped.
+ *
+ * After publishing, the slot that the writer gets back contains an older
+ * value, so the writer must write the complete value each time.
+ *
+ * @tparam T The type of value, that must be default constructible.
+ */
+template <typename T> class TripleBuffer {
+  static constexpr unsigned INDEX = 3;
+  static constexpr unsigned FRESH = 4;
+
+  struct alignas(Align::cacheLine) Slot {
+    T value;
+  };
+
+  Slot slots[3];
+  alignas(Align::cacheLine) std::atomic_uint middle = 1;
+  alignas(Align::cacheLine) unsigned write_index = 0;
+  alignas(Align::cacheLine) unsigned read_index = 2;
+
+public:
+  TripleBuffer() = default;
+
+  /**
+   * Creates a triple buffer where all slots contain \c initial.
+   */
+  explicit TripleBuffer(const T &initial) {
+    for (Slot &slot : slots) {
+      slot.value = initial;
+    }
+  }
+
+  /**
+   * Returns the slot that the writer can fill in place, before calling
+   * publish(). This must only be called by the writer thread.
+   */
+  T &write_buffer() { return slots[write_index].value; }
+
+  /**
+   * Makes the value in the write buffer the newest value for the reader. This
+   * must only be called by the writer thread.
+   */
+  void publish() {
+    write_index =
+        middle.exchange(write_index | FRESH, std::memory_order_acq_rel) & INDEX;
+  }
+
+  /**
+   * Copies \c value into the write buffer and publishes it. This must only be
+   * called by the writer thread.
+   */
+  void write(const T &value) {
+    write_buffer() = value;
+    publish();
+  }
+
+  /**
+   * Makes the newest published value available as the read buffer, if there
+   * is one that the reader did not obtain yet. This must only be called by the
+   * reader thread.
+   * @returns \c true if the read buffer changed, \c false otherwise.
+   */
+  bool update() {
+    if (!(middle.load(std::memory_order_relaxed) & FRESH)) {
+      return false;
+    }
+    read_index = middle.exchange(read_index, std::memory_order_acq_rel) & INDEX;
+    return true;
+  }
+
+  /**
+   * Returns the value that the reader obtained with the last update(). This
+   * must only be called by the reader thread.
+   */
+  const T &read_buffer() const { return slots[read_index].value; }
+
+  /**
+   * Obtains the newest published value and returns it. This must only be
+   * called by the reader thread.
+   */
+  const T &read() {
+    update();
+    return read_buffer();
+  }
+};
+
+} // namespace org::simple
+
+#endif // ORG_SIMPLE_M_TRIPLE_BUFFER_H
@@ -0,0 +1,143 @@
+#ifndef ORG_SIMPLE_M_WAITING_RING_BUFFER_H
+#define ORG_SIMPLE_M_WAITING_RING_BUFFER_H
+/*
+ * org-simple/WaitingRingBuffer.h
+ *
+ * Added by michel on 2026-10-15
+ * Copyright (C) 2015-2026 Michel Fleur.
+ * Source https://github.com/emmef/org-simple
+ * Email org-simple@emmef.org
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <org-simple/Align.h>
+#include <org-simple/LockfreeRingBuffer.h>
+#include <org-simple/Parking.h>
+#include <utility>
+
+namespace org::simple {
+
+/**
+ * Wraps a single producer, single consumer lock-free ring buffer, so that a
+ * non real-time side can wait for data or room without burning a core, while
+ * the real-time side stays wait-free.
+ *
+ * The read_wait() and write_wait() methods spin briefly and then park the
+ * calling thread until the other side notifies it or the timeout expires. The
+ * non-waiting operations notify the other side, but only if it is actually
+ * parked. Both sides must access the buffer through this wrapper, as
+ * operations on the wrapped buffer itself do not notify.
+ *
+ * @tparam Buffer The wrapped buffer, for example RingBufferLockFree.
+ */
+template <class Buffer> class WaitingRingBuffer {
+  Buffer buffer;
+  alignas(Align::cacheLine) Parking readers;
+  alignas(Align::cacheLine) Parking writers;
+
+public:
+  using value_type = typename Buffer::value_type;
+
+  template <typename... A>
+  explicit WaitingRingBuffer(A &&...arguments)
+      : buffer(std::forward<A>(arguments)...) {}
+
+  size_t capacity() const { return buffer.capacity(); }
+  size_t size() const { return buffer.size(); }
+  bool empty() const { return buffer.empty(); }
+  bool full() const { return buffer.full(); }
+
+  /**
+   * Pushes \c value on the queue, which fails if the queue is full, and wakes
+   * up a parked reader.
+   * @param value The value to push.
+   * @returns \c true if push was successful, \c false otherwise.
+   */
+  bool write(const value_type &value) {
+    if (buffer.write(value)) {
+      readers.notify();
+      return true;
+    }
+    return false;
+  }
+
+  /**
+   * Pushes as many of the \c count values in \c values on the queue as there
+   * is room for, and wakes up a parked reader.
+   * @param values The values to push.
+   * @param count The number of values to push.
+   * @returns The number of values that was actually pushed.
+   */
+  size_t write(const value_type *values, size_t count) {
+    size_t written = buffer.write(values, count);
+    if (written) {
+      readers.notify();
+    }
+    return written;
+  }
+
+  /**
+   * Pushes \c value on the queue, waiting for room until \c timeout expires.
+   * @param value The value to push.
+   * @param timeout Determines how long to wait.
+   * @returns \c true if push was successful, \c false on timeout.
+   */
+  bool write_wait(const value_type &value, Timeout &timeout) {
+    return writers.wait([&]() { return write(value); }, timeout);
+  }
+
+  /**
+   * Shifts a value off the queue into \c value, which fails if the queue is
+   * empty, and wakes up a parked writer.
+   * @param value Contains the shifted value on success.
+   * @returns \c true if shift was successful, \c false otherwise
+   */
+  bool read(value_type &value) {
+    if (buffer.read(value)) {
+      writers.notify();
+      return true;
+    }
+    return false;
+  }
+
+  /**
+   * Shifts at most \c count values off the queue into \c values, and wakes up
+   * a parked writer.
+   * @param values Contains the shifted values on success.
+   * @param count The maximum number of values to shift.
+   * @returns The number of values that was actually shifted.
+   */
+  size_t read(value_type *values, size_t count) {
+    size_t read = buffer.read(values, count);
+    if (read) {
+      writers.notify();
+    }
+    return read;
+  }
+
+  /**
+   * Shifts a value off the queue into \c value, waiting for one until \c
+   * timeout expires.
+   * @param value Contains the shifted value on success.
+   * @param timeout Determines how long to wait.
+   * @returns \c true if shift was successful, \c false on timeout.
+   */
+  bool read_wait(value_type &value, Timeout &timeout) {
+    return readers.wait([&]() { return read(value); }, timeout);
+  }
+};
+
+} // namespace org::simple
+
+#endif // ORG_SIMPLE_M_WAITING_RING_BUFFER_H
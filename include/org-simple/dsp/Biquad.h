@@ -184,6 +184,39 @@ struct [[maybe_unused]] BiQuad {
         history.push(input[1], output[1]);
       }
     }
+
+    /**
+     * Applies the filter implemented by the coefficients backwards, using a
+     * block of input samples and a block of output samples. The history is
+     * provided and kept by the history parameter, where the "past" values are
+     * the ones after the block.
+     * @tparam V The value type that can be floating point, but also a numerical
+     * vector or something.
+     * @param x The block of input values with a length of at least len.
+     * @param y The block of output values with a length of at least len.
+     * @param len The number of samples to process.
+     * @param history The history that contains initial history and the history
+     * after.
+     */
+    template <class V>
+    [[maybe_unused]] void
+    applyBackwardsWithHistory(const V *__restrict x, V *__restrict y,
+                              const size_t len, History<V> &history) const {
+      V x1 = history.x1;
+      V x2 = history.x2;
+      V y1 = history.y1;
+      V y2 = history.y2;
+      for (size_t i = len; i-- > 0;) {
+        const V input = x[i];
+        const V output = b0 * input + b1 * x1 + b2 * x2 + a1 * y1 + a2 * y2;
+        y[i] = output;
+        x2 = x1;
+        x1 = input;
+        y2 = y1;
+        y1 = output;
+      }
+      history = {x1, x2, y1, y2};
+    }
   };
 
   struct Butterworth {
@@ -210,7 +243,7 @@ struct [[maybe_unused]] BiQuad {
     }
 
     /**
-     * Configures the coefficients to implement a low-pass Butterworth filter.
+     * Configures the coefficients to implement a high-pass Butterworth filter.
      * @tparam F The coefficient value type.
      * @param coefficients The coefficients that implement the filter.
      * @param frequency The cutoff frequency in Hz.
@@ -230,15 +263,15 @@ struct [[maybe_unused]] BiQuad {
 
       const double a0R = 1.0 / (1.0 + alpha);
 
-      coefficients.b0 = static_cast<F>(a0R * (1.0 - cs) * 0.5);
-      coefficients.b1 = static_cast<F>(a0R * (1.0 - cs));
-      coefficients.b2 = static_cast<F>(a0R * (1.0 - cs) * 0.5);
+      coefficients.b0 = static_cast<F>(a0R * (1.0 + cs) * 0.5);
+      coefficients.b1 = static_cast<F>(a0R * -(1.0 + cs));
+      coefficients.b2 = static_cast<F>(a0R * (1.0 + cs) * 0.5);
       coefficients.a1 = static_cast<F>(a0R * (2.0 * cs));
       coefficients.a2 = static_cast<F>(a0R * (alpha - 1.0));
     }
 
     /**
-     * Configures the coefficients to implement a high-pass Butterworth filter.
+     * Configures the coefficients to implement a low-pass Butterworth filter.
      * @tparam F The coefficient value type.
      * @param coefficients The coefficients that implement the filter.
      * @param frequency The cutoff frequency in Hz.
@@ -257,9 +290,9 @@ struct [[maybe_unused]] BiQuad {
 
       const double a0R = 1.0 / (1.0 + alpha);
 
-      coefficients.b0 = static_cast<F>(a0R * (1.0 + cs) * 0.5);
-      coefficients.b1 = static_cast<F>(a0R * -(1.0 + cs));
-      coefficients.b2 = static_cast<F>(a0R * (1.0 + cs) * 0.5);
+      coefficients.b0 = static_cast<F>(a0R * (1.0 - cs) * 0.5);
+      coefficients.b1 = static_cast<F>(a0R * (1.0 - cs));
+      coefficients.b2 = static_cast<F>(a0R * (1.0 - cs) * 0.5);
       coefficients.a1 = static_cast<F>(a0R * (2.0 * cs));
       coefficients.a2 = static_cast<F>(a0R * (alpha - 1.0));
     }
@@ -297,18 +330,17 @@ struct [[maybe_unused]] BiQuad {
       result.b0 = static_cast<F>((1.0f + (g * j)) * a0R);
       result.b1 = static_cast<F>((-2.0f * cw) * a0R);
       result.b2 = static_cast<F>((1.0f - (g * j)) * a0R);
-      result.a1 = -result.C1;
+      result.a1 = -result.b1;
       result.a2 = static_cast<F>(((g / j) - 1.0f) * a0R);
-
-      return result;
     }
     template <class F>
-    [[maybe_unused]] static void
+    [[maybe_unused]] static Coefficients<F>
     create(const double sampleRate,
            const double centerFrequency, const double gain,
            const double bandwidth) {
       Coefficients<F> coefficients;
       configure(coefficients, sampleRate, centerFrequency, gain, bandwidth);
+      return coefficients;
     }
   };
 };
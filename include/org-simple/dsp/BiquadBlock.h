@@ -0,0 +1,170 @@
+#ifndef ORG_SIMPLE_DSP_M_BIQUAD_BLOCK_H
+#define ORG_SIMPLE_DSP_M_BIQUAD_BLOCK_H
+/*
+ * org-simple/dsp/BiquadBlock.h
+ *
+ * Added by michel on 2026-10-16
+ * Copyright (C) 2015-2026 Michel Fleur.
+ * Source https://github.com/emmef/org-simple
+ * Email org-simple@emmef.org
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <bit>
+#include <cstddef>
+#include <org-simple/NumKernels.h>
+#include <org-simple/dsp/Biquad.h>
+
+namespace org::simple::dsp {
+
+/**
+ * A biquad filter for a single channel that computes blocks of K outputs at
+ * once, to break the dependency of every output on the previous one.
+ *
+ * The outputs of a block follow from its K inputs and the state before the
+ * block: \c y = \c T \c x + \c M \c s. Column \c i of the lower triangular
+ * K by K matrix \c T is the impulse response of the filter, delayed by \c i
+ * samples. The four columns of the K by 4 matrix \c M are the first K steps
+ * of the state transition of the filter: the responses without input to
+ * each value of the state. Both are computed once, in double precision,
+ * when the coefficients are set.
+ *
+ * The state is not the history \c x1, \c x2, \c y1, \c y2 itself, but
+ * \c x1, \c x1 - \c x2, \c y1 and \c y1 - \c y2. With poles close to one,
+ * like those of a low-frequency filter at a high sample rate, the responses
+ * to \c y1 and \c y2 are large and cancel each other, so that rounding them
+ * to T would amplify into errors far larger than those of the recursion.
+ *
+ * A block costs K + 4 vector multiply-adds of K lanes, of which only the
+ * last two wait for the previous block. Blocks shorter than K, like the end
+ * of the input, are filtered with BiQuad::Coefficients::applyWithHistory(),
+ * that is also used entirely if the compiler does not support vectors.
+ * @tparam T The floating-point type of samples and coefficients.
+ * @tparam K The number of outputs per block, a power of two between two and
+ * sixteen.
+ */
+template <typename T, size_t K = 8> class BiQuadBlock {
+  static_assert(std::is_floating_point_v<T>);
+  static_assert(std::has_single_bit(K) && K >= 2 && K <= 16,
+                "K must be 2, 4, 8 or 16");
+
+public:
+  using Coefficients = BiQuad::Coefficients<T>;
+  using History = BiQuad::History<T>;
+
+  BiQuadBlock() { setCoefficients({}); }
+
+  explicit BiQuadBlock(const Coefficients &coefficients) {
+    setCoefficients(coefficients);
+  }
+
+  const Coefficients &coefficients() const { return coefficients_; }
+
+  /**
+   * Sets the coefficients and computes the block matrices for them.
+   */
+  void setCoefficients(const Coefficients &coefficients) {
+    coefficients_ = coefficients;
+    // Column HISTORY + i is the response to an impulse at sample i; the
+    // first columns the responses to each of the history values.
+    double response[COLUMNS][K];
+    for (size_t column = 0; column < COLUMNS; column++) {
+      double x[K + 2] = {};
+      double y[K + 2] = {};
+      if (column < HISTORY) {
+        (column < 2 ? x : y)[1 - column % 2] = 1;
+      } else {
+        x[2 + column - HISTORY] = 1;
+      }
+      for (size_t k = 0; k < K; k++) {
+        y[k + 2] = coefficients.b0 * x[k + 2] + coefficients.b1 * x[k + 1] +
+                   coefficients.b2 * x[k] + coefficients.a1 * y[k + 1] +
+                   coefficients.a2 * y[k];
+        response[column][k] = y[k + 2];
+      }
+    }
+    // Responses to the state, as a1 * x1 + a2 * x2 = (a1 + a2) * x1 - a2 *
+    // (x1 - x2) and likewise for y.
+    for (size_t k = 0; k < K; k++) {
+      for (size_t column = 0; column < HISTORY; column += 2) {
+        const double first = response[column][k];
+        const double second = response[column + 1][k];
+        matrix_[column * K + k] = static_cast<T>(first + second);
+        matrix_[(column + 1) * K + k] = static_cast<T>(-second);
+      }
+      for (size_t column = HISTORY; column < COLUMNS; column++) {
+        matrix_[column * K + k] = static_cast<T>(response[column][k]);
+      }
+    }
+  }
+
+  /**
+   * Applies the filter to \c len samples of \c x into \c y, like
+   * BiQuad::Coefficients::apply() with a history of zero.
+   */
+  void apply(const T *__restrict x, T *__restrict y, size_t len) const {
+    History history;
+    applyWithHistory(x, y, len, history);
+  }
+
+  /**
+   * Applies the filter to \c len samples of \c x into \c y, like
+   * BiQuad::Coefficients::applyWithHistory(), starting with and updating
+   * \c history.
+   */
+  void applyWithHistory(const T *__restrict x, T *__restrict y, size_t len,
+                        History &history) const {
+    size_t done = 0;
+#if defined(__GNUC__)
+    using V = typename num_kernels::Vector<T, K * sizeof(T), ALIGNMENT>::type;
+    // Outputs need not be aligned
+    using U = typename num_kernels::Vector<T, K * sizeof(T), sizeof(T)>::type;
+    const V *m = reinterpret_cast<const V *>(matrix_);
+    T x1 = history.x1;
+    T x2 = history.x2;
+    T y1 = history.y1;
+    T y2 = history.y2;
+    for (; done + K <= len; done += K) {
+      const T *input = x + done;
+      V inputs = m[HISTORY] * input[0];
+      for (size_t i = 1; i < K; i++) {
+        inputs += m[HISTORY + i] * input[i];
+      }
+      const V outputs = inputs + m[0] * x1 + m[1] * (x1 - x2) +
+                        (m[2] * y1 + m[3] * (y1 - y2));
+      *reinterpret_cast<U *>(y + done) = outputs;
+      x1 = input[K - 1];
+      x2 = input[K - 2];
+      y1 = outputs[K - 1];
+      y2 = outputs[K - 2];
+    }
+    history = {x1, x2, y1, y2};
+#endif
+    if (done < len) {
+      coefficients_.applyWithHistory(x + done, y + done, len - done, history);
+    }
+  }
+
+private:
+  static constexpr size_t HISTORY = 4;
+  static constexpr size_t COLUMNS = HISTORY + K;
+  static constexpr size_t ALIGNMENT = K * sizeof(T);
+
+  Coefficients coefficients_;
+  alignas(ALIGNMENT) T matrix_[COLUMNS * K];
+};
+
+} // namespace org::simple::dsp
+
+#endif // ORG_SIMPLE_DSP_M_BIQUAD_BLOCK_H
@@ -0,0 +1,362 @@
+#ifndef ORG_SIMPLE_DSP_M_BIQUAD_CASCADE_H
+#define ORG_SIMPLE_DSP_M_BIQUAD_CASCADE_H
+/*
+ * org-simple/dsp/BiquadCascade.h
+ *
+ * Added by michel on 2026-10-16
+ * Copyright (C) 2015-2026 Michel Fleur.
+ * Source https://github.com/emmef/org-simple
+ * Email org-simple@emmef.org
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <org-simple/AlignedAllocator.h>
+#include <org-simple/NumKernels.h>
+#include <org-simple/SampleLayout.h>
+#include <org-simple/dsp/Biquad.h>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace org::simple::dsp {
+
+/**
+ * A cascade of biquad sections for a number of channels, where each channel
+ * and section have their own coefficients and history.
+ *
+ * The recursion of a biquad prevents vectorization along time, but channels
+ * are independent. The cascade therefore stores coefficients and history as a
+ * structure of arrays: each of the five coefficients and four history values
+ * of a section is an array of GROUP channels, that is one vector. Blocks of
+ * frames of a group of channels are interleaved into a vector per frame and
+ * run through all sections, before they are deinterleaved into the outputs.
+ * A group of channels thus costs about as much as a single channel with
+ * BiQuad::Coefficients::applyWithHistory().
+ *
+ * A group that is wider than the vectors of the target is filtered as
+ * independent vectors of the target width, so that the recursions overlap.
+ * Eight channels suit 128-bit vectors, sixteen suit AVX-512.
+ *
+ * If the number of channels is not a multiple of GROUP, the last group has
+ * lanes with identity coefficients and zero input, that are never output.
+ * @tparam T The floating-point type of samples, coefficients and history.
+ * @tparam GROUP The number of channels that are processed as a vector, a
+ * power of two between two and sixteen.
+ */
+template <typename T, size_t GROUP = 8> class BiQuadCascade {
+  static_assert(std::is_floating_point_v<T>);
+  static_assert(std::has_single_bit(GROUP) && GROUP >= 2 && GROUP <= 16,
+                "GROUP must be 2, 4, 8 or 16");
+
+public:
+  using Coefficients = BiQuad::Coefficients<T>;
+  using History = BiQuad::History<T>;
+  static constexpr size_t ALIGNMENT = GROUP * sizeof(T);
+  /**
+   * The number of frames that is interleaved and filtered at once.
+   */
+  static constexpr size_t BLOCK_FRAMES = 64;
+
+  /**
+   * Creates a cascade of \c sections identity sections for \c channels
+   * channels, with a history of zero.
+   * @throws std::invalid_argument if channels or sections is zero.
+   */
+  BiQuadCascade(size_t channels, size_t sections)
+      : channels_(valid(channels, "channels")),
+        sections_(valid(sections, "sections")),
+        groups_((channels + GROUP - 1) / GROUP),
+        coefficients_(groups_ * sections_ * COEFFICIENTS * GROUP, T(0)),
+        history_(groups_ * sections_ * HISTORY * GROUP, T(0)),
+        block_(BLOCK_FRAMES * GROUP, T(0)) {
+    for (size_t section = 0; section < sections_; section++) {
+      setLanes(section, Coefficients(), groups_ * GROUP);
+    }
+  }
+
+  size_t channels() const { return channels_; }
+  size_t sections() const { return sections_; }
+  size_t groups() const { return groups_; }
+
+  /**
+   * Sets the coefficients of \c section for all channels.
+   * @throws std::out_of_range if the section does not exist.
+   */
+  void setCoefficients(size_t section, const Coefficients &coefficients) {
+    setLanes(checkedSection(section), coefficients, channels_);
+  }
+
+  /**
+   * Sets the coefficients of \c section for \c channel only.
+   * @throws std::out_of_range if the channel or section does not exist.
+   */
+  void setCoefficients(size_t channel, size_t section,
+                       const Coefficients &coefficients) {
+    set(coefficients_, COEFFICIENTS, checkedChannel(channel),
+        checkedSection(section),
+        {coefficients.b0, coefficients.b1, coefficients.b2, coefficients.a1,
+         coefficients.a2});
+  }
+
+  Coefficients coefficients(size_t channel, size_t section) const {
+    const T *c = coefficients_.data() + offset(COEFFICIENTS,
+                                               checkedChannel(channel),
+                                               checkedSection(section));
+    Coefficients result;
+    result.b0 = c[0];
+    result.b1 = c[GROUP];
+    result.b2 = c[2 * GROUP];
+    result.a1 = c[3 * GROUP];
+    result.a2 = c[4 * GROUP];
+    return result;
+  }
+
+  /**
+   * Sets the history of \c section for \c channel, for example to continue
+   * where a filter with BiQuad::Coefficients::applyWithHistory() left off.
+   * @throws std::out_of_range if the channel or section does not exist.
+   */
+  void setHistory(size_t channel, size_t section, const History &history) {
+    set(history_, HISTORY, checkedChannel(channel), checkedSection(section),
+        {history.x1, history.x2, history.y1, history.y2});
+  }
+
+  History history(size_t channel, size_t section) const {
+    const T *h = history_.data() + offset(HISTORY, checkedChannel(channel),
+                                          checkedSection(section));
+    return {h[0], h[GROUP], h[2 * GROUP], h[3 * GROUP]};
+  }
+
+  /**
+   * Sets the history of all channels and sections to zero.
+   */
+  void zero() { std::fill(history_.begin(), history_.end(), T(0)); }
+
+  /**
+   * Filters \c frames frames of the channel buffers in \c inputs through all
+   * sections into the channel buffers in \c outputs, that may be the same as
+   * the inputs. The history is kept for the next call.
+   */
+  void apply(const T *const *inputs, T *const *outputs, size_t frames) {
+    for (size_t group = 0; group < groups_; group++) {
+      const size_t first = group * GROUP;
+      const size_t count = std::min(GROUP, channels_ - first);
+      const T *coefficients =
+          coefficients_.data() + group * sections_ * COEFFICIENTS * GROUP;
+      T *history = history_.data() + group * sections_ * HISTORY * GROUP;
+      if (count < GROUP) {
+        // The padding lanes still hold the output of the previous group.
+        // Identity sections keep zero input and history at zero, so they are
+        // cleared once for all blocks of this group.
+        std::fill(block_.begin(), block_.end(), T(0));
+      }
+      for (size_t frame = 0; frame < frames; frame += BLOCK_FRAMES) {
+        const size_t block = std::min(BLOCK_FRAMES, frames - frame);
+        const T *const *input = inputBlock(inputs + first, count, frame);
+        if (count == GROUP) {
+          sample_layout::interleave<GROUP>(input, block_.data(), GROUP, block,
+                                           GROUP);
+        } else {
+          sample_layout::interleave<0>(input, block_.data(), count, block,
+                                       GROUP);
+        }
+        for (size_t section = 0; section < sections_; section++) {
+          filter(coefficients + section * COEFFICIENTS * GROUP,
+                 history + section * HISTORY * GROUP, block_.data(), block);
+        }
+        T *const *output = outputBlock(outputs + first, count, frame);
+        if (count == GROUP) {
+          sample_layout::deinterleave<GROUP>(block_.data(), GROUP, output,
+                                             GROUP, block);
+        } else {
+          sample_layout::deinterleave<0>(block_.data(), GROUP, output, count,
+                                         block);
+        }
+      }
+    }
+  }
+
+  /**
+   * Returns the interleaved frames of the last block that was filtered, with
+   * GROUP values per frame, including the padding lanes of a partial group.
+   */
+  const T *block() const { return block_.data(); }
+
+private:
+  static constexpr size_t COEFFICIENTS = 5;
+  static constexpr size_t HISTORY = 4;
+  using Storage = std::vector<T, AlignedAllocator<T, ALIGNMENT>>;
+  // The width in bytes of the widest vectors of the target
+  static constexpr size_t NATIVE_WIDTH =
+#if defined(__AVX512F__)
+      64;
+#elif defined(__AVX__)
+      32;
+#else
+      16;
+#endif
+
+  size_t channels_;
+  size_t sections_;
+  size_t groups_;
+  Storage coefficients_;
+  Storage history_;
+  Storage block_;
+  const T *inputPointers_[GROUP];
+  T *outputPointers_[GROUP];
+
+  static size_t valid(size_t value, const char *what) {
+    if (value == 0) {
+      throw std::invalid_argument(std::string("BiQuadCascade: number of ") +
+                                  what + " must be positive");
+    }
+    return value;
+  }
+
+  size_t checkedChannel(size_t channel) const {
+    if (channel >= channels_) {
+      throw std::out_of_range("BiQuadCascade: channel out of range");
+    }
+    return channel;
+  }
+
+  size_t checkedSection(size_t section) const {
+    if (section >= sections_) {
+      throw std::out_of_range("BiQuadCascade: section out of range");
+    }
+    return section;
+  }
+
+  /**
+   * Returns the offset of the first of the \c size values of \c channel and
+   * \c section, where consecutive values are GROUP elements apart.
+   */
+  size_t offset(size_t size, size_t channel, size_t section) const {
+    return ((channel / GROUP) * sections_ + section) * size * GROUP +
+           channel % GROUP;
+  }
+
+  template <size_t N>
+  void set(Storage &storage, size_t size, size_t channel, size_t section,
+           const T (&v)[N]) {
+    T *destination = storage.data() + offset(size, channel, section);
+    for (size_t i = 0; i < N; i++) {
+      destination[i * GROUP] = v[i];
+    }
+  }
+
+  /**
+   * Sets the coefficients of \c section for the first \c lanes channels,
+   * where lanes beyond the number of channels are the padding of the last
+   * group.
+   */
+  void setLanes(size_t section, const Coefficients &coefficients,
+                size_t lanes) {
+    for (size_t channel = 0; channel < lanes; channel++) {
+      set(coefficients_, COEFFICIENTS, channel, section,
+          {coefficients.b0, coefficients.b1, coefficients.b2, coefficients.a1,
+           coefficients.a2});
+    }
+  }
+
+  const T *const *inputBlock(const T *const *inputs, size_t count,
+                             size_t frame) {
+    for (size_t i = 0; i < count; i++) {
+      inputPointers_[i] = inputs[i] + frame;
+    }
+    return inputPointers_;
+  }
+
+  T *const *outputBlock(T *const *outputs, size_t count, size_t frame) {
+    for (size_t i = 0; i < count; i++) {
+      outputPointers_[i] = outputs[i] + frame;
+    }
+    return outputPointers_;
+  }
+
+  /**
+   * Filters \c frames frames of GROUP channels in \c block, in place, with
+   * the coefficients and history of a single section, in the same order of
+   * operations as BiQuad::Coefficients::applyWithHistory(). Each of the N
+   * vectors of a frame is a separate recursion.
+   */
+  static void filter(const T *coefficients, T *history, T *block,
+                     size_t frames) {
+#if defined(__GNUC__)
+    static constexpr size_t WIDTH = std::min(GROUP * sizeof(T), NATIVE_WIDTH);
+    static constexpr size_t N = GROUP * sizeof(T) / WIDTH;
+    using V = typename num_kernels::Vector<T, WIDTH, WIDTH>::type;
+    const V *c = reinterpret_cast<const V *>(coefficients);
+    V *h = reinterpret_cast<V *>(history);
+    V *samples = reinterpret_cast<V *>(block);
+    V x1[N], x2[N], y1[N], y2[N];
+    for (size_t i = 0; i < N; i++) {
+      x1[i] = h[i];
+      x2[i] = h[N + i];
+      y1[i] = h[2 * N + i];
+      y2[i] = h[3 * N + i];
+    }
+    for (size_t frame = 0; frame < frames; frame++, samples += N) {
+#pragma GCC unroll 16
+      for (size_t i = 0; i < N; i++) {
+        const V x = samples[i];
+        const V y = c[i] * x + c[N + i] * x1[i] + c[2 * N + i] * x2[i] +
+                    c[3 * N + i] * y1[i] + c[4 * N + i] * y2[i];
+        samples[i] = y;
+        x2[i] = x1[i];
+        x1[i] = x;
+        y2[i] = y1[i];
+        y1[i] = y;
+      }
+    }
+    for (size_t i = 0; i < N; i++) {
+      h[i] = x1[i];
+      h[N + i] = x2[i];
+      h[2 * N + i] = y1[i];
+      h[3 * N + i] = y2[i];
+    }
+#else
+    for (size_t lane = 0; lane < GROUP; lane++) {
+      const T *c = coefficients + lane;
+      T *h = history + lane;
+      T x1 = h[0];
+      T x2 = h[GROUP];
+      T y1 = h[2 * GROUP];
+      T y2 = h[3 * GROUP];
+      for (size_t frame = 0; frame < frames; frame++) {
+        T &sample = block[frame * GROUP + lane];
+        const T x = sample;
+        const T y = c[0] * x + c[GROUP] * x1 + c[2 * GROUP] * x2 +
+                    c[3 * GROUP] * y1 + c[4 * GROUP] * y2;
+        sample = y;
+        x2 = x1;
+        x1 = x;
+        y2 = y1;
+        y1 = y;
+      }
+      h[0] = x1;
+      h[GROUP] = x2;
+      h[2 * GROUP] = y1;
+      h[3 * GROUP] = y2;
+    }
+#endif
+  }
+};
+
+} // namespace org::simple::dsp
+
+#endif // ORG_SIMPLE_DSP_M_BIQUAD_CASCADE_H
@@ -0,0 +1,207 @@
+#ifndef ORG_SIMPLE_DSP_M_BIQUAD_TOPOLOGY_H
+#define ORG_SIMPLE_DSP_M_BIQUAD_TOPOLOGY_H
+/*
+ * org-simple/dsp/BiquadTopology.h
+ *
+ * Added by michel on 2026-10-16
+ * Copyright (C) 2015-2026 Michel Fleur.
+ * Source https://github.com/emmef/org-simple
+ * Email org-simple@emmef.org
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cmath>
+#include <cstddef>
+#include <org-simple/dsp/Biquad.h>
+#include <stdexcept>
+
+namespace org::simple::dsp {
+
+/*
+ * Topologies that implement the filter of BiQuad::Coefficients in different
+ * ways. They have the same interface, so that code can select one with a
+ * template parameter:
+ * - A constructor from BiQuad::Coefficients.
+ * - A nested \c State<V> with the values that a filter keeps between
+ *   samples, that is zero when default constructed.
+ * - \c run(state, x) that filters a single sample.
+ * - \c apply(x, y, len, state) that filters a block of samples.
+ * As in BiQuad, the value type V can be floating point, but also a numerical
+ * vector or something.
+ */
+
+/**
+ * The direct form I of BiQuad::Coefficients itself, with four history values.
+ * It rounds only the products with the coefficients and the output, but with
+ * poles close to one the feedback of the rounded outputs dominates.
+ */
+template <typename F> class BiQuadDirectForm1 {
+  BiQuad::Coefficients<F> coefficients_;
+
+public:
+  template <class V> using State = BiQuad::History<V>;
+
+  explicit BiQuadDirectForm1(const BiQuad::Coefficients<F> &coefficients)
+      : coefficients_(coefficients) {}
+
+  template <class V> V run(State<V> &state, const V &x) const {
+    return coefficients_.runAndGet(state, x);
+  }
+
+  template <class V>
+  void apply(const V *__restrict x, V *__restrict y, size_t len,
+             State<V> &state) const {
+    coefficients_.applyWithHistory(x, y, len, state);
+  }
+};
+
+/**
+ * The transposed direct form II, that has only two state values: the partial
+ * sums of the outputs of the next two samples. It needs half the state of
+ * the direct form I, but for filters with poles close to one, like a
+ * high-pass with a low cut-off frequency, these partial sums are large
+ * compared to the output and it is hardly more precise.
+ */
+template <typename F> class BiQuadTransposedDirectForm2 {
+  F b0, b1, b2, a1, a2;
+
+public:
+  template <class V> struct State {
+    V s1 = 0;
+    V s2 = 0;
+
+    void zero() { *this = {}; }
+  };
+
+  explicit BiQuadTransposedDirectForm2(
+      const BiQuad::Coefficients<F> &coefficients)
+      : b0(coefficients.b0), b1(coefficients.b1), b2(coefficients.b2),
+        a1(coefficients.a1), a2(coefficients.a2) {}
+
+  template <class V> V run(State<V> &state, const V &x) const {
+    const V y = b0 * x + state.s1;
+    state.s1 = b1 * x + a1 * y + state.s2;
+    state.s2 = b2 * x + a2 * y;
+    return y;
+  }
+
+  template <class V>
+  void apply(const V *__restrict x, V *__restrict y, size_t len,
+             State<V> &state) const {
+    V s1 = state.s1;
+    V s2 = state.s2;
+    for (size_t i = 0; i < len; i++) {
+      const V input = x[i];
+      const V output = b0 * input + s1;
+      s1 = b1 * input + a1 * output + s2;
+      s2 = b2 * input + a2 * output;
+      y[i] = output;
+    }
+    state.s1 = s1;
+    state.s2 = s2;
+  }
+};
+
+/**
+ * The state variable filter with trapezoidal integrators of Andrew Simper
+ * (Cytomic, "Linear Trapezoidal Integrated State Variable Filter"). Its two
+ * states are the integrator values that are of the order of the band-pass
+ * and low-pass outputs, so that low frequencies lose no precision, and its
+ * parameters change smoothly with frequency.
+ *
+ * Any stable biquad maps on the filter: the denominator determines the
+ * integrator gain \c g and damping \c k, and the numerator the mix of
+ * input, band-pass and low-pass outputs. That is calculated in double
+ * precision when the filter is created.
+ */
+template <typename F> class BiQuadStateVariable {
+  // Integrator coefficients
+  F g1, g2, g3;
+  // Mix of input, band-pass and low-pass outputs
+  F m0, m1, m2;
+
+public:
+  template <class V> struct State {
+    V ic1 = 0;
+    V ic2 = 0;
+
+    void zero() { *this = {}; }
+  };
+
+  /**
+   * Creates the state variable filter for \c coefficients.
+   * @throws std::invalid_argument if the coefficients do not describe a stable
+   * filter.
+   */
+  explicit BiQuadStateVariable(const BiQuad::Coefficients<F> &coefficients) {
+    const double a1 = coefficients.a1;
+    const double a2 = coefficients.a2;
+    const double b0 = coefficients.b0;
+    const double b1 = coefficients.b1;
+    const double b2 = coefficients.b2;
+    // The denominator of the bilinear transform of the analog state variable
+    // filter, divided by its constant term d, at z = 1 and z = -1.
+    const double atOne = 1.0 - a1 - a2;
+    const double atMinusOne = 1.0 + a1 - a2;
+    if (!(atOne > 0 && atMinusOne > 0 && a2 > -1.0)) {
+      throw std::invalid_argument(
+          "BiQuadStateVariable: coefficients of an unstable filter");
+    }
+    const double g = std::sqrt(atOne / atMinusOne);
+    const double d = 4.0 / atMinusOne;
+    const double gk = 1.0 + g * g + a2 * d;
+    const double inputMix = d * (b0 - b1 + b2) / 4.0;
+    const double lowPassMix = d * (b0 + b1 + b2) / (4.0 * g * g) - inputMix;
+    const double bandPassMix =
+        (d * (b0 - b2) - 2.0 * inputMix * gk) / (2.0 * g);
+    const double first = 1.0 / (1.0 + g * g + gk);
+    g1 = static_cast<F>(first);
+    g2 = static_cast<F>(g * first);
+    g3 = static_cast<F>(g * g * first);
+    m0 = static_cast<F>(inputMix);
+    m1 = static_cast<F>(bandPassMix);
+    m2 = static_cast<F>(lowPassMix);
+  }
+
+  template <class V> V run(State<V> &state, const V &x) const {
+    const V v3 = x - state.ic2;
+    const V v1 = g1 * state.ic1 + g2 * v3;
+    const V v2 = state.ic2 + g2 * state.ic1 + g3 * v3;
+    state.ic1 = F(2) * v1 - state.ic1;
+    state.ic2 = F(2) * v2 - state.ic2;
+    return m0 * x + m1 * v1 + m2 * v2;
+  }
+
+  template <class V>
+  void apply(const V *__restrict x, V *__restrict y, size_t len,
+             State<V> &state) const {
+    V ic1 = state.ic1;
+    V ic2 = state.ic2;
+    for (size_t i = 0; i < len; i++) {
+      const V input = x[i];
+      const V v3 = input - ic2;
+      const V v1 = g1 * ic1 + g2 * v3;
+      const V v2 = ic2 + g2 * ic1 + g3 * v3;
+      ic1 = F(2) * v1 - ic1;
+      ic2 = F(2) * v2 - ic2;
+      y[i] = m0 * input + m1 * v1 + m2 * v2;
+    }
+    state.ic1 = ic1;
+    state.ic2 = ic2;
+  }
+};
+
+} // namespace org::simple::dsp
+
+#endif // ORG_SIMPLE_DSP_M_BIQUAD_TOPOLOGY_H
@@ -0,0 +1,251 @@
+#ifndef ORG_SIMPLE_DSP_M_FILTFILT_H
+#define ORG_SIMPLE_DSP_M_FILTFILT_H
+/*
+ * org-simple/dsp/filtfilt.h
+ *
+ * Added by michel on 2026-10-16
+ * Copyright (C) 2015-2026 Michel Fleur.
+ * Source https://github.com/emmef/org-simple
+ * Email org-simple@emmef.org
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <cstddef>
+#include <org-simple/dsp/Biquad.h>
+#include <org-simple/dsp/iir-filter.h>
+#include <stdexcept>
+
+namespace org::simple::dsp {
+
+namespace zero_phase {
+
+/**
+ * The maximum order of filters, like that of iir-coefficients.h.
+ */
+static constexpr size_t MAX_ORDER = 31;
+
+/**
+ * The number of samples that is filtered at once, small enough to remain in
+ * the L1 cache with the samples of the filter itself.
+ */
+static constexpr size_t BLOCK = 512;
+
+/**
+ * Returns the number of samples that is added before and after the input:
+ * three times the number of coefficients, but less than the input.
+ */
+static constexpr size_t padding(size_t order, size_t count) {
+  return count ? std::min(3 * (order + 1), count - 1) : 0;
+}
+
+/**
+ * Filters \c count samples from \c in to \c out, that may be the same, with
+ * \c filter forward and then backward, so that the result has no phase shift
+ * and the magnitude response of the filter squared.
+ *
+ * Transients at the edges are avoided like filtfilt of SciPy and MATLAB does:
+ * - The input is extended at both ends with padding() samples that are
+ *   its odd extension, the mirror image point-reflected in the edge sample.
+ * - Each pass starts with the history of a filter that was fed with the first
+ *   sample of its input forever.
+ *
+ * Only the padding is stored separately. The forward pass writes \c out and
+ * the backward pass filters \c out in place, both through a block of BLOCK
+ * samples on the stack.
+ *
+ * The filter must provide:
+ * - \c order(), the order of the filter.
+ * - \c start(value), that sets the history to the steady state for a
+ *   constant input \c value.
+ * - \c forward(x, y, n) and \c backward(x, y, n), that filter at most BLOCK
+ *   samples forward and backward in time, continuing from the history.
+ */
+template <typename S, class Filter>
+void filtfilt(Filter &filter, const S *in, S *out, size_t count) {
+  if (count == 0) {
+    return;
+  }
+  const size_t pad = padding(filter.order(), count);
+  S before[3 * (MAX_ORDER + 1)];
+  S after[3 * (MAX_ORDER + 1)];
+  S block[BLOCK];
+  const S first = in[0];
+  const S last = in[count - 1];
+  for (size_t i = 0; i < pad; i++) {
+    before[i] = 2 * first - in[pad - i];
+    after[i] = 2 * last - in[count - 2 - i];
+  }
+
+  filter.start(pad ? before[0] : first);
+  filter.forward(before, block, pad);
+  for (size_t done = 0; done < count; done += BLOCK) {
+    const size_t n = std::min(BLOCK, count - done);
+    std::copy(in + done, in + done + n, block);
+    filter.forward(block, out + done, n);
+  }
+  filter.forward(after, before, pad);
+
+  filter.start(pad ? before[pad - 1] : out[count - 1]);
+  filter.backward(before, after, pad);
+  for (size_t end = count; end > 0;) {
+    const size_t n = std::min(BLOCK, end);
+    const size_t start = end - n;
+    std::copy(out + start, out + end, block);
+    filter.backward(block, out + start, n);
+    end = start;
+  }
+}
+
+/**
+ * Filter for filtfilt() with BiQuad::Coefficients.
+ */
+template <typename S, typename C> class BiQuadFilter {
+  const BiQuad::Coefficients<C> &coefficients_;
+  BiQuad::History<S> history_;
+  S gain_;
+
+public:
+  explicit BiQuadFilter(const BiQuad::Coefficients<C> &coefficients)
+      : coefficients_(coefficients) {
+    const C denominator = 1 - coefficients.a1 - coefficients.a2;
+    if (denominator == 0) {
+      throw std::invalid_argument(
+          "org::simple::dsp::filtfilt: filter has no steady state");
+    }
+    gain_ = (coefficients.b0 + coefficients.b1 + coefficients.b2) / denominator;
+  }
+
+  size_t order() const { return 2; }
+
+  void start(S value) {
+    history_ = {value, value, gain_ * value, gain_ * value};
+  }
+
+  void forward(const S *x, S *y, size_t n) {
+    coefficients_.applyWithHistory(x, y, n, history_);
+  }
+
+  void backward(const S *x, S *y, size_t n) {
+    coefficients_.applyBackwardsWithHistory(x, y, n, history_);
+  }
+};
+
+/**
+ * Filter for filtfilt() with the feed forward and feed backward coefficients
+ * of the functions in iir-filter.h. It filters in a buffer that has the
+ * history before the block when filtering forward and after the block when
+ * filtering backward, with filter_forward_oo() and filter_backward_oo().
+ */
+template <typename S, typename C> class CoefficientsFilter {
+  size_t order_;
+  const C *ff_;
+  const C *fb_;
+  S gain_;
+  // The history, where element zero is the most recently filtered sample.
+  S xHistory_[MAX_ORDER];
+  S yHistory_[MAX_ORDER];
+  S x_[MAX_ORDER + BLOCK];
+  S y_[MAX_ORDER + BLOCK];
+
+public:
+  CoefficientsFilter(size_t order, const C *ff_coeffs, const C *fb_coeffs)
+      : order_(order), ff_(ff_coeffs), fb_(fb_coeffs) {
+    if (order == 0 || order > MAX_ORDER) {
+      throw std::invalid_argument(
+          "org::simple::dsp::filtfilt: order must be between 1 and 31.");
+    }
+    C numerator = ff_coeffs[0];
+    C denominator = 1;
+    for (size_t j = 1; j <= order; j++) {
+      numerator += ff_coeffs[j];
+      denominator += fb_coeffs[j];
+    }
+    if (denominator == 0) {
+      throw std::invalid_argument(
+          "org::simple::dsp::filtfilt: filter has no steady state");
+    }
+    gain_ = numerator / denominator;
+  }
+
+  size_t order() const { return order_; }
+
+  void start(S value) {
+    std::fill(xHistory_, xHistory_ + order_, value);
+    std::fill(yHistory_, yHistory_ + order_, gain_ * value);
+  }
+
+  void forward(const S *x, S *y, size_t n) {
+    for (size_t j = 0; j < order_; j++) {
+      x_[order_ - 1 - j] = xHistory_[j];
+      y_[order_ - 1 - j] = yHistory_[j];
+    }
+    std::copy(x, x + n, x_ + order_);
+    filter_forward_oo(order_, n, ff_, fb_, x_, y_);
+    std::copy(y_ + order_, y_ + order_ + n, y);
+    for (size_t j = 0; j < order_; j++) {
+      xHistory_[j] = x_[order_ + n - 1 - j];
+      yHistory_[j] = y_[order_ + n - 1 - j];
+    }
+  }
+
+  void backward(const S *x, S *y, size_t n) {
+    for (size_t j = 0; j < order_; j++) {
+      x_[n + j] = xHistory_[j];
+      y_[n + j] = yHistory_[j];
+    }
+    std::copy(x, x + n, x_);
+    filter_backward_oo(order_, n, ff_, fb_, x_, y_);
+    std::copy(y_, y_ + n, y);
+    for (size_t j = 0; j < order_; j++) {
+      xHistory_[j] = x_[j];
+      yHistory_[j] = y_[j];
+    }
+  }
+};
+
+} // namespace zero_phase
+
+/**
+ * Filters \c count samples from \c in to \c out, that may be the same, with
+ * zero phase: forward and backward in time with \c coefficients. See
+ * zero_phase::filtfilt().
+ * @throws std::invalid_argument if the filter has a pole at zero frequency.
+ */
+template <typename S, typename C>
+void filtfilt(const BiQuad::Coefficients<C> &coefficients, const S *in, S *out,
+              size_t count) {
+  zero_phase::BiQuadFilter<S, C> filter(coefficients);
+  zero_phase::filtfilt(filter, in, out, count);
+}
+
+/**
+ * Filters \c count samples from \c in to \c out, that may be the same, with
+ * zero phase: forward and backward in time with the feed forward coefficients
+ * \c ff_coeffs and feed backward coefficients \c fb_coeffs of a filter of
+ * order \c order, like the other functions in iir-filter.h. See
+ * zero_phase::filtfilt().
+ * @throws std::invalid_argument if the order is zero or exceeds
+ * zero_phase::MAX_ORDER, or if the filter has a pole at zero frequency.
+ */
+template <typename S, typename C>
+void filtfilt(size_t order, const C *ff_coeffs, const C *fb_coeffs,
+              const S *in, S *out, size_t count) {
+  zero_phase::CoefficientsFilter<S, C> filter(order, ff_coeffs, fb_coeffs);
+  zero_phase::filtfilt(filter, in, out, count);
+}
+
+} // namespace org::simple::dsp
+
+#endif // ORG_SIMPLE_DSP_M_FILTFILT_H
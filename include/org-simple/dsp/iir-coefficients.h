@@ -21,11 +21,18 @@
  * limitations under the License.
  */
 
-#include <cstddef>
+#include <algorithm>
+#include <bit>
 #include <cmath>
+#include <cstddef>
+#include <limits>
+#include <memory>
 #include <org-simple/Index.h>
 #include <org-simple/ZeroNonNormal.h>
-#include <org-simple/Array.h>
+#include <org-simple/dsp/iir-filter.h>
+#include <stdexcept>
+#include <string>
+#include <vector>
 
 namespace org::simple::dsp {
 
@@ -290,6 +297,30 @@ class Coefficients : public CoefficientsFilter<coeff> {
     return static_cast<const CoefficientsClass *>(this)->getOrder_();
   }
 
+  /**
+   * Whether a fixed order has a FixedOrderKernel, that is then picked at
+   * compile time by the filter methods.
+   */
+  static constexpr bool UNROLLED =
+      FIXED_ORDER > 0 && FIXED_ORDER <= MAX_UNROLLED_ORDER;
+
+  /**
+   * Creates a kernel that, like the generic loops of the filter methods, does
+   * not flush outputs to zero, so that results do not depend on the order.
+   */
+  template <typename S>
+  FixedOrderKernel<S, coeff, FIXED_ORDER, 1, false>
+  createKernel(const S *__restrict xHistory,
+               const S *__restrict yHistory) const {
+    coeff ff[FIXED_ORDER + 1];
+    coeff fb[FIXED_ORDER + 1];
+    for (size_t j = 0; j <= FIXED_ORDER; j++) {
+      ff[j] = getFF_(j);
+      fb[j] = getFB_(j);
+    }
+    return {ff, fb, xHistory, yHistory};
+  }
+
 protected:
   [[nodiscard]] unsigned getValidOrder() const final { return getOrder_(); }
   void setValidFF(size_t i, coeff value) final { getFF_(i) = value; }
@@ -357,6 +388,17 @@ public:
   template <typename S>
   void filter_forward_offs(size_t count, const S *__restrict in,
                            S *__restrict out) const {
+    if constexpr (UNROLLED) {
+      S xHistory[FIXED_ORDER];
+      S yHistory[FIXED_ORDER];
+      for (size_t i = 0; i < FIXED_ORDER; i++) {
+        xHistory[i] = in[FIXED_ORDER - 1 - i];
+        yHistory[i] = out[FIXED_ORDER - 1 - i];
+      }
+      createKernel(xHistory, yHistory)
+          .forward(count, in + FIXED_ORDER, out + FIXED_ORDER);
+      return;
+    }
     size_t order;
     if constexpr (FIXED_ORDER == 0) {
       order = getOrder_();
@@ -386,6 +428,11 @@ public:
   template <typename S>
   void filter_forward_history_zero(size_t count, const S *__restrict in,
                                    S *__restrict out) const {
+    if constexpr (UNROLLED) {
+      const S history[FIXED_ORDER] = {};
+      createKernel(history, history).forward(count, in, out);
+      return;
+    }
     size_t order;
     if constexpr (FIXED_ORDER == 0) {
       order = getOrder_();
@@ -426,7 +473,10 @@ public:
   template <typename S>
   void filter_backward_offs(size_t count, const S *__restrict in,
                             S *__restrict out) const {
-
+    if constexpr (UNROLLED) {
+      createKernel(in + count, out + count).backward(count, in, out);
+      return;
+    }
     size_t order;
     if constexpr (FIXED_ORDER == 0) {
       order = getOrder_();
@@ -455,6 +505,11 @@ public:
   template <typename S>
   void filter_backward_history_zero(size_t count, const S *__restrict in,
                                     S *__restrict out) const {
+    if constexpr (UNROLLED) {
+      const S history[FIXED_ORDER] = {};
+      createKernel(history, history).backward(count, in, out);
+      return;
+    }
     size_t order;
     if constexpr (FIXED_ORDER == 0) {
       order = getOrder_();
@@ -546,7 +601,7 @@ class FixedOrderCoefficients
   static_assert(O <= 32, "Filter order cannot exceed 32.");
   static constexpr size_t FF = 0;
   static constexpr size_t FB = O + 1;
-  Array<C, 2 * (O + 1), A> coeffs;
+  alignas(A ? A : alignof(C)) C coeffs[2 * (O + 1)] = {};
 
 protected:
   inline const C &getFB_(size_t i) const { return coeffs[i + FB]; }
@@ -566,7 +621,7 @@ class FixedOrderCoefficientsRef
   static_assert(O <= 32, "Filter order cannot exceed 32.");
   static constexpr size_t FF = 0;
   static constexpr size_t FB = O + 1;
-  ArrayDataRefFixedSize<C, 2 * (O + 1), A> coeffs;
+  C *const coeffs;
 
 protected:
   inline const C &getFB_(size_t i) const { return coeffs[i + FB]; }
@@ -607,7 +662,7 @@ size_t effectiveIRLength(const CoefficientsFilter<S> &filter, size_t maxLength,
     const CoefficientsFilter<S> &filter_;
     size_t coeffs_;
     size_t era_;
-    org::simple::ArrayAllocated<S> data_;
+    std::vector<S> data_;
     bool firstSample_;
 
     S getSample() {
@@ -622,14 +677,10 @@ size_t effectiveIRLength(const CoefficientsFilter<S> &filter, size_t maxLength,
     FilterState(const CoefficientsFilter<S> &filter)
         : filter_(filter), coeffs_(filter.getCoefficientCount()),
           era_(2 * coeffs_ + values_), data_(era_ * eras_), firstSample_(true) {
-      S *p;
-      for (p = data_.begin(); p < data_.end(); p++) {
-        *p = 0.0;
-      }
     }
 
     S output() {
-      return filter_.single(data_.begin(), data_ + coeffs_, getSample());
+      return filter_.single(data_.data(), data_.data() + coeffs_, getSample());
     }
 
     void storeBlock(S value) { data_[2 * coeffs_] = value; }
@@ -638,17 +689,17 @@ size_t effectiveIRLength(const CoefficientsFilter<S> &filter, size_t maxLength,
     S loadTotal() const { return data_[2 * coeffs_ + 1]; }
 
     void nextEra() {
-      S *to = data_.end();
+      S *to = data_.data() + data_.size();
       const S *from = to - era_;
-      while (from > data_.begin()) {
+      while (from > data_.data()) {
         *--to = *--from;
       }
     }
 
     void previousEra() {
-      S *to = data_.begin();
+      S *to = data_.data();
       const S *from = to + era_;
-      const S *end = data_.end();
+      const S *end = data_.data() + data_.size();
       while (from < end) {
         *++to = *++from;
       }
@@ -21,12 +21,31 @@
  * limitations under the License.
  */
 
+#include <cmath>
 #include <cstddef>
+#include <limits>
 #include <org-simple/ZeroNonNormal.h>
 #include <type_traits>
+#include <utility>
 
 namespace org::simple::dsp {
 
+/**
+ * Returns zero if \c value is a subnormal floating point value and \c value
+ * otherwise, so that a decaying recursive filter does not continue with slow
+ * subnormal values, also when ZeroNonNormal is not in effect.
+ * @tparam S The type of sample.
+ * @param value The value to flush.
+ * @return Zero or the value.
+ */
+template <typename S> static inline S flush_to_zero(const S value) {
+  if constexpr (std::is_floating_point_v<S>) {
+    return std::abs(value) < std::numeric_limits<S>::min() ? S(0) : value;
+  } else {
+    return value;
+  }
+}
+
 /**
  * Filters a single sample using the feed forward coefficients \c ff_coeffs,
  * feed backward coefficients \c fb_coeffs, sample histories for input and
@@ -404,6 +423,212 @@ void filter_backward_zp(size_t order, size_t count,
   }
 }
 
+/**
+ * The maximum order of filters with a fully unrolled FixedOrderKernel.
+ */
+static constexpr size_t MAX_UNROLLED_ORDER = 8;
+
+/**
+ * Filters blocks of samples with a filter of order \c ORDER, where the
+ * coefficients and the history of inputs and outputs are kept in local
+ * variables for the whole block, so that they live in registers.
+ *
+ * Instead of shifting the history for every sample, like filter_single_fo()
+ * does, the history is a circular buffer of \c ORDER elements, where element
+ * \c K holds the sample that was filtered at a position \c K in a group of
+ * \c ORDER samples. The loop over samples is unrolled by \c ORDER, so that
+ * all indices are constant and nothing moves, and the history is only put in
+ * order again at the end of a block.
+ * @tparam S The type of sample.
+ * @tparam C The type of coefficients, which must be a floating point.
+ * @tparam ORDER The order of the filter, from 1 to MAX_UNROLLED_ORDER.
+ * @tparam FB_SIGN The sign convention of the feedback coefficients of the
+ * filter: -1 subtracts the feedback, like the other functions in this file,
+ * and 1 adds it, like Coefficients in iir-coefficients.h.
+ * @tparam FLUSH Whether outputs are flushed to zero, like the other functions
+ * in this file; Coefficients in iir-coefficients.h does not flush.
+ */
+template <typename S, typename C, size_t ORDER, int FB_SIGN = -1,
+          bool FLUSH = true>
+class FixedOrderKernel {
+  static_assert(std::is_floating_point_v<C>);
+  static_assert(ORDER > 0 && ORDER <= MAX_UNROLLED_ORDER);
+  static_assert(FB_SIGN == 1 || FB_SIGN == -1);
+  using Sequence = std::make_index_sequence<ORDER>;
+
+  C ff_[ORDER + 1];
+  C fb_[ORDER + 1];
+  S x_[ORDER];
+  S y_[ORDER];
+
+  /**
+   * Filters the sample at position \c K, where the history is summed from
+   * past to recent, so that the most recent output, that the next sample
+   * waits for, is added last.
+   */
+  template <size_t K> S step(const S input) {
+    S output = ff_[0] * input;
+    [&]<size_t... J>(std::index_sequence<J...>) {
+      ((output += ff_[ORDER - J] * x_[(K + J) % ORDER] +
+                  fb_[ORDER - J] * y_[(K + J) % ORDER]),
+       ...);
+    }(Sequence());
+    if constexpr (FLUSH) {
+      output = flush_to_zero(output);
+    }
+    x_[K] = input;
+    y_[K] = output;
+    return output;
+  }
+
+  template <ptrdiff_t STRIDE>
+  void run(size_t count, const S *__restrict in, S *__restrict out) {
+    size_t done = 0;
+    for (; done + ORDER <= count; done += ORDER) {
+      [&]<size_t... K>(std::index_sequence<K...>) {
+        ((out[STRIDE * ptrdiff_t(K)] = step<K>(in[STRIDE * ptrdiff_t(K)])),
+         ...);
+      }(Sequence());
+      in += STRIDE * ptrdiff_t(ORDER);
+      out += STRIDE * ptrdiff_t(ORDER);
+    }
+    const size_t remaining = count - done;
+    if (remaining == 0) {
+      return;
+    }
+    [&]<size_t... K>(std::index_sequence<K...>) {
+      ((K < remaining
+            ? void(out[STRIDE * ptrdiff_t(K)] =
+                       step<K>(in[STRIDE * ptrdiff_t(K)]))
+            : void()),
+       ...);
+    }(Sequence());
+    // Rotate, so that the most recent sample is the last element again.
+    S x[ORDER];
+    S y[ORDER];
+    for (size_t i = 0; i < ORDER; i++) {
+      x[i] = x_[(i + remaining) % ORDER];
+      y[i] = y_[(i + remaining) % ORDER];
+    }
+    for (size_t i = 0; i < ORDER; i++) {
+      x_[i] = x[i];
+      y_[i] = y[i];
+    }
+  }
+
+public:
+  /**
+   * Creates a kernel with the \c ORDER + 1 feed forward coefficients
+   * \c ff_coeffs and feed backward coefficients \c fb_coeffs and the
+   * history of inputs and outputs \c xHistory and \c yHistory (from recent to
+   * past), like filter_single_fo().
+   */
+  FixedOrderKernel(const C *__restrict ff_coeffs,
+                   const C *__restrict fb_coeffs, const S *__restrict xHistory,
+                   const S *__restrict yHistory) {
+    for (size_t j = 0; j <= ORDER; j++) {
+      ff_[j] = ff_coeffs[j];
+      fb_[j] = FB_SIGN * fb_coeffs[j];
+    }
+    for (size_t i = 0; i < ORDER; i++) {
+      x_[ORDER - 1 - i] = xHistory[i];
+      y_[ORDER - 1 - i] = yHistory[i];
+    }
+  }
+
+  /**
+   * Writes the history of inputs and outputs to \c xHistory and \c yHistory
+   * (from recent to past).
+   */
+  void getHistory(S *__restrict xHistory, S *__restrict yHistory) const {
+    for (size_t i = 0; i < ORDER; i++) {
+      xHistory[i] = x_[ORDER - 1 - i];
+      yHistory[i] = y_[ORDER - 1 - i];
+    }
+  }
+
+  /**
+   * Filters \c count samples from \c in to \c out, continuing from the
+   * history.
+   */
+  void forward(size_t count, const S *__restrict in, S *__restrict out) {
+    run<1>(count, in, out);
+  }
+
+  /**
+   * Filters \c count samples from \c in to \c out backwards in time, starting
+   * at offset \c count - 1 and continuing from the history, that holds the
+   * samples after the block.
+   */
+  void backward(size_t count, const S *__restrict in, S *__restrict out) {
+    if (count) {
+      run<-1>(count, in + count - 1, out + count - 1);
+    }
+  }
+};
+
+/**
+ * Filters \c count samples from an input buffer \c in to an output buffer \c
+ * out, starting at offset 0, using feed forward coefficients \c ff_coeffs,
+ * feed backward coefficients \c fb_coeffs and the sample histories for input
+ * and outputs \c xHistory and \c yHistory, that are updated afterwards. This
+ * uses a FixedOrderKernel, so that the history is not shifted for every
+ * sample, like filter_single_fo() does.
+ * @tparam S The type of sample.
+ * @tparam C The type of coefficients, which must be a floating point.
+ * @tparam ORDER The order of the filter, from 1 to MAX_UNROLLED_ORDER.
+ * @param count The number of samples to filter.
+ * @param ff_coeffs The filter feed-forward coefficients.
+ * @param fb_coeffs The filter feedback coefficients.
+ * @param in The input sample buffer, that must at least have a length of \c
+ * count.
+ * @param out The output sample buffer, that must at least have a length of \c
+ * count.
+ * @param xHistory The history of input samples (from recent to past).
+ * @param yHistory The history of output samples (from recent to past).
+ */
+template <typename S, typename C, size_t ORDER>
+void filter_forward_foh(size_t count, const C *__restrict ff_coeffs,
+                        const C *__restrict fb_coeffs, const S *__restrict in,
+                        S *__restrict out, S *__restrict xHistory,
+                        S *__restrict yHistory) {
+  FixedOrderKernel<S, C, ORDER> kernel(ff_coeffs, fb_coeffs, xHistory,
+                                       yHistory);
+  kernel.forward(count, in, out);
+  kernel.getHistory(xHistory, yHistory);
+}
+
+/**
+ * Filters \c count samples backwards in time from an input buffer \c in to an
+ * output buffer \c out, starting at offset \c count - 1, using feed forward
+ * coefficients \c ff_coeffs, feed backward coefficients \c fb_coeffs and the
+ * sample histories for input and outputs \c xHistory and \c yHistory, that
+ * hold the samples after the block and are updated afterwards. This uses a
+ * FixedOrderKernel.
+ * @tparam S The type of sample.
+ * @tparam C The type of coefficients, which must be a floating point.
+ * @tparam ORDER The order of the filter, from 1 to MAX_UNROLLED_ORDER.
+ * @param count The number of samples to filter.
+ * @param ff_coeffs The filter feed-forward coefficients.
+ * @param fb_coeffs The filter feedback coefficients.
+ * @param in The input sample buffer, that must at least have a length of \c
+ * count.
+ * @param out The output sample buffer, that must at least have a length of \c
+ * count.
+ * @param xHistory The history of input samples (from recent to past).
+ * @param yHistory The history of output samples (from recent to past).
+ */
+template <typename S, typename C, size_t ORDER>
+void filter_backward_foh(size_t count, const C *__restrict ff_coeffs,
+                         const C *__restrict fb_coeffs, const S *__restrict in,
+                         S *__restrict out, S *__restrict xHistory,
+                         S *__restrict yHistory) {
+  FixedOrderKernel<S, C, ORDER> kernel(ff_coeffs, fb_coeffs, xHistory,
+                                       yHistory);
+  kernel.backward(count, in, out);
+  kernel.getHistory(xHistory, yHistory);
+}
+
 } // namespace org::simple::dsp
 
 #endif // ORG_SIMPLE_DSP_M_IIR_FILTER_H
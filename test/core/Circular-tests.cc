@@ -4,6 +4,7 @@
 
 #include "boost-unit-tests.h"
 #include <org-simple/Circular.h>
+#include <random>
 
 namespace {
 
@@ -245,4 +246,114 @@ BOOST_AUTO_TEST_CASE(testMetricSetSizeHalf) {
                       "Setting size to half, yields half size");
 }
 
+template <bool INT128> static void checkFastModuloMatchesModulo() {
+  const size_t divisors[] = {1,    2,    3,    7,          13,
+                             1000, 1024, 4099, 1000000007, (size_t(1) << 40) + 1};
+  const size_t values[] = {0,
+                           1,
+                           12,
+                           999,
+                           1000,
+                           123456789,
+                           size_t(1) << 32,
+                           (size_t(1) << 63) + 12345,
+                           std::numeric_limits<size_t>::max() - 1,
+                           std::numeric_limits<size_t>::max()};
+  for (size_t divisor : divisors) {
+    org::simple::FastModulo<size_t, INT128> modulo(divisor);
+    for (size_t value : values) {
+      BOOST_CHECK_EQUAL(value % divisor, modulo.remainder(value));
+    }
+  }
+}
+
+template <bool INT128> static void checkFastModuloMatchesModulo32() {
+  const uint32_t divisors[] = {1, 3, 13, 1000, 65537, 4000000000u, 4294967295u};
+  const uint32_t values[] = {0,     1,          12,         999,
+                             65536, 4000000000u, 4294967294u, 4294967295u};
+  for (uint32_t divisor : divisors) {
+    org::simple::FastModulo<uint32_t, INT128> modulo(divisor);
+    for (uint32_t value : values) {
+      BOOST_CHECK_EQUAL(value % divisor, modulo.remainder(value));
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(testFastModuloMatchesModulo) {
+  checkFastModuloMatchesModulo<org::simple::FAST_MODULO_INT128>();
+}
+
+BOOST_AUTO_TEST_CASE(testFastModuloMatchesModulo32) {
+  checkFastModuloMatchesModulo32<org::simple::FAST_MODULO_INT128>();
+}
+
+BOOST_AUTO_TEST_CASE(testFastModuloWithoutInt128) {
+  using Wide = org::simple::FastModulo<size_t, false>;
+  using Narrow = org::simple::FastModulo<uint32_t, false>;
+  static_assert(!Wide::ENABLED);
+  static_assert(Narrow::ENABLED);
+  static_assert(sizeof(Narrow::magic_type) == sizeof(uint64_t));
+  checkFastModuloMatchesModulo<false>();
+  checkFastModuloMatchesModulo32<false>();
+  std::minstd_rand random;
+  for (int i = 0; i < 10000; i++) {
+    uint32_t divisor = uint32_t(random()) | 1u;
+    uint32_t value = uint32_t(random()) << 1 ^ uint32_t(random());
+    BOOST_CHECK_EQUAL(value % divisor, Narrow(divisor).remainder(value));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(testFastModuloFixedMetric) {
+  using Fixed = org::simple::Circular::FixedMetric<
+      org::simple::WrappingType::FAST_MODULO, requestedSize>;
+  static_assert(Fixed::wrapped(requestedSize + 3) == 3);
+  BOOST_CHECK_EQUAL(requestedSize, Fixed::elements());
+  for (size_t i = 0; i < 5 * requestedSize; i++) {
+    BOOST_CHECK_EQUAL(i % requestedSize, Fixed::wrapped(i));
+  }
+}
+
+template <org::simple::WrappingType wrappingType>
+static void checkModuloArithmetic() {
+  using Modulo = org::simple::Circular::Metric<wrappingType>;
+  Modulo m(requestedSize);
+  BOOST_CHECK_EQUAL(requestedSize, m.elements());
+  size_t actual = 0;
+  size_t unsafeActual = 0;
+  for (size_t i = 1; i <= 2 * requestedSize; i++) {
+    actual = m.inc(actual);
+    unsafeActual = m.unsafe_inc(unsafeActual);
+    BOOST_CHECK_EQUAL(i % requestedSize, actual);
+    BOOST_CHECK_EQUAL(i % requestedSize, unsafeActual);
+  }
+  actual = 0;
+  unsafeActual = 0;
+  for (size_t i = 1; i <= 2 * requestedSize; i++) {
+    actual = m.dec(actual);
+    unsafeActual = m.unsafe_dec(unsafeActual);
+    size_t expected = (requestedSize - i % requestedSize) % requestedSize;
+    BOOST_CHECK_EQUAL(expected, actual);
+    BOOST_CHECK_EQUAL(expected, unsafeActual);
+  }
+  for (size_t index = 0; index < requestedSize; index++) {
+    for (size_t delta = 0; delta <= requestedSize; delta++) {
+      size_t sum = (index + delta) % requestedSize;
+      size_t difference =
+          (index + requestedSize - delta % requestedSize) % requestedSize;
+      BOOST_CHECK_EQUAL(sum, m.unsafe_add(index, delta));
+      BOOST_CHECK_EQUAL(sum, m.add(index + requestedSize, delta));
+      BOOST_CHECK_EQUAL(difference, m.unsafe_sub(index, delta));
+      BOOST_CHECK_EQUAL(difference, m.sub(index, delta + requestedSize));
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(testModuloArithmetic) {
+  checkModuloArithmetic<org::simple::WrappingType::MODULO>();
+}
+
+BOOST_AUTO_TEST_CASE(testFastModuloArithmetic) {
+  checkModuloArithmetic<org::simple::WrappingType::FAST_MODULO>();
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,192 @@
+//
+// Created by michel on 15-10-26.
+//
+
+#include "boost-unit-tests.h"
+#include <boost/mpl/list.hpp>
+#include <org-simple/CircularBuffer.h>
+
+using namespace org::simple;
+
+namespace {
+
+static constexpr size_t ELEMENTS = 37;
+static constexpr size_t BLOCK = 8;
+
+template <WrappingType type> struct VariableMetric {
+  using Buffer = CircularBuffer<double, Circular::Metric<type>>;
+  static Buffer create() { return Buffer(ELEMENTS, BLOCK); }
+};
+
+struct FixedMetric {
+  using Metric = Circular::FixedMetric<WrappingType::FAST_MODULO, ELEMENTS>;
+  using Buffer = CircularBuffer<double, Metric>;
+  static Buffer create() { return Buffer(Metric(), BLOCK); }
+};
+
+typedef boost::mpl::list<VariableMetric<WrappingType::BIT_MASK>,
+                         VariableMetric<WrappingType::MODULO>,
+                         VariableMetric<WrappingType::FAST_MODULO>, FixedMetric>
+    metricTypes;
+
+/*
+ * Writes a ramp, where each sample is its own position, in blocks of varying
+ * size, so that writes wrap at various offsets. Returns the number of samples
+ * written.
+ */
+template <class Buffer> size_t writeRamp(Buffer &buffer, size_t blocks) {
+  size_t written = 0;
+  double block[BLOCK];
+  for (size_t b = 0; b < blocks; b++) {
+    size_t count = 1 + b % BLOCK;
+    for (size_t i = 0; i < count; i++) {
+      block[i] = written + i;
+    }
+    buffer.write(block, count);
+    written += count;
+  }
+  return written;
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(org_simple_CircularBuffer)
+
+BOOST_AUTO_TEST_CASE(testBlockMustFit) {
+  BOOST_CHECK_THROW(CircularBuffer<float>(10, 8), std::invalid_argument);
+  BOOST_CHECK_THROW(CircularBuffer<float>(10, 0), std::invalid_argument);
+  BOOST_CHECK_NO_THROW(CircularBuffer<float>(10, 7));
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(testReadAtDelays, Type, metricTypes) {
+  auto buffer = Type::create();
+  double block[BLOCK];
+
+  size_t total = 0;
+  for (size_t b = 0; b < 3 * ELEMENTS; b++) {
+    size_t count = 1 + b % BLOCK;
+    double input[BLOCK];
+    for (size_t i = 0; i < count; i++) {
+      input[i] = total + i;
+    }
+    buffer.write(input, count);
+    total += count;
+    for (size_t delay = 0; delay + BLOCK <= buffer.elements() &&
+                           delay + BLOCK <= total;
+         delay++) {
+      buffer.read(block, BLOCK, delay);
+      auto window = buffer.window(delay, BLOCK);
+      for (size_t i = 0; i < BLOCK; i++) {
+        double expected = double(total - BLOCK - delay + i);
+        BOOST_CHECK_EQUAL(expected, block[i]);
+        BOOST_CHECK_EQUAL(expected, window[i]);
+      }
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(testReadTaps, Type, metricTypes) {
+  auto buffer = Type::create();
+  size_t total = writeRamp(buffer, 20);
+  const size_t delays[] = {0, 3, 17};
+  const double gains[] = {1.0, 0.5, -2.0};
+  double output[BLOCK];
+
+  buffer.read_taps(output, BLOCK, delays, gains, 3);
+  for (size_t i = 0; i < BLOCK; i++) {
+    double expected = 0;
+    for (size_t tap = 0; tap < 3; tap++) {
+      expected += gains[tap] * double(total - BLOCK - delays[tap] + i);
+    }
+    BOOST_CHECK_CLOSE(expected, output[i], 1e-12);
+  }
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(testFractionalReadsOfRamp, Type, metricTypes) {
+  auto buffer = Type::create();
+  size_t total = writeRamp(buffer, 25);
+  double linear[BLOCK];
+  double cubic[BLOCK];
+
+  // Both interpolations reproduce a ramp exactly
+  for (double delay : {1.0, 1.25, 2.5, 7.75, 20.0}) {
+    buffer.read_linear(linear, BLOCK, delay);
+    buffer.read_cubic(cubic, BLOCK, delay);
+    for (size_t i = 0; i < BLOCK; i++) {
+      double expected = double(total - BLOCK + i) - delay;
+      BOOST_CHECK_CLOSE(expected, linear[i], 1e-10);
+      BOOST_CHECK_CLOSE(expected, cubic[i], 1e-10);
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(testReadsMustFit, Type, metricTypes) {
+  auto buffer = Type::create();
+  writeRamp(buffer, 25);
+  double output[BLOCK];
+  const size_t last = buffer.elements() - BLOCK;
+  const double gains[] = {1.0, 1.0};
+  const size_t fitting[] = {0, last};
+  const size_t beyond[] = {0, last + 1};
+
+  BOOST_CHECK_NO_THROW(buffer.read(output, BLOCK, last));
+  BOOST_CHECK_NO_THROW(buffer.window(last, BLOCK));
+  BOOST_CHECK_NO_THROW(buffer.read_taps(output, BLOCK, fitting, gains, 2));
+  BOOST_CHECK_THROW(buffer.read(output, BLOCK, last + 1),
+                    std::invalid_argument);
+  BOOST_CHECK_THROW(buffer.read(output, BLOCK, buffer.elements()),
+                    std::invalid_argument);
+  BOOST_CHECK_THROW(buffer.read(output, BLOCK, size_t(-1)),
+                    std::invalid_argument);
+  BOOST_CHECK_THROW(buffer.window(last + 1, BLOCK), std::invalid_argument);
+  BOOST_CHECK_THROW(buffer.window(0, buffer.max_window() + 1),
+                    std::invalid_argument);
+  BOOST_CHECK_THROW(buffer.read_taps(output, BLOCK, beyond, gains, 2),
+                    std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(testFractionalReadsMustFit, Type, metricTypes) {
+  auto buffer = Type::create();
+  writeRamp(buffer, 25);
+  double output[BLOCK];
+  const double last = double(buffer.elements() - BLOCK - 3);
+
+  BOOST_CHECK_NO_THROW(buffer.read_linear(output, BLOCK, 0.0));
+  BOOST_CHECK_NO_THROW(buffer.read_linear(output, BLOCK, last));
+  BOOST_CHECK_NO_THROW(buffer.read_cubic(output, BLOCK, 1.0));
+  BOOST_CHECK_NO_THROW(buffer.read_cubic(output, BLOCK, last));
+  BOOST_CHECK_THROW(buffer.read_linear(output, BLOCK, -0.5),
+                    std::invalid_argument);
+  BOOST_CHECK_THROW(buffer.read_linear(output, BLOCK, last + 0.5),
+                    std::invalid_argument);
+  BOOST_CHECK_THROW(buffer.read_cubic(output, BLOCK, 0.0),
+                    std::invalid_argument);
+  BOOST_CHECK_THROW(buffer.read_cubic(output, BLOCK, 0.75),
+                    std::invalid_argument);
+  BOOST_CHECK_THROW(buffer.read_cubic(output, BLOCK, last + 0.5),
+                    std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(testCubicInterpolatesQuadraticBetterThanLinear) {
+  CircularBuffer<double> buffer(64, 8);
+  double input[8];
+  for (size_t b = 0; b < 8; b++) {
+    for (size_t i = 0; i < 8; i++) {
+      double x = 0.1 * double(8 * b + i);
+      input[i] = x * x;
+    }
+    buffer.write(input, 8);
+  }
+  double linear[8];
+  double cubic[8];
+  buffer.read_linear(linear, 8, 4.5);
+  buffer.read_cubic(cubic, 8, 4.5);
+  for (size_t i = 0; i < 8; i++) {
+    double x = 0.1 * (56.0 + double(i) - 4.5);
+    double expected = x * x;
+    BOOST_CHECK_LT(std::abs(cubic[i] - expected),
+                   std::abs(linear[i] - expected));
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
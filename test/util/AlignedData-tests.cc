@@ -0,0 +1,134 @@
+//
+// Created by michel on 15-10-26.
+//
+
+#include "test-helper.h"
+#include <org-simple/NumArray.h>
+#include <vector>
+
+using namespace org::simple;
+
+namespace {
+
+static constexpr size_t ELEMENTS = 8;
+static constexpr size_t ALIGNMENT = 32;
+using Local = AlignedLocalStorage<float, ELEMENTS, ALIGNMENT>;
+using Allocated = AlignedAllocatedStorage<float, ELEMENTS, ALIGNMENT>;
+using Reference = AlignedReferencedStorage<float, ELEMENTS, ALIGNMENT>;
+using ConstReference =
+    AlignedConstReferencedStorage<float, ELEMENTS, ALIGNMENT>;
+
+/*
+ * Externally owned memory, like the buffer of an audio period.
+ */
+struct alignas(ALIGNMENT) Period {
+  float samples[4 * ELEMENTS];
+};
+
+template <class Data> void fillRamp(Data &data, float start) {
+  for (size_t i = 0; i < data.size(); i++) {
+    data[i] = start + float(i);
+  }
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(org_simple_util_AlignedData)
+
+BOOST_AUTO_TEST_CASE(testInfo) {
+  constexpr AlignedDataInfo local = AlignedDataInfo::get<Local>();
+  BOOST_CHECK(local.isAlignedData);
+  BOOST_CHECK_EQUAL(ELEMENTS, local.elements);
+  BOOST_CHECK_EQUAL(ALIGNMENT, local.alignment);
+  BOOST_CHECK(local.type == AlignedDataType::ARRAY);
+  BOOST_CHECK(AlignedDataInfo::get<Allocated>().type ==
+              AlignedDataType::ALLOCATED_ARRAY);
+  BOOST_CHECK(AlignedDataInfo::get<ConstReference>().isConst);
+  BOOST_CHECK((AlignedDataInfo::is<NumArray<float, 4>>()));
+  BOOST_CHECK(!AlignedDataInfo::is<std::vector<float>>());
+  BOOST_CHECK_EQUAL(ELEMENTS * sizeof(float), sizeof(Local));
+  BOOST_CHECK_EQUAL(ALIGNMENT, alignof(Local));
+}
+
+BOOST_AUTO_TEST_CASE(testLocalAndAllocatedCopies) {
+  Local local;
+  fillRamp(local, 1);
+  Allocated allocated(local);
+  BOOST_CHECK(Align::isAlignedPointer(allocated.data(), ALIGNMENT));
+  BOOST_CHECK_NE(local.data(), allocated.data());
+  for (size_t i = 0; i < ELEMENTS; i++) {
+    BOOST_CHECK_EQUAL(local[i], allocated[i]);
+  }
+  Allocated copy(allocated);
+  BOOST_CHECK_NE(copy.data(), allocated.data());
+  Allocated moved(std::move(copy));
+  BOOST_CHECK_EQUAL(3.0f, moved.at(2));
+  copy = moved;
+  BOOST_CHECK_EQUAL(3.0f, copy[2]);
+
+  std::vector<float> wrongSize(ELEMENTS + 1);
+  BOOST_CHECK_THROW(Local{wrongSize}, std::invalid_argument);
+  BOOST_CHECK_THROW(local.at(ELEMENTS), std::out_of_range);
+}
+
+BOOST_AUTO_TEST_CASE(testReferenceWorksInPlace) {
+  Period period;
+  Reference reference(period.samples + ELEMENTS);
+  fillRamp(reference, 10);
+  BOOST_CHECK_EQUAL(10.0f, period.samples[ELEMENTS]);
+  BOOST_CHECK_EQUAL(17.0f, period.samples[2 * ELEMENTS - 1]);
+
+  // Copies refer to the same samples, assignment copies samples
+  Reference copy(reference);
+  BOOST_CHECK_EQUAL(reference.data(), copy.data());
+  copy.set(period.samples);
+  copy = reference;
+  BOOST_CHECK_EQUAL(10.0f, period.samples[0]);
+
+  ConstReference constReference(reference);
+  BOOST_CHECK_EQUAL(reference.data(), constReference.data());
+}
+
+BOOST_AUTO_TEST_CASE(testReferenceChecksAlignment) {
+  Period period;
+  BOOST_CHECK_THROW(Reference{period.samples + 1}, std::invalid_argument);
+  BOOST_CHECK_THROW(Reference{nullptr}, std::invalid_argument);
+
+  AlignedLocalStorage<float, 3 * ELEMENTS, ALIGNMENT> owner;
+  BOOST_CHECK_NO_THROW(Reference(owner, 2 * ELEMENTS));
+  BOOST_CHECK_THROW(Reference(owner, 2 * ELEMENTS + 8), std::invalid_argument);
+  BOOST_CHECK_THROW(Reference(owner, 4), std::invalid_argument);
+
+  BOOST_CHECK(Reference::isOwner<Local>());
+  BOOST_CHECK(!Reference::isOwner<const Local>());
+  BOOST_CHECK(ConstReference::isOwner<const Local>());
+  BOOST_CHECK((!Reference::isOwner<AlignedLocalStorage<float, ELEMENTS>>()));
+  BOOST_CHECK(
+      (!Reference::isOwner<AlignedLocalStorage<float, 4, ALIGNMENT>>()));
+}
+
+BOOST_AUTO_TEST_CASE(testNumArrayOnExternalBuffer) {
+  Period period;
+  for (size_t i = 0; i < 4 * ELEMENTS; i++) {
+    period.samples[i] = float(i);
+  }
+  NumArray<float, ELEMENTS, ALIGNMENT> gain;
+  gain.fill(0.5f);
+
+  for (size_t block = 0; block < 4; block++) {
+    NumArrayReference<float, ELEMENTS, ALIGNMENT> samples(
+        period.samples + block * ELEMENTS);
+    samples *= 2.0f;
+    samples -= gain;
+  }
+  for (size_t i = 0; i < 4 * ELEMENTS; i++) {
+    BOOST_CHECK_EQUAL(2.0f * float(i) - 0.5f, period.samples[i]);
+  }
+
+  NumArrayReference<float, ELEMENTS, ALIGNMENT> samples(period.samples);
+  auto sum = samples + gain;
+  BOOST_CHECK_EQUAL(0.0f, sum[0]);
+  BOOST_CHECK(sum.data() != samples.data());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
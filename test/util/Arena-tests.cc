@@ -0,0 +1,107 @@
+//
+// Created by michel on 15-10-26.
+//
+
+#include "test-helper.h"
+#include <org-simple/AlignedData.h>
+#include <org-simple/Arena.h>
+
+using namespace org::simple;
+
+namespace {
+
+static constexpr size_t ALIGNMENT = 64;
+using Allocator = ArenaAllocator<float, ALIGNMENT>;
+using Vector = AlignedVector<float, ALIGNMENT, Allocator>;
+
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(org_simple_util_Arena)
+
+BOOST_AUTO_TEST_CASE(testAllocationsAreAlignedAndContiguous) {
+  Arena arena(1024);
+  void *first = arena.allocate(3, 1);
+  void *second = arena.allocate(8, 16);
+  void *third = arena.allocate(1, 64);
+
+  BOOST_CHECK(Align::isAlignedPointer(static_cast<char *>(second), 16));
+  BOOST_CHECK(Align::isAlignedPointer(static_cast<char *>(third), 64));
+  BOOST_CHECK(first < second && second < third);
+  BOOST_CHECK(arena.contains(first) && arena.contains(third));
+  BOOST_CHECK_LE(static_cast<char *>(third) - static_cast<char *>(first),
+                 64 + 16);
+  BOOST_CHECK_EQUAL(arena.used(), static_cast<char *>(third) -
+                                      static_cast<char *>(first) + 1);
+}
+
+BOOST_AUTO_TEST_CASE(testExhaustionThrowsAndResetReleasesAll) {
+  Arena arena(256);
+  void *first = arena.allocate(200, 64);
+  BOOST_CHECK_THROW((void)arena.allocate(100, 1), std::bad_alloc);
+  BOOST_CHECK_EQUAL(200, arena.used());
+
+  arena.reset();
+  BOOST_CHECK_EQUAL(0, arena.used());
+  BOOST_CHECK_EQUAL(first, arena.allocate(256, 64));
+  BOOST_CHECK_EQUAL(0, arena.available());
+}
+
+BOOST_AUTO_TEST_CASE(testAllocatorsEqualForSameArena) {
+  Arena arena(256);
+  Arena other(256);
+  Allocator allocator(arena);
+  ArenaAllocator<double, ALIGNMENT> rebound(allocator);
+
+  BOOST_CHECK(allocator == rebound);
+  BOOST_CHECK(allocator != Allocator(other));
+  BOOST_CHECK_EQUAL(&arena, &rebound.arena());
+  BOOST_CHECK_EQUAL(ALIGNMENT, AlignedContainerInfo<Vector>::alignment);
+}
+
+BOOST_AUTO_TEST_CASE(testVectorsAreLaidOutInArena) {
+  Arena arena(4096);
+  Allocator allocator(arena);
+  Vector first(100, 1.0f, allocator);
+  Vector second(allocator);
+  second.reserve(50);
+  second.assign(50, 2.0f);
+
+  BOOST_CHECK(arena.contains(first.data()));
+  BOOST_CHECK(arena.contains(second.data()));
+  BOOST_CHECK(Align::isAlignedPointer(first.data(), ALIGNMENT));
+  BOOST_CHECK(Align::isAlignedPointer(second.data(), ALIGNMENT));
+  BOOST_CHECK_EQUAL(first.data() + 112, second.data());
+  BOOST_CHECK_EQUAL(1.0f, first[99]);
+  BOOST_CHECK_EQUAL(2.0f, second[49]);
+}
+
+BOOST_AUTO_TEST_CASE(testLockOrPrefault) {
+  Arena arena(65536);
+  bool locked = arena.lock();
+  BOOST_CHECK_EQUAL(locked, arena.locked());
+  arena.unlock();
+  BOOST_CHECK(!arena.locked());
+  arena.prefault();
+  BOOST_CHECK_EQUAL(0, arena.used());
+}
+
+BOOST_AUTO_TEST_CASE(testLockAndPrefaultPreserveContents) {
+  static constexpr size_t SIZE = 3 * 65536 + 100;
+  Arena arena(SIZE);
+  auto *bytes = static_cast<unsigned char *>(arena.allocate(SIZE, 1));
+  for (size_t i = 0; i < SIZE; i++) {
+    bytes[i] = static_cast<unsigned char>(i * 31 + 7);
+  }
+  arena.prefault();
+  arena.lock();
+  arena.unlock();
+  arena.prefault();
+  for (size_t i = 0; i < SIZE; i++) {
+    if (bytes[i] != static_cast<unsigned char>(i * 31 + 7)) {
+      BOOST_CHECK_EQUAL(static_cast<unsigned char>(i * 31 + 7), bytes[i]);
+      return;
+    }
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,77 @@
+//
+// Created by michel on 15-10-26.
+//
+
+#include "test-helper.h"
+#include <memory>
+#include <org-simple/AlignedData.h>
+#include <org-simple/HugePageAllocator.h>
+
+using namespace org::simple;
+
+namespace {
+
+static constexpr size_t ALIGNMENT = 64;
+using Allocator = HugePageAllocator<float, ALIGNMENT>;
+using Vector = AlignedVector<float, ALIGNMENT, Allocator>;
+static constexpr size_t LARGE = 3 * HugePages::HUGE_PAGE / sizeof(float);
+
+template <class Container> bool writeAndCheck(Container &container) {
+  for (size_t i = 0; i < container.size(); i++) {
+    container[i] = float(i % 1000);
+  }
+  for (size_t i = 0; i < container.size(); i++) {
+    if (container[i] != float(i % 1000)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(org_simple_util_HugePageAllocator)
+
+BOOST_AUTO_TEST_CASE(testAllocatorProperties) {
+  BOOST_CHECK_EQUAL(ALIGNMENT, AlignedContainerInfo<Vector>::alignment);
+  BOOST_CHECK((Allocator() == HugePageAllocator<double, ALIGNMENT>()));
+  BOOST_CHECK((Allocator() != Allocator(HugePages{.node = 0})));
+  BOOST_CHECK_EQUAL(2 * HugePages::HUGE_PAGE,
+                    HugePages::mapped_length(HugePages::HUGE_PAGE + 1));
+}
+
+BOOST_AUTO_TEST_CASE(testSmallVectorIsAligned) {
+  Vector vector(1000, 1.0f);
+  BOOST_CHECK(Align::isAlignedPointer(vector.data(), ALIGNMENT));
+  BOOST_CHECK(writeAndCheck(vector));
+}
+
+BOOST_AUTO_TEST_CASE(testLargeVectorStartsOnHugePage) {
+  Vector vector(LARGE, 0.0f);
+  BOOST_CHECK(Align::isAlignedPointer(vector.data(), HugePages::HUGE_PAGE));
+  BOOST_CHECK(writeAndCheck(vector));
+  vector.resize(LARGE + 1);
+  BOOST_CHECK(Align::isAlignedPointer(vector.data(), HugePages::HUGE_PAGE));
+  BOOST_CHECK_EQUAL(float((LARGE - 1) % 1000), vector[LARGE - 1]);
+}
+
+BOOST_AUTO_TEST_CASE(testThresholdAndNodeBinding) {
+  // Binding to node zero works on NUMA and is ignored on other systems
+  Allocator allocator(HugePages{.threshold = 4096, .node = 0});
+  Vector vector(allocator);
+  vector.assign(2048, 1.0f);
+  BOOST_CHECK(Align::isAlignedPointer(vector.data(), HugePages::HUGE_PAGE));
+  BOOST_CHECK(writeAndCheck(vector));
+}
+
+BOOST_AUTO_TEST_CASE(testAlignedArrayCreatedWithNew) {
+  using Array = AlignedArray<float, LARGE, ALIGNMENT, Allocator>;
+  auto array = std::make_unique<Array>();
+  BOOST_CHECK(Align::isAlignedPointer(array->data(), HugePages::HUGE_PAGE));
+  BOOST_CHECK(writeAndCheck(*array));
+
+  auto plain = std::make_unique<AlignedArray<float, 100, ALIGNMENT>>();
+  BOOST_CHECK(Align::isAlignedPointer(plain->data(), ALIGNMENT));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
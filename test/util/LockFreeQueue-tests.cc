@@ -0,0 +1,132 @@
+//
+// Created by michel on 15-10-26.
+//
+
+#include "test-helper.h"
+#include <boost/mpl/list.hpp>
+#include <thread>
+#include <vector>
+
+#include <org-simple/LockFreeQueue.h>
+
+using namespace org::simple;
+
+static constexpr size_t QUEUE_SIZE = 8;
+
+typedef boost::mpl::list<
+    LockFreeQueue::MultiProducerMultiConsumer<size_t, QUEUE_SIZE>,
+    LockFreeQueue::MultiProducerSingleConsumer<size_t, QUEUE_SIZE>>
+    queueTypes;
+
+namespace {
+
+static constexpr size_t PRODUCERS = 3;
+static constexpr size_t PER_PRODUCER = 20000;
+static constexpr size_t PRODUCER_SHIFT = 32;
+
+/*
+ * Lets PRODUCERS threads each push a sequence of values tagged with the
+ * producer, while \c consumers threads pop them. Each consumer verifies that
+ * it receives the values of each producer in order. Returns the number of
+ * values that were out of order, or \c ~0 if values were lost.
+ */
+template <class Queue> size_t transfer(Queue &queue, size_t consumers) {
+  std::atomic_size_t received = 0;
+  std::atomic_size_t errors = 0;
+  std::vector<std::thread> threads;
+  for (size_t p = 0; p < PRODUCERS; p++) {
+    threads.emplace_back([&queue, p]() {
+      for (size_t i = 0; i < PER_PRODUCER; i++) {
+        while (!queue.write((p << PRODUCER_SHIFT) | i)) {
+          std::this_thread::yield();
+        }
+      }
+    });
+  }
+  for (size_t c = 0; c < consumers; c++) {
+    threads.emplace_back([&]() {
+      size_t next[PRODUCERS] = {0};
+      size_t value;
+      while (received < PRODUCERS * PER_PRODUCER) {
+        if (!queue.read(value)) {
+          std::this_thread::yield();
+          continue;
+        }
+        received++;
+        size_t producer = value >> PRODUCER_SHIFT;
+        size_t sequence = value & ((size_t(1) << PRODUCER_SHIFT) - 1);
+        if (producer >= PRODUCERS || sequence < next[producer]) {
+          errors++;
+        } else {
+          next[producer] = sequence + 1;
+        }
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  return received == PRODUCERS * PER_PRODUCER ? errors.load() : ~size_t(0);
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(org_simple_util_LockFreeQueue)
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(testInit, Queue, queueTypes) {
+  Queue queue;
+  size_t value;
+
+  BOOST_CHECK_EQUAL(QUEUE_SIZE, queue.capacity());
+  BOOST_CHECK(queue.empty());
+  BOOST_CHECK(!queue.read(value));
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(testFillUntilFullAndReadUntilEmpty, Queue,
+                              queueTypes) {
+  Queue queue;
+  size_t value;
+
+  for (size_t i = 0; i < QUEUE_SIZE; i++) {
+    BOOST_CHECK(queue.write(i + 1));
+  }
+  BOOST_CHECK_EQUAL(QUEUE_SIZE, queue.size());
+  BOOST_CHECK(!queue.write(13));
+  for (size_t i = 0; i < QUEUE_SIZE; i++) {
+    BOOST_CHECK(queue.read(value));
+    BOOST_CHECK_EQUAL(i + 1, value);
+  }
+  BOOST_CHECK(queue.empty());
+  BOOST_CHECK(!queue.read(value));
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(testMultipleLaps, Queue, queueTypes) {
+  Queue queue;
+  size_t value = 0;
+
+  for (size_t i = 0; i < 5 * QUEUE_SIZE; i++) {
+    BOOST_CHECK(queue.write(i));
+    BOOST_CHECK(queue.write(i + 1000));
+    BOOST_CHECK(queue.read(value));
+    BOOST_CHECK_EQUAL(i, value);
+    BOOST_CHECK(queue.read(value));
+    BOOST_CHECK_EQUAL(i + 1000, value);
+  }
+  BOOST_CHECK(queue.empty());
+}
+
+BOOST_AUTO_TEST_CASE(testMultiProducerSingleConsumerTransfer) {
+  LockFreeQueue::MultiProducerSingleConsumer<size_t, QUEUE_SIZE> queue;
+
+  BOOST_CHECK_EQUAL(0, transfer(queue, 1));
+  BOOST_CHECK(queue.empty());
+}
+
+BOOST_AUTO_TEST_CASE(testMultiProducerMultiConsumerTransfer) {
+  LockFreeQueue::MultiProducerMultiConsumer<size_t, QUEUE_SIZE> queue;
+
+  BOOST_CHECK_EQUAL(0, transfer(queue, 3));
+  BOOST_CHECK(queue.empty());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -4,8 +4,10 @@
 
 #include "test-helper.h"
 #include <boost/mpl/list.hpp>
+#include <functional>
 
 #include <org-simple/LockfreeRingBuffer.h>
+#include <thread>
 
 using namespace boost::unit_test;
 using namespace org::simple;
@@ -59,43 +61,198 @@ public:
 static constexpr size_t SIZE = 4;
 static constexpr size_t VAR_SIZE = 16;
 
-template<WriteMethod method>
+template<WriteMethod method, class Indices = LockFreeRingBuffer::SharedIndices<>>
 class FixedBufferTester {
-  RingBufferLockFreeFixedSize<int, SIZE> buffer;
+  using Buffer = LockFreeRingBuffer::MonotonicFixed<int, SIZE, Indices>;
+  Buffer buffer;
 public:
   FixedBufferTester() {}
   auto wrapped() {
-    return RingBufferWrapper<RingBufferLockFreeFixedSize<int, SIZE>, method>(buffer);
+    return RingBufferWrapper<Buffer, method>(buffer);
   }
+  Buffer &get() { return buffer; }
   static constexpr WriteMethod METHOD = method;
 };
 
-template<WriteMethod method>
+template<WriteMethod method, class Indices = LockFreeRingBuffer::SharedIndices<>>
 class VariableBuffer {
+  using Buffer =
+      LockFreeRingBuffer::Monotonic<int, RingBufferLockFree<int>::Metric,
+                                    Indices>;
   int data[VAR_SIZE];
   RingBufferLockFree<int>::Metric metric;
-  RingBufferLockFree<int> buffer;
+  Buffer buffer;
 public:
   VariableBuffer() : metric(VAR_SIZE), buffer(metric, data) {
     metric.set_elements(SIZE);
   }
   auto wrapped() {
-    return RingBufferWrapper<RingBufferLockFree<int>, method>(buffer);
+    return RingBufferWrapper<Buffer, method>(buffer);
   }
+  Buffer &get() { return buffer; }
   static constexpr WriteMethod METHOD = method;
 };
 
+using Padded = LockFreeRingBuffer::PaddedIndices<>;
+using SharedAcqRel =
+    LockFreeRingBuffer::SharedIndices<LockFreeRingBuffer::AcquireRelease>;
+using PaddedAcqRel =
+    LockFreeRingBuffer::PaddedIndices<LockFreeRingBuffer::AcquireRelease>;
+
 typedef boost::mpl::list<
     FixedBufferTester<WriteMethod::WRITE>,
     FixedBufferTester<WriteMethod::RESET>,
     FixedBufferTester<WriteMethod::RESET_COUNT>,
     VariableBuffer<WriteMethod::WRITE>,
     VariableBuffer<WriteMethod::RESET>,
-    VariableBuffer<WriteMethod::RESET_COUNT>
+    VariableBuffer<WriteMethod::RESET_COUNT>,
+    FixedBufferTester<WriteMethod::WRITE, Padded>,
+    FixedBufferTester<WriteMethod::RESET, Padded>,
+    FixedBufferTester<WriteMethod::RESET_COUNT, Padded>,
+    VariableBuffer<WriteMethod::WRITE, Padded>,
+    VariableBuffer<WriteMethod::RESET, Padded>,
+    VariableBuffer<WriteMethod::RESET_COUNT, Padded>,
+    FixedBufferTester<WriteMethod::WRITE, SharedAcqRel>,
+    FixedBufferTester<WriteMethod::RESET, SharedAcqRel>,
+    FixedBufferTester<WriteMethod::RESET_COUNT, SharedAcqRel>,
+    VariableBuffer<WriteMethod::WRITE, PaddedAcqRel>,
+    VariableBuffer<WriteMethod::RESET, PaddedAcqRel>,
+    VariableBuffer<WriteMethod::RESET_COUNT, PaddedAcqRel>
     > testTypes;
 
+typedef boost::mpl::list<
+    FixedBufferTester<WriteMethod::WRITE>,
+    VariableBuffer<WriteMethod::WRITE>,
+    FixedBufferTester<WriteMethod::WRITE, Padded>,
+    VariableBuffer<WriteMethod::WRITE, Padded>,
+    FixedBufferTester<WriteMethod::WRITE, SharedAcqRel>,
+    VariableBuffer<WriteMethod::WRITE, PaddedAcqRel>
+    > bulkTestTypes;
+
+typedef boost::mpl::list<
+    FixedBufferTester<WriteMethod::WRITE>,
+    FixedBufferTester<WriteMethod::WRITE, PaddedAcqRel>,
+    VariableBuffer<WriteMethod::WRITE, SharedAcqRel>,
+    VariableBuffer<WriteMethod::WRITE, Padded>
+    > stressTestTypes;
+
+/*
+ * Moves a sequence of numbers from a producer thread to the consumer (calling)
+ * thread, where both threads use single, bulk and zero-copy operations in
+ * turn. With \c reset, the producer writes single values with
+ * write_if_empty_reset(). Returns the number of values that the consumer
+ * received out of sequence. Building with ORG_SIMPLE_SANITIZE_THREAD lets
+ * ThreadSanitizer verify the memory ordering of the buffer.
+ */
+template <class Buffer>
+size_t stressTransfer(Buffer &buffer, int values, bool reset = false) {
+  std::thread producer([&buffer, values, reset]() {
+    int block[3];
+    int next = 0;
+    while (next < values) {
+      switch (next % 3) {
+      case 0:
+        if (!(reset ? buffer.write_if_empty_reset(next) : buffer.write(next))) {
+          std::this_thread::yield();
+          continue;
+        }
+        next++;
+        break;
+      case 1: {
+        int count = std::min(3, values - next);
+        for (int i = 0; i < count; i++) {
+          block[i] = next + i;
+        }
+        size_t written = buffer.write(block, count);
+        if (!written) {
+          std::this_thread::yield();
+        }
+        next += written;
+        break;
+      }
+      default: {
+        auto region = buffer.acquire_write(std::min(2, values - next));
+        if (region.empty()) {
+          std::this_thread::yield();
+        }
+        for (size_t i = 0; i < region.size(); i++) {
+          region[i] = next + i;
+        }
+        buffer.commit(region.size());
+        next += region.size();
+        break;
+      }
+      }
+    }
+  });
+  size_t errors = 0;
+  int block[3];
+  int expected = 0;
+  size_t turn = 0;
+  while (expected < values) {
+    size_t count;
+    switch (turn++ % 3) {
+    case 0:
+      count = buffer.read(block[0]) ? 1 : 0;
+      break;
+    case 1:
+      count = buffer.read(block, 3);
+      break;
+    default: {
+      auto region = buffer.acquire_read(3);
+      count = region.size();
+      for (size_t i = 0; i < count; i++) {
+        block[i] = region[i];
+      }
+      buffer.consume(count);
+      break;
+    }
+    }
+    if (!count) {
+      std::this_thread::yield();
+    }
+    for (size_t i = 0; i < count; i++, expected++) {
+      if (block[i] != expected) {
+        errors++;
+      }
+    }
+  }
+  producer.join();
+  return errors;
+}
+
+/*
+ * Indices that let a test run the producer after the consumer loaded the read
+ * index and before it loads the write index, so that a reset by the producer
+ * hits that window deterministically.
+ */
+template <class Indices> struct InterruptedIndices : public Indices {
+  static inline std::function<void()> between_loads;
+
+  size_t consumer_write(size_t rd, size_t wanted) {
+    if (between_loads) {
+      auto producer = std::move(between_loads);
+      between_loads = nullptr;
+      producer();
+    }
+    return Indices::consumer_write(rd, wanted);
+  }
+};
+
+typedef boost::mpl::list<
+    InterruptedIndices<LockFreeRingBuffer::SharedIndices<>>,
+    InterruptedIndices<Padded>,
+    InterruptedIndices<SharedAcqRel>,
+    InterruptedIndices<PaddedAcqRel>
+    > interruptedTypes;
+
 BOOST_AUTO_TEST_SUITE(org_simple_util_LockFreeRingBuffer)
 
+BOOST_AUTO_TEST_CASE(testPaddedIndicesOnSeparateCacheLines) {
+  BOOST_CHECK_EQUAL(Align::cacheLine, alignof(Padded));
+  BOOST_CHECK_EQUAL(2 * Align::cacheLine, sizeof(Padded));
+}
+
 BOOST_AUTO_TEST_CASE_TEMPLATE(testInit, Tester, testTypes) {
   Tester tester;
   auto buffer = tester.wrapped();
@@ -256,4 +413,271 @@ BOOST_AUTO_TEST_CASE_TEMPLATE(testFillUntilFullAndReadUntilEmptyWrite, Tester, t
   BOOST_CHECK_EQUAL(size_base + 1, buffer.writes());
 }
 
+BOOST_AUTO_TEST_CASE_TEMPLATE(testBulkWriteAndRead, Tester, bulkTestTypes) {
+  Tester tester;
+  auto &buffer = tester.get();
+  const int values[] = {1, 2, 3, 4, 5, 6};
+  int read[6] = {0};
+
+  BOOST_CHECK_EQUAL(3, buffer.write(values, 3));
+  BOOST_CHECK_EQUAL(3, buffer.size());
+  BOOST_CHECK_EQUAL(2, buffer.read(read, 2));
+  BOOST_CHECK_EQUAL(1, read[0]);
+  BOOST_CHECK_EQUAL(2, read[1]);
+  BOOST_CHECK_EQUAL(1, buffer.size());
+
+  // Only three fit and the write wraps around the end of the buffer
+  BOOST_CHECK_EQUAL(3, buffer.write(values + 3, 3));
+  BOOST_CHECK(buffer.full());
+  BOOST_CHECK_EQUAL(6, buffer.write_ptr());
+  BOOST_CHECK_EQUAL(0, buffer.write(values, 1));
+
+  BOOST_CHECK_EQUAL(4, buffer.read(read, 6));
+  BOOST_CHECK(buffer.empty());
+  BOOST_CHECK_EQUAL(3, read[0]);
+  BOOST_CHECK_EQUAL(4, read[1]);
+  BOOST_CHECK_EQUAL(5, read[2]);
+  BOOST_CHECK_EQUAL(6, read[3]);
+  BOOST_CHECK_EQUAL(0, buffer.read(read, 1));
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(testAcquireWriteAndCommit, Tester, bulkTestTypes) {
+  Tester tester;
+  auto &buffer = tester.get();
+  const int values[] = {1, 2, 3};
+  int read[3];
+
+  BOOST_CHECK_EQUAL(3, buffer.write(values, 3));
+  BOOST_CHECK_EQUAL(3, buffer.read(read, 3));
+
+  auto region = buffer.acquire_write(SIZE + 1);
+  BOOST_CHECK_EQUAL(SIZE, region.size());
+  BOOST_CHECK_EQUAL(1, region.first.size());
+  BOOST_CHECK_EQUAL(SIZE - 1, region.second.size());
+  for (size_t i = 0; i < region.size(); i++) {
+    region[i] = 10 + i;
+  }
+  BOOST_CHECK(buffer.empty());
+  buffer.commit(region.size());
+  BOOST_CHECK(buffer.full());
+  BOOST_CHECK(buffer.acquire_write(1).empty());
+
+  for (size_t i = 0; i < SIZE; i++) {
+    int value = 0;
+    BOOST_CHECK(buffer.read(value));
+    BOOST_CHECK_EQUAL(10 + i, value);
+  }
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(testAcquireReadAndConsume, Tester, bulkTestTypes) {
+  Tester tester;
+  auto &buffer = tester.get();
+  const int values[] = {1, 2, 3, 4, 5, 6};
+  int read[3];
+
+  BOOST_CHECK(buffer.acquire_read(1).empty());
+  BOOST_CHECK_EQUAL(3, buffer.write(values, 3));
+  BOOST_CHECK_EQUAL(2, buffer.read(read, 2));
+  BOOST_CHECK_EQUAL(3, buffer.write(values + 3, 3));
+
+  auto region = buffer.acquire_read(SIZE);
+  BOOST_CHECK_EQUAL(4, region.size());
+  BOOST_CHECK_EQUAL(2, region.first.size());
+  BOOST_CHECK_EQUAL(2, region.second.size());
+  for (size_t i = 0; i < region.size(); i++) {
+    BOOST_CHECK_EQUAL(3 + i, region[i]);
+  }
+  BOOST_CHECK(buffer.full());
+  buffer.consume(3);
+  BOOST_CHECK_EQUAL(1, buffer.size());
+  int value = 0;
+  BOOST_CHECK(buffer.read(value));
+  BOOST_CHECK_EQUAL(6, value);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(testStressProducerAndConsumer, Tester,
+                              stressTestTypes) {
+  Tester tester;
+  auto &buffer = tester.get();
+  static constexpr int VALUES = 100000;
+
+  BOOST_CHECK_EQUAL(0, stressTransfer(buffer, VALUES));
+  BOOST_CHECK(buffer.empty());
+  BOOST_CHECK_EQUAL(VALUES, buffer.write_ptr());
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(testStressProducerResetsAndConsumer, Tester,
+                              stressTestTypes) {
+  Tester tester;
+  auto &buffer = tester.get();
+  static constexpr int VALUES = 100000;
+
+  BOOST_CHECK_EQUAL(0, stressTransfer(buffer, VALUES, true));
+  BOOST_CHECK(buffer.empty());
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(testBulkReadRacingReset, Indices,
+                              interruptedTypes) {
+  LockFreeRingBuffer::MonotonicFixed<int, SIZE, Indices> buffer;
+  int block[3];
+  // Leaves the buffer empty with indices beyond the capacity, so that the
+  // read index that the consumer loaded exceeds the write index after a reset.
+  auto advance = [&buffer, &block]() {
+    for (int i = 0; i <= int(SIZE); i++) {
+      BOOST_REQUIRE(buffer.write(i));
+      BOOST_REQUIRE_EQUAL(1, buffer.read(block, 1));
+    }
+  };
+  auto reset = [&buffer](int value) {
+    Indices::between_loads = [&buffer, value]() {
+      BOOST_REQUIRE(buffer.write_if_empty_reset(value));
+    };
+  };
+
+  advance();
+  reset(100);
+  BOOST_CHECK_EQUAL(0, buffer.read(block, 3));
+  BOOST_CHECK_EQUAL(1, buffer.size());
+  BOOST_CHECK_EQUAL(1, buffer.read(block, 3));
+  BOOST_CHECK_EQUAL(100, block[0]);
+
+  advance();
+  reset(101);
+  auto region = buffer.acquire_read(3);
+  BOOST_CHECK(region.empty());
+  buffer.consume(region.size());
+  BOOST_CHECK_EQUAL(1, buffer.size());
+  BOOST_CHECK_EQUAL(1, buffer.read(block, 3));
+  BOOST_CHECK_EQUAL(101, block[0]);
+  BOOST_CHECK(buffer.empty());
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(testBulkReadRacingResetAndRefill, Indices,
+                              interruptedTypes) {
+  LockFreeRingBuffer::MonotonicFixed<int, SIZE, Indices> buffer;
+  int block[3];
+  // Leaves the buffer empty with a read index of two, that the producer
+  // writes past after it reset the indices.
+  auto advance = [&buffer, &block]() {
+    for (int i = 0; i < 2; i++) {
+      BOOST_REQUIRE(buffer.write(i));
+      BOOST_REQUIRE_EQUAL(1, buffer.read(block, 1));
+    }
+  };
+  auto reset = [&buffer](int value) {
+    Indices::between_loads = [&buffer, value]() {
+      BOOST_REQUIRE(buffer.write_if_empty_reset(value));
+      BOOST_REQUIRE(buffer.write(value + 1));
+      BOOST_REQUIRE(buffer.write(value + 2));
+    };
+  };
+
+  advance();
+  reset(100);
+  BOOST_CHECK_EQUAL(0, buffer.read(block, 3));
+  BOOST_CHECK_EQUAL(3, buffer.read(block, 3));
+  BOOST_CHECK_EQUAL(100, block[0]);
+  BOOST_CHECK_EQUAL(101, block[1]);
+  BOOST_CHECK_EQUAL(102, block[2]);
+  BOOST_CHECK(buffer.empty());
+
+  advance();
+  reset(200);
+  int value;
+  BOOST_CHECK(!buffer.read(value));
+  BOOST_CHECK_EQUAL(3, buffer.size());
+
+  buffer.read(block, 3);
+  advance();
+  reset(300);
+  auto region = buffer.acquire_read(3);
+  BOOST_CHECK(region.empty());
+  buffer.consume(region.size());
+  region = buffer.acquire_read(3);
+  BOOST_REQUIRE_EQUAL(3, region.size());
+  BOOST_CHECK_EQUAL(300, region[0]);
+  BOOST_CHECK_EQUAL(302, region[2]);
+  buffer.consume(region.size());
+  BOOST_CHECK(buffer.empty());
+}
+
+using Counting =
+    LockFreeRingBuffer::MonotonicFixed<int, SIZE,
+                                       LockFreeRingBuffer::SharedIndices<>,
+                                       LockFreeRingBuffer::CountingStatistics>;
+
+BOOST_AUTO_TEST_CASE(testNoStatisticsAddsNothing) {
+  using Plain = RingBufferLockFreeFixedSize<int, SIZE>;
+  BOOST_CHECK_EQUAL(sizeof(LockFreeRingBuffer::SharedIndices<>) +
+                        SIZE * sizeof(int),
+                    sizeof(Plain));
+  Plain buffer;
+  int value;
+  BOOST_CHECK(!buffer.read(value));
+  BOOST_CHECK(buffer.write(1));
+  auto statistics = buffer.statistics();
+  BOOST_CHECK_EQUAL(0, statistics.written);
+  BOOST_CHECK_EQUAL(0, statistics.failed_reads);
+}
+
+BOOST_AUTO_TEST_CASE(testCountingStatisticsSingleValues) {
+  Counting buffer;
+  int value;
+  BOOST_CHECK(!buffer.read(value));
+  for (int i = 0; i < int(SIZE); i++) {
+    BOOST_CHECK(buffer.write(i));
+  }
+  BOOST_CHECK(!buffer.write(-1));
+  BOOST_CHECK(!buffer.write(-1));
+  BOOST_CHECK(buffer.read(value));
+  BOOST_CHECK(buffer.write(SIZE));
+
+  auto statistics = buffer.statistics();
+  BOOST_CHECK_EQUAL(SIZE, statistics.max_occupancy);
+  BOOST_CHECK_EQUAL(2, statistics.failed_writes);
+  BOOST_CHECK_EQUAL(1, statistics.failed_reads);
+  BOOST_CHECK_EQUAL(SIZE + 1, statistics.written);
+  BOOST_CHECK_EQUAL(1, statistics.read);
+}
+
+BOOST_AUTO_TEST_CASE(testCountingStatisticsBulkAndRegions) {
+  Counting buffer;
+  int values[6] = {0, 1, 2, 3, 4, 5};
+  int read[6];
+  BOOST_CHECK_EQUAL(2, buffer.write(values, 2));
+  BOOST_CHECK_EQUAL(2, buffer.read(read, 3));
+  auto statistics = buffer.statistics();
+  BOOST_CHECK_EQUAL(2, statistics.max_occupancy);
+  BOOST_CHECK_EQUAL(1, statistics.failed_reads);
+
+  BOOST_CHECK_EQUAL(SIZE, buffer.write(values, 6));
+  auto region = buffer.acquire_write(1);
+  BOOST_CHECK(region.empty());
+  BOOST_CHECK_EQUAL(3, buffer.read(read, 3));
+  region = buffer.acquire_write(2);
+  BOOST_CHECK_EQUAL(2, region.size());
+  buffer.commit(2);
+  auto readable = buffer.acquire_read(SIZE);
+  BOOST_CHECK_EQUAL(3, readable.size());
+  buffer.consume(readable.size());
+
+  statistics = buffer.statistics();
+  BOOST_CHECK_EQUAL(SIZE, statistics.max_occupancy);
+  BOOST_CHECK_EQUAL(2 + 1, statistics.failed_writes);
+  BOOST_CHECK_EQUAL(1 + 1, statistics.failed_reads);
+  BOOST_CHECK_EQUAL(2 + SIZE + 2, statistics.written);
+  BOOST_CHECK_EQUAL(2 + 3 + 3, statistics.read);
+}
+
+BOOST_AUTO_TEST_CASE(testCountingStatisticsUnderStress) {
+  Counting buffer;
+  static constexpr int VALUES = 100000;
+
+  BOOST_CHECK_EQUAL(0, stressTransfer(buffer, VALUES));
+  auto statistics = buffer.statistics();
+  BOOST_CHECK_EQUAL(VALUES, statistics.written);
+  BOOST_CHECK_EQUAL(VALUES, statistics.read);
+  BOOST_CHECK_LE(statistics.max_occupancy, SIZE);
+}
+
 BOOST_AUTO_TEST_SUITE_END();
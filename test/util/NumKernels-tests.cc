@@ -0,0 +1,249 @@
+//
+// Created by michel on 15-10-26.
+//
+
+#include "test-helper.h"
+#include <cmath>
+#include <complex>
+#include <numeric>
+#include <vector>
+
+#include <org-simple/NumArray.h>
+#include <org-simple/NumKernels.h>
+
+using namespace org::simple;
+
+namespace {
+
+static constexpr SimdInstructions ALL[] = {
+    SimdInstructions::SCALAR, SimdInstructions::VECTOR128,
+    SimdInstructions::AVX2, SimdInstructions::AVX512};
+
+// Enough elements for two vectors of the widest instruction set and a tail
+static constexpr size_t MAX_COUNT = 2 * 64 / sizeof(float) + 7;
+
+template <typename T> T value(size_t i, size_t seed) {
+  return T(int((i * 7 + seed * 13) % 23) - 11) / 4;
+}
+
+template <typename T> bool close(T expected, T actual) {
+  return std::abs(expected - actual) <=
+         1e-5 * std::max(T(1), std::abs(expected));
+}
+
+/**
+ * Compares the kernels of \c instructions with plain loops, for every count
+ * up to MAX_COUNT and with data that starts at \c offset elements from an
+ * alignment of 64 bytes.
+ */
+template <typename T, size_t ALIGNMENT>
+void checkReal(SimdInstructions instructions, size_t offset) {
+  const auto &kernels = NumKernels<T, ALIGNMENT>::functions(instructions);
+  static constexpr size_t PER_LINE = 64 / sizeof(T);
+  const size_t stride =
+      (MAX_COUNT + offset + PER_LINE - 1) / PER_LINE * PER_LINE;
+  std::vector<T, AlignedAllocator<T, 64>> storage(4 * stride);
+  T *a = storage.data() + offset;
+  T *b = a + stride;
+  T *c = b + stride;
+  T *d = c + stride;
+  for (size_t i = 0; i < MAX_COUNT; i++) {
+    a[i] = value<T>(i, 1);
+    b[i] = value<T>(i, 2);
+    c[i] = value<T>(i, 3);
+  }
+  for (size_t count = 0; count <= MAX_COUNT; count++) {
+    T dot = 0;
+    T norm = 0;
+    for (size_t i = 0; i < count; i++) {
+      dot += a[i] * b[i];
+      norm += a[i] * a[i];
+    }
+    BOOST_CHECK(close(dot, kernels.dot(a, b, count)));
+    BOOST_CHECK(close(norm, kernels.norm(a, count)));
+
+    NumStatistics<T> statistics = kernels.statistics(a, count);
+    BOOST_CHECK_EQUAL(count, statistics.count);
+    BOOST_CHECK(close(norm, statistics.sum_of_squares));
+    if (count) {
+      BOOST_CHECK(close(std::accumulate(a, a + count, T(0)), statistics.sum));
+      BOOST_CHECK_EQUAL(*std::min_element(a, a + count), statistics.minimum);
+      BOOST_CHECK_EQUAL(*std::max_element(a, a + count), statistics.maximum);
+    }
+
+    kernels.add(d, a, b, count);
+    for (size_t i = 0; i < count; i++) {
+      BOOST_CHECK_EQUAL(a[i] + b[i], d[i]);
+    }
+    kernels.multiply(d, a, b, count);
+    for (size_t i = 0; i < count; i++) {
+      BOOST_CHECK_EQUAL(a[i] * b[i], d[i]);
+    }
+    kernels.fma(d, a, b, c, count);
+    for (size_t i = 0; i < count; i++) {
+      BOOST_CHECK(close(a[i] * b[i] + c[i], d[i]));
+    }
+    kernels.minimum(d, a, b, count);
+    for (size_t i = 0; i < count; i++) {
+      BOOST_CHECK_EQUAL(std::min(a[i], b[i]), d[i]);
+    }
+    kernels.maximum(d, a, b, count);
+    for (size_t i = 0; i < count; i++) {
+      BOOST_CHECK_EQUAL(std::max(a[i], b[i]), d[i]);
+    }
+  }
+}
+
+template <typename T> void checkComplex(SimdInstructions instructions) {
+  using C = std::complex<T>;
+  const auto &kernels = NumKernels<C>::functions(instructions);
+  std::vector<C> a(MAX_COUNT);
+  std::vector<C> b(MAX_COUNT);
+  std::vector<C> d(MAX_COUNT);
+  for (size_t i = 0; i < MAX_COUNT; i++) {
+    a[i] = {value<T>(i, 1), value<T>(i, 2)};
+    b[i] = {value<T>(i, 3), value<T>(i, 4)};
+  }
+  for (size_t count = 0; count <= MAX_COUNT; count++) {
+    C dot = 0;
+    T norm = 0;
+    for (size_t i = 0; i < count; i++) {
+      dot += std::conj(a[i]) * b[i];
+      norm += std::norm(a[i]);
+    }
+    C actual = kernels.dot(a.data(), b.data(), count);
+    BOOST_CHECK(close(dot.real(), actual.real()));
+    BOOST_CHECK(close(dot.imag(), actual.imag()));
+    BOOST_CHECK(close(norm, kernels.norm(a.data(), count)));
+
+    kernels.multiply(d.data(), a.data(), b.data(), count);
+    for (size_t i = 0; i < count; i++) {
+      BOOST_CHECK_EQUAL(a[i] * b[i], d[i]);
+    }
+    kernels.add(d.data(), a.data(), b.data(), count);
+    for (size_t i = 0; i < count; i++) {
+      BOOST_CHECK_EQUAL(a[i] + b[i], d[i]);
+    }
+  }
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(org_simple_util_NumKernels)
+
+BOOST_AUTO_TEST_CASE(testSupportAndSelection) {
+  BOOST_CHECK(num_kernels::isSupported(SimdInstructions::SCALAR));
+  BOOST_CHECK(num_kernels::isSupported(num_kernels::best()));
+  for (auto instructions : ALL) {
+    if (num_kernels::isSupported(instructions)) {
+      BOOST_CHECK_NO_THROW(NumKernels<float>::functions(instructions));
+    } else {
+      BOOST_CHECK_THROW(NumKernels<float>::functions(instructions),
+                        std::invalid_argument);
+    }
+  }
+  BOOST_CHECK(&NumKernels<float>::functions() ==
+              &NumKernels<float>::functions(num_kernels::best()));
+}
+
+BOOST_AUTO_TEST_CASE(testRealKernelsMatchLoops) {
+  for (auto instructions : ALL) {
+    if (!num_kernels::isSupported(instructions)) {
+      continue;
+    }
+    BOOST_TEST_CONTEXT(num_kernels::name(instructions)) {
+      checkReal<float, 64>(instructions, 0);
+      checkReal<float, 4>(instructions, 1);
+      checkReal<double, 64>(instructions, 0);
+      checkReal<double, 8>(instructions, 3);
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(testComplexKernelsMatchLoops) {
+  for (auto instructions : ALL) {
+    if (!num_kernels::isSupported(instructions)) {
+      continue;
+    }
+    BOOST_TEST_CONTEXT(num_kernels::name(instructions)) {
+      checkComplex<float>(instructions);
+      checkComplex<double>(instructions);
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(testKernelsInPlace) {
+  alignas(64) float a[40];
+  alignas(64) float b[40];
+  for (size_t i = 0; i < 40; i++) {
+    a[i] = float(i);
+    b[i] = 2.0f;
+  }
+  NumKernels<float, 64>::multiply(a, a, b, 40);
+  for (size_t i = 0; i < 40; i++) {
+    BOOST_CHECK_EQUAL(2.0f * float(i), a[i]);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(testStatisticsAreCompensated) {
+  // A plain float sum of these is off by about a thousand
+  static constexpr size_t COUNT = 1 << 20;
+  std::vector<float, AlignedAllocator<float, 64>> values(COUNT, 0.1f);
+  double exact = double(0.1f) * COUNT;
+  for (auto instructions : ALL) {
+    if (!num_kernels::isSupported(instructions)) {
+      continue;
+    }
+    BOOST_TEST_CONTEXT(num_kernels::name(instructions)) {
+      auto statistics = NumKernels<float, 64>::functions(instructions)
+                            .statistics(values.data(), COUNT);
+      BOOST_CHECK_LE(std::abs(statistics.sum - exact), 2e-6 * exact);
+      BOOST_CHECK_LE(std::abs(statistics.rms() - 0.1f), 1e-7);
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(testNumArrayStatistics) {
+  NumArray<float, 4> small{-3, 1, 2, 0};
+  auto statistics = small.statistics();
+  BOOST_CHECK_EQUAL(4, statistics.count);
+  BOOST_CHECK_EQUAL(0.0f, statistics.sum);
+  BOOST_CHECK_EQUAL(-3.0f, statistics.minimum);
+  BOOST_CHECK_EQUAL(2.0f, statistics.maximum);
+  BOOST_CHECK_EQUAL(3.0f, statistics.peak());
+  BOOST_CHECK_EQUAL(0.0f, statistics.mean());
+  BOOST_CHECK_EQUAL(3.5f, statistics.mean_square());
+
+  NumArray<double, 64, 64> large;
+  large.fill(-0.5);
+  large[10] = 0.25;
+  auto largeStatistics = large.statistics();
+  BOOST_CHECK(decltype(large)::use_kernels);
+  BOOST_CHECK_EQUAL(-31.25, largeStatistics.sum);
+  BOOST_CHECK_EQUAL(0.5, largeStatistics.peak());
+  BOOST_CHECK_EQUAL(0.25, largeStatistics.maximum);
+  BOOST_CHECK(close(std::sqrt((63 * 0.25 + 0.0625) / 64),
+                    largeStatistics.rms()));
+}
+
+BOOST_AUTO_TEST_CASE(testNumArrayReductionsUseKernels) {
+  using Array = NumArray<std::complex<double>, 16, 64>;
+  BOOST_CHECK(Array::use_kernels);
+  BOOST_CHECK(!(NumArray<double, 4>::use_kernels));
+  BOOST_CHECK(!(NumArray<int, 64>::use_kernels));
+  Array a;
+  NumArray<std::complex<double>, 16> b;
+  std::complex<double> dot = 0;
+  double norm = 0;
+  for (size_t i = 0; i < 16; i++) {
+    a[i] = {value<double>(i, 1), value<double>(i, 2)};
+    b[i] = {value<double>(i, 3), value<double>(i, 4)};
+    dot += std::conj(a[i]) * b[i];
+    norm += std::norm(a[i]);
+  }
+  BOOST_CHECK(close(dot.real(), a.dot(b).real()));
+  BOOST_CHECK(close(dot.imag(), a.dot(b).imag()));
+  BOOST_CHECK(close(norm, a.squared_absolute()));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
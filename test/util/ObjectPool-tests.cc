@@ -0,0 +1,161 @@
+//
+// Created by michel on 15-10-26.
+//
+
+#include "test-helper.h"
+#include <set>
+#include <thread>
+#include <vector>
+
+#include <org-simple/ObjectPool.h>
+
+using namespace org::simple;
+
+namespace {
+
+struct Counted {
+  static inline int alive = 0;
+  size_t owner;
+  size_t value;
+
+  Counted(size_t o, size_t v) : owner(o), value(v) { alive++; }
+  ~Counted() { alive--; }
+};
+
+struct Owned {
+  std::atomic_size_t owner;
+  explicit Owned(size_t o) : owner(o) {}
+};
+
+using Pool = ObjectPool<Counted, 4>;
+
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(org_simple_util_ObjectPool)
+
+BOOST_AUTO_TEST_CASE(testInvalidCapacity) {
+  BOOST_CHECK_THROW(Pool(0), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(testCreateUntilExhaustedAndReuse) {
+  Pool pool(3);
+  std::set<Counted *> objects;
+  for (size_t i = 0; i < 3; i++) {
+    Counted *object = pool.create(0, i);
+    BOOST_REQUIRE(object != nullptr);
+    BOOST_CHECK(Align::isAlignedPointer(object, Align::cacheLine));
+    BOOST_CHECK_EQUAL(i, object->value);
+    objects.insert(object);
+  }
+  BOOST_CHECK_EQUAL(3, objects.size());
+  BOOST_CHECK_EQUAL(3, Counted::alive);
+  BOOST_CHECK(pool.create(0, 3) == nullptr);
+
+  Counted *released = *objects.begin();
+  pool.destroy(released);
+  BOOST_CHECK_EQUAL(2, Counted::alive);
+  Counted *reused = pool.create(0, 4);
+  BOOST_CHECK_EQUAL(released, reused);
+  BOOST_CHECK_EQUAL(4, reused->value);
+  for (Counted *object : objects) {
+    pool.destroy(object);
+  }
+  BOOST_CHECK_EQUAL(0, Counted::alive);
+}
+
+BOOST_AUTO_TEST_CASE(testMagazineCachesAndReturnsSlots) {
+  Pool pool(8);
+  std::vector<Counted *> objects;
+  {
+    Pool::Magazine magazine(pool);
+    for (size_t i = 0; i < 8; i++) {
+      objects.push_back(magazine.create(1, i));
+      BOOST_REQUIRE(objects.back() != nullptr);
+    }
+    BOOST_CHECK(magazine.create(1, 8) == nullptr);
+    BOOST_CHECK(pool.create(0, 8) == nullptr);
+
+    for (Counted *object : objects) {
+      magazine.destroy(object);
+      BOOST_CHECK_LE(magazine.cached(), 4);
+    }
+    // Full magazines return half of their slots to the pool
+    BOOST_CHECK_EQUAL(4, magazine.cached());
+    Counted *shared = pool.create(0, 9);
+    BOOST_CHECK(shared != nullptr);
+    pool.destroy(shared);
+  }
+  BOOST_CHECK_EQUAL(0, Counted::alive);
+  objects.clear();
+  for (size_t i = 0; i < 8; i++) {
+    objects.push_back(pool.create(0, i));
+    BOOST_REQUIRE(objects.back() != nullptr);
+  }
+  for (Counted *object : objects) {
+    pool.destroy(object);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(testMagazineTakesHalfOfItsSlotsAtOnce) {
+  Pool pool(3);
+  Pool::Magazine magazine(pool);
+  Counted *first = magazine.create(1, 0);
+  BOOST_REQUIRE(first != nullptr);
+  BOOST_CHECK_EQUAL(1, magazine.cached());
+  Counted *shared = pool.create(0, 1);
+  BOOST_REQUIRE(shared != nullptr);
+  Counted *second = magazine.create(1, 2);
+  BOOST_REQUIRE(second != nullptr);
+  BOOST_CHECK_EQUAL(0, magazine.cached());
+  BOOST_CHECK(magazine.create(1, 3) == nullptr);
+
+  // A partial chain when the pool has fewer slots left than half a magazine
+  pool.destroy(shared);
+  Counted *last = magazine.create(1, 4);
+  BOOST_REQUIRE(last != nullptr);
+  BOOST_CHECK_EQUAL(0, magazine.cached());
+  magazine.destroy(first);
+  magazine.destroy(second);
+  magazine.destroy(last);
+  BOOST_CHECK_EQUAL(0, Counted::alive);
+}
+
+BOOST_AUTO_TEST_CASE(testConcurrentChurnNeverSharesObjects) {
+  static constexpr size_t THREADS = 4;
+  static constexpr size_t ROUNDS = 20000;
+  static constexpr size_t BATCH = 6;
+  ObjectPool<Owned, 8> pool(THREADS * BATCH);
+  std::atomic_size_t errors = 0;
+
+  std::vector<std::thread> threads;
+  for (size_t t = 0; t < THREADS; t++) {
+    threads.emplace_back([&pool, &errors, t]() {
+      ObjectPool<Owned, 8>::Magazine magazine(pool);
+      Owned *objects[BATCH];
+      for (size_t round = 0; round < ROUNDS; round++) {
+        bool cached = round % 2;
+        size_t count = 0;
+        for (; count < BATCH; count++) {
+          Owned *object = cached ? magazine.create(t) : pool.create(t);
+          if (!object) {
+            break;
+          }
+          objects[count] = object;
+        }
+        std::this_thread::yield();
+        for (size_t i = 0; i < count; i++) {
+          if (objects[i]->owner.exchange(THREADS) != t) {
+            errors++;
+          }
+          cached ? magazine.destroy(objects[i]) : pool.destroy(objects[i]);
+        }
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  BOOST_CHECK_EQUAL(0, errors);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
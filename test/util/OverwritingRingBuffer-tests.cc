@@ -0,0 +1,130 @@
+//
+// Created by michel on 15-10-26.
+//
+
+#include "test-helper.h"
+#include <thread>
+
+#include <org-simple/OverwritingRingBuffer.h>
+
+using namespace org::simple;
+
+static constexpr size_t RING_SIZE = 8;
+using Ring = OverwritingRingBuffer<int, RING_SIZE>;
+
+BOOST_AUTO_TEST_SUITE(org_simple_util_OverwritingRingBuffer)
+
+BOOST_AUTO_TEST_CASE(testReadWhatWasWritten) {
+  Ring ring;
+  Ring::Reader reader(ring);
+  int values[RING_SIZE];
+
+  BOOST_CHECK_EQUAL(0, reader.read(values, RING_SIZE));
+  ring.write(1);
+  ring.write(2);
+  ring.write(3);
+  BOOST_CHECK_EQUAL(2, reader.read(values, 2));
+  BOOST_CHECK_EQUAL(1, values[0]);
+  BOOST_CHECK_EQUAL(2, values[1]);
+  int value = 0;
+  BOOST_CHECK(reader.read(value));
+  BOOST_CHECK_EQUAL(3, value);
+  BOOST_CHECK(!reader.read(value));
+  BOOST_CHECK_EQUAL(0, reader.lost());
+}
+
+BOOST_AUTO_TEST_CASE(testReaderStartsAtNewest) {
+  Ring ring;
+  ring.write(1);
+  Ring::Reader reader(ring);
+  int value = 0;
+
+  BOOST_CHECK(!reader.read(value));
+  ring.write(2);
+  BOOST_CHECK(reader.read(value));
+  BOOST_CHECK_EQUAL(2, value);
+}
+
+BOOST_AUTO_TEST_CASE(testLappedReaderResynchronises) {
+  Ring ring;
+  Ring::Reader reader(ring);
+  int values[RING_SIZE];
+
+  for (int i = 0; i < int(RING_SIZE) + 3; i++) {
+    ring.write(i);
+  }
+  BOOST_CHECK_EQUAL(RING_SIZE, reader.read(values, RING_SIZE + 1));
+  BOOST_CHECK_EQUAL(3, reader.lost());
+  for (size_t i = 0; i < RING_SIZE; i++) {
+    BOOST_CHECK_EQUAL(3 + i, values[i]);
+  }
+  BOOST_CHECK_EQUAL(ring.write_ptr(), reader.read_ptr());
+}
+
+BOOST_AUTO_TEST_CASE(testBulkWriteBeyondCapacity) {
+  Ring ring;
+  Ring::Reader reader(ring);
+  int written[RING_SIZE * 2 + 1];
+  int values[RING_SIZE];
+  for (size_t i = 0; i < RING_SIZE * 2 + 1; i++) {
+    written[i] = i;
+  }
+
+  ring.write(written, RING_SIZE * 2 + 1);
+  BOOST_CHECK_EQUAL(RING_SIZE * 2 + 1, ring.write_ptr());
+  BOOST_CHECK_EQUAL(RING_SIZE, reader.read(values, RING_SIZE));
+  BOOST_CHECK_EQUAL(RING_SIZE + 1, reader.lost());
+  for (size_t i = 0; i < RING_SIZE; i++) {
+    BOOST_CHECK_EQUAL(RING_SIZE + 1 + i, values[i]);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(testReadLatest) {
+  Ring ring;
+  Ring::Reader reader(ring);
+  int values[RING_SIZE];
+
+  for (int i = 0; i < 6; i++) {
+    ring.write(i);
+  }
+  BOOST_CHECK_EQUAL(2, reader.read_latest(values, 2));
+  BOOST_CHECK_EQUAL(4, values[0]);
+  BOOST_CHECK_EQUAL(5, values[1]);
+  BOOST_CHECK_EQUAL(4, reader.lost());
+  ring.write(6);
+  BOOST_CHECK_EQUAL(1, reader.read_latest(values, 2));
+  BOOST_CHECK_EQUAL(6, values[0]);
+  BOOST_CHECK_EQUAL(4, reader.lost());
+}
+
+BOOST_AUTO_TEST_CASE(testConcurrentReaderOnlySeesConsecutiveValues) {
+  static constexpr int VALUES = 200000;
+  Ring ring;
+  Ring::Reader reader(ring);
+  std::thread producer([&ring]() {
+    for (int i = 0; i < VALUES; i++) {
+      ring.write(i);
+    }
+  });
+  int values[3];
+  size_t errors = 0;
+  size_t read = 0;
+  while (reader.read_ptr() < size_t(VALUES)) {
+    size_t n = reader.read(values, 3);
+    if (!n) {
+      std::this_thread::yield();
+    }
+    // The values read are the ones just before the read position
+    for (size_t i = 0; i < n; i++) {
+      if (size_t(values[i]) != reader.read_ptr() - n + i) {
+        errors++;
+      }
+    }
+    read += n;
+  }
+  producer.join();
+  BOOST_CHECK_EQUAL(0, errors);
+  BOOST_CHECK_EQUAL(size_t(VALUES), read + reader.lost());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -4,8 +4,10 @@
 
 #include "test-helper.h"
 #include <org-simple/SampleLayout.h>
+#include <cstdint>
 #include <sstream>
 #include <string>
+#include <vector>
 
 using Layout = org::simple::SampleLayout;
 
@@ -57,10 +59,264 @@ const int interleaved_samples[SAMPLES] = {11, 21, 31, 12, 22, 32, 13, 23,
 const org::simple::NumArray<int, CHANNELS> sample_frames[FRAMES] =
     {{11, 21, 31}, {12, 22, 32}, {13, 23, 33}, {14, 24, 34}, {15, 25, 35}};
 
+template <typename S> S sample(size_t channel, size_t frame) {
+  return S(100 * channel + frame % 97 + 1);
+}
+
+/**
+ * Interleaves channel buffers and deinterleaves them again, checking the
+ * interleaved samples and the updated pointers. With CHANNELS and FRAMES
+ * zero, the runtime variants are used for \c channels and \c frames.
+ */
+template <typename S, size_t CHANNELS, size_t FRAMES>
+void checkRoundTrip(size_t channels = CHANNELS, size_t frames = FRAMES) {
+  std::vector<std::vector<S>> buffers(channels);
+  std::vector<std::vector<S>> results(channels);
+  std::vector<const S *> inputs(channels);
+  std::vector<S *> outputs(channels);
+  for (size_t channel = 0; channel < channels; channel++) {
+    for (size_t frame = 0; frame < frames; frame++) {
+      buffers[channel].push_back(sample<S>(channel, frame));
+    }
+    results[channel].resize(frames);
+    inputs[channel] = buffers[channel].data();
+    outputs[channel] = results[channel].data();
+  }
+  std::vector<S> interleaved(channels * frames + 1, S(-1));
+  S *output = interleaved.data();
+  if constexpr (CHANNELS != 0) {
+    Layout::channel_buffers_to_interleaved<S, CHANNELS, FRAMES>(inputs.data(),
+                                                                output);
+  } else {
+    Layout::channel_buffers_to_interleaved(inputs.data(), output, channels,
+                                           frames);
+  }
+  BOOST_CHECK_EQUAL(output - interleaved.data(), channels * frames);
+  BOOST_CHECK(interleaved.back() == S(-1));
+  for (size_t frame = 0; frame < frames; frame++) {
+    for (size_t channel = 0; channel < channels; channel++) {
+      BOOST_CHECK(interleaved[frame * channels + channel] ==
+                  sample<S>(channel, frame));
+    }
+  }
+  const S *input = interleaved.data();
+  if constexpr (CHANNELS != 0) {
+    Layout::interleaved_to_channel_buffers<S, CHANNELS, FRAMES>(
+        input, outputs.data());
+  } else {
+    Layout::interleaved_to_channel_buffers(input, outputs.data(), channels,
+                                           frames);
+  }
+  BOOST_CHECK_EQUAL(input - interleaved.data(), channels * frames);
+  for (size_t channel = 0; channel < channels; channel++) {
+    BOOST_CHECK_EQUAL(inputs[channel] - buffers[channel].data(), frames);
+    BOOST_CHECK_EQUAL(outputs[channel] - results[channel].data(), frames);
+    BOOST_CHECK(results[channel] == buffers[channel]);
+  }
+}
+
+/**
+ * Converts interleaved PCM samples to channel buffers and back, which must be
+ * exact for floating point types that can represent all samples.
+ */
+template <class Format, typename S>
+void checkPcmRoundTrip(const std::vector<int32_t> &values, size_t channels) {
+  using word = typename Format::word;
+  const size_t frames = values.size() / channels;
+  const size_t samples = frames * channels;
+  std::vector<word> pcm(samples * Format::WORDS);
+  for (size_t i = 0; i < samples; i++) {
+    Format::write(pcm.data() + i * Format::WORDS, values[i]);
+  }
+  std::vector<std::vector<S>> buffers(channels, std::vector<S>(frames));
+  std::vector<S *> outputs(channels);
+  std::vector<const S *> inputs(channels);
+  for (size_t channel = 0; channel < channels; channel++) {
+    outputs[channel] = buffers[channel].data();
+    inputs[channel] = buffers[channel].data();
+  }
+  const word *input = pcm.data();
+  Layout::pcm_to_channel_buffers<Format>(input, outputs.data(), channels,
+                                         frames);
+  BOOST_CHECK_EQUAL(input - pcm.data(), samples * Format::WORDS);
+  for (size_t frame = 0; frame < frames; frame++) {
+    for (size_t channel = 0; channel < channels; channel++) {
+      BOOST_CHECK_EQUAL(buffers[channel][frame],
+                        S(values[frame * channels + channel]) /
+                            S(int64_t(1) << (Format::BITS - 1)));
+    }
+  }
+  std::vector<word> result(samples * Format::WORDS);
+  word *output = result.data();
+  Layout::channel_buffers_to_pcm<Format>(inputs.data(), output, channels,
+                                         frames);
+  BOOST_CHECK_EQUAL(output - result.data(), samples * Format::WORDS);
+  BOOST_CHECK(result == pcm);
+  for (size_t channel = 0; channel < channels; channel++) {
+    BOOST_CHECK_EQUAL(outputs[channel] - buffers[channel].data(), frames);
+    BOOST_CHECK_EQUAL(inputs[channel] - buffers[channel].data(), frames);
+  }
+}
+
+std::vector<int32_t> pcmValues(int32_t minimum, int32_t maximum,
+                               size_t count) {
+  std::vector<int32_t> values{minimum, maximum, 0, 1, -1};
+  for (size_t i = values.size(); i < count; i++) {
+    values.push_back(int32_t(minimum + int64_t(i * 7919) % maximum));
+  }
+  return values;
+}
+
+template <class Format> int32_t toPcm(float value) {
+  const float *input = &value;
+  typename Format::word output[Format::WORDS];
+  typename Format::word *output_ptr = output;
+  Layout::channel_buffers_to_pcm<Format>(&input, output_ptr, 1, 1);
+  return Format::read(output);
+}
+
+/**
+ * Copies a planar view through an interleaved view, both with padding, to
+ * another planar view and checks that all samples arrive and that the
+ * padding is untouched.
+ */
+template <typename S>
+void checkViewCopy(size_t channels, size_t frames, size_t padding) {
+  using org::simple::SampleView;
+  const size_t channel_stride = frames + padding;
+  const size_t frame_stride = channels + padding;
+  std::vector<S> planar(channels * channel_stride, S(-1));
+  std::vector<S> interleaved(frames * frame_stride, S(-1));
+  std::vector<S> result(channels * channel_stride, S(-1));
+  auto source = SampleView<S>::planar(planar.data(), channels, frames,
+                                      channel_stride);
+  auto middle = SampleView<S>::interleaved(interleaved.data(), channels,
+                                           frames, frame_stride);
+  auto destination = SampleView<S>::planar(result.data(), channels, frames,
+                                           channel_stride);
+  for (size_t channel = 0; channel < channels; channel++) {
+    for (size_t frame = 0; frame < frames; frame++) {
+      source(channel, frame) = sample<S>(channel, frame);
+    }
+  }
+  Layout::copy(SampleView<const S>(source), middle);
+  Layout::copy(middle, destination);
+  for (size_t frame = 0; frame < frames; frame++) {
+    for (size_t channel = 0; channel < frame_stride; channel++) {
+      BOOST_CHECK(interleaved[frame * frame_stride + channel] ==
+                  (channel < channels ? sample<S>(channel, frame) : S(-1)));
+    }
+  }
+  BOOST_CHECK(result == planar);
+}
+
 } // namespace
 
 BOOST_AUTO_TEST_SUITE(org_simple_util_SampleLayout)
 
+BOOST_AUTO_TEST_CASE(testPcmRoundTrips) {
+  using namespace org::simple::sample_layout;
+  for (size_t channels : {1, 2, 3, 6, 8, 11}) {
+    for (size_t frames : {0, 5, 100, 1000}) {
+      BOOST_TEST_CONTEXT(channels << " channels, " << frames << " frames") {
+        size_t count = channels * frames;
+        checkPcmRoundTrip<Pcm16, float>(pcmValues(-32768, 32767, count),
+                                        channels);
+        checkPcmRoundTrip<PackedPcm24, float>(
+            pcmValues(-8388608, 8388607, count), channels);
+        checkPcmRoundTrip<Pcm32, double>(
+            pcmValues(-2147483647 - 1, 2147483647, count), channels);
+      }
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(testPackedPcm24IsLittleEndian) {
+  using Format = org::simple::sample_layout::PackedPcm24;
+  const uint8_t bytes[] = {0x56, 0x34, 0x12, 0x00, 0x00, 0x80};
+  BOOST_CHECK_EQUAL(0x123456, Format::read(bytes));
+  BOOST_CHECK_EQUAL(-8388608, Format::read(bytes + 3));
+}
+
+BOOST_AUTO_TEST_CASE(testPcmClipsAndRounds) {
+  using namespace org::simple::sample_layout;
+  BOOST_CHECK_EQUAL(32767, toPcm<Pcm16>(1.5f));
+  BOOST_CHECK_EQUAL(32767, toPcm<Pcm16>(1.0f));
+  BOOST_CHECK_EQUAL(-32768, toPcm<Pcm16>(-2.0f));
+  BOOST_CHECK_EQUAL(16384, toPcm<Pcm16>(0.5f));
+  BOOST_CHECK_EQUAL(1, toPcm<Pcm16>(1.4f / 32768));
+  BOOST_CHECK_EQUAL(-2, toPcm<Pcm16>(-1.6f / 32768));
+  BOOST_CHECK_EQUAL(8388607, toPcm<PackedPcm24>(1.0f));
+  BOOST_CHECK_EQUAL(2147483520, toPcm<Pcm32>(1.0f));
+  BOOST_CHECK_EQUAL(-2147483647 - 1, toPcm<Pcm32>(-1.0f));
+}
+
+BOOST_AUTO_TEST_CASE(testPcmTpdfDither) {
+  using namespace org::simple::sample_layout;
+  static constexpr size_t FRAMES = 100000;
+  std::vector<float> samples(FRAMES, 0.3f / 32768);
+  std::vector<int16_t> pcm(FRAMES);
+  TpdfDither dither;
+  for (bool dithered : {false, true}) {
+    const float *input = samples.data();
+    int16_t *output = pcm.data();
+    Layout::channel_buffers_to_pcm<Pcm16>(&input, output, 1, FRAMES,
+                                          dithered ? &dither : nullptr);
+    double sum = 0;
+    int16_t lowest = 0;
+    int16_t highest = 0;
+    for (int16_t value : pcm) {
+      sum += value;
+      lowest = std::min(lowest, value);
+      highest = std::max(highest, value);
+    }
+    if (dithered) {
+      BOOST_CHECK_CLOSE(0.3, sum / FRAMES, 3);
+      BOOST_CHECK_EQUAL(-1, lowest);
+      BOOST_CHECK_EQUAL(1, highest);
+    } else {
+      BOOST_CHECK_EQUAL(0, lowest);
+      BOOST_CHECK_EQUAL(0, highest);
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(testPcmNeedsChannelsThatFit) {
+  using namespace org::simple::sample_layout;
+  const int16_t pcm[1] = {0};
+  const int16_t *input = pcm;
+  float *output = nullptr;
+  BOOST_CHECK_THROW(
+      Layout::pcm_to_channel_buffers<Pcm16>(input, &output, 0, 1),
+      std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(testVectorizedChannelCounts) {
+  checkRoundTrip<float, 2, 13>();
+  checkRoundTrip<float, 4, 13>();
+  checkRoundTrip<float, 8, 13>();
+  checkRoundTrip<float, 6, 13>();
+  checkRoundTrip<double, 2, 7>();
+  checkRoundTrip<double, 4, 7>();
+  checkRoundTrip<double, 8, 7>();
+  checkRoundTrip<int16_t, 2, 21>();
+  checkRoundTrip<int16_t, 8, 21>();
+  checkRoundTrip<int8_t, 4, 35>();
+  checkRoundTrip<float, 4, 3>();
+}
+
+BOOST_AUTO_TEST_CASE(testRuntimeChannelCounts) {
+  for (size_t channels = 1; channels <= 17; channels++) {
+    for (size_t frames : {0, 1, 4, 9, 16}) {
+      BOOST_TEST_CONTEXT(channels << " channels, " << frames << " frames") {
+        checkRoundTrip<float, 0, 0>(channels, frames);
+        checkRoundTrip<double, 0, 0>(channels, frames);
+      }
+    }
+  }
+  checkRoundTrip<int32_t, 0, 0>(32, 64);
+}
+
 BOOST_AUTO_TEST_CASE(testChannelBuffersToInterleavedArray) {
   int output[SAMPLES];
   for (size_t i = 0; i < SAMPLES; i++) {
@@ -168,4 +424,57 @@ BOOST_AUTO_TEST_CASE(testFramesToChannelBuffers) {
   BOOST_CHECK_EQUAL(input_ptr - &sample_frames[0], FRAMES);
 }
 
+BOOST_AUTO_TEST_CASE(testSampleViewLayouts) {
+  using org::simple::SampleView;
+  float samples[24];
+  auto interleaved = SampleView<float>::interleaved(samples, 3, 8);
+  BOOST_CHECK(interleaved.is_interleaved());
+  BOOST_CHECK(!interleaved.is_planar());
+  BOOST_CHECK_EQUAL(3, interleaved.frame_stride());
+  BOOST_CHECK_EQUAL(&samples[7], &interleaved(1, 2));
+  auto planar = SampleView<float>::planar(samples, 3, 6, 8);
+  BOOST_CHECK(planar.is_planar());
+  BOOST_CHECK(!planar.is_interleaved());
+  BOOST_CHECK_EQUAL(&samples[18], &planar(2, 2));
+  BOOST_CHECK_EQUAL(&samples[16], planar.channel(2));
+  auto range = planar.frame_range(2, 4);
+  BOOST_CHECK_EQUAL(4, range.frames());
+  BOOST_CHECK_EQUAL(&samples[10], &range(1, 0));
+  SampleView<const float> constant = range;
+  BOOST_CHECK_EQUAL(&samples[10], &constant(1, 0));
+
+  BOOST_CHECK_THROW(planar.frame_range(4, 3), std::out_of_range);
+  BOOST_CHECK_THROW(SampleView<float>::interleaved(samples, 3, 8, 2),
+                    std::invalid_argument);
+  BOOST_CHECK_THROW(SampleView<float>::planar(samples, 3, 8, 7),
+                    std::invalid_argument);
+  BOOST_CHECK_THROW(Layout::copy(interleaved, planar), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(testSampleViewCopies) {
+  for (size_t channels : {1, 2, 3, 4, 5, 6, 7, 8, 9, 13, 64, 70}) {
+    for (size_t frames : {0, 3, 17}) {
+      BOOST_TEST_CONTEXT(channels << " channels, " << frames << " frames") {
+        checkViewCopy<float>(channels, frames, 0);
+        checkViewCopy<float>(channels, frames, 3);
+        checkViewCopy<double>(channels, frames, 1);
+      }
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(testSampleViewCopiesStrided) {
+  using org::simple::SampleView;
+  const float source[12] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12};
+  float destination[12] = {};
+  // Neither planar nor interleaved: channel 0 is 1 3 5 and channel 1 is 7 9 11
+  SampleView<const float> from(source, 2, 3, 6, 2);
+  auto to = SampleView<float>::interleaved(destination, 2, 3, 4);
+  Layout::copy(from, to);
+  const float expected[12] = {1, 7, 0, 0, 3, 9, 0, 0, 5, 11, 0, 0};
+  for (size_t i = 0; i < 12; i++) {
+    BOOST_CHECK_EQUAL(expected[i], destination[i]);
+  }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
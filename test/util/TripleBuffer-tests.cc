@@ -0,0 +1,96 @@
+//
+// Created by michel on 15-10-26.
+//
+
+#include "test-helper.h"
+#include <thread>
+
+#include <org-simple/TripleBuffer.h>
+
+using namespace org::simple;
+
+namespace {
+
+struct Configuration {
+  static constexpr size_t SIZE = 64;
+  size_t values[SIZE] = {0};
+
+  void set(size_t value) {
+    for (size_t &v : values) {
+      v = value;
+    }
+  }
+
+  bool consistent() const {
+    for (size_t v : values) {
+      if (v != values[0]) {
+        return false;
+      }
+    }
+    return true;
+  }
+};
+
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(org_simple_util_TripleBuffer)
+
+BOOST_AUTO_TEST_CASE(testInitialValue) {
+  TripleBuffer<int> buffer(5);
+
+  BOOST_CHECK(!buffer.update());
+  BOOST_CHECK_EQUAL(5, buffer.read_buffer());
+  BOOST_CHECK_EQUAL(5, buffer.read());
+}
+
+BOOST_AUTO_TEST_CASE(testReaderGetsNewestValue) {
+  TripleBuffer<int> buffer;
+
+  buffer.write(1);
+  BOOST_CHECK(buffer.update());
+  BOOST_CHECK_EQUAL(1, buffer.read_buffer());
+  BOOST_CHECK(!buffer.update());
+  BOOST_CHECK_EQUAL(1, buffer.read_buffer());
+
+  buffer.write(2);
+  buffer.write(3);
+  buffer.write(4);
+  BOOST_CHECK_EQUAL(4, buffer.read());
+  BOOST_CHECK(!buffer.update());
+}
+
+BOOST_AUTO_TEST_CASE(testWriteInPlace) {
+  TripleBuffer<Configuration> buffer;
+
+  buffer.write_buffer().set(3);
+  BOOST_CHECK(!buffer.update());
+  buffer.publish();
+  BOOST_CHECK(buffer.update());
+  BOOST_CHECK(buffer.read_buffer().consistent());
+  BOOST_CHECK_EQUAL(3, buffer.read_buffer().values[0]);
+}
+
+BOOST_AUTO_TEST_CASE(testConcurrentReaderSeesConsistentIncreasingValues) {
+  static constexpr size_t VALUES = 20000;
+  TripleBuffer<Configuration> buffer;
+  std::thread writer([&buffer]() {
+    for (size_t i = 1; i <= VALUES; i++) {
+      buffer.write_buffer().set(i);
+      buffer.publish();
+    }
+  });
+  size_t errors = 0;
+  size_t last = 0;
+  while (last < VALUES) {
+    const Configuration &configuration = buffer.read();
+    if (!configuration.consistent() || configuration.values[0] < last) {
+      errors++;
+    }
+    last = configuration.values[0];
+    std::this_thread::yield();
+  }
+  writer.join();
+  BOOST_CHECK_EQUAL(0, errors);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
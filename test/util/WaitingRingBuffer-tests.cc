@@ -0,0 +1,84 @@
+//
+// Created by michel on 15-10-26.
+//
+
+#include "test-helper.h"
+#include <thread>
+
+#include <org-simple/WaitingRingBuffer.h>
+
+using namespace org::simple;
+
+namespace {
+
+static constexpr size_t CAPACITY = 4;
+using Buffer = WaitingRingBuffer<RingBufferLockFreeFixedSize<int, CAPACITY>>;
+using Clock = std::chrono::steady_clock;
+
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(org_simple_util_WaitingRingBuffer)
+
+BOOST_AUTO_TEST_CASE(testReadWaitReturnsAvailableValue) {
+  Buffer buffer;
+  int value = 0;
+
+  BOOST_CHECK(buffer.write(3));
+  BOOST_CHECK(buffer.read_wait(value, TimeoutImmediately::instance()));
+  BOOST_CHECK_EQUAL(3, value);
+}
+
+BOOST_AUTO_TEST_CASE(testReadWaitTimesOutOnEmpty) {
+  Buffer buffer;
+  int value = 0;
+  TimeoutWithDeadline<Clock> timeout(std::chrono::milliseconds(10));
+
+  BOOST_CHECK(!buffer.read_wait(value, timeout));
+  BOOST_CHECK(Clock::now() >= timeout.deadline());
+}
+
+BOOST_AUTO_TEST_CASE(testWriteWaitTimesOutOnFull) {
+  Buffer buffer;
+  for (size_t i = 0; i < CAPACITY; i++) {
+    BOOST_CHECK(buffer.write(i));
+  }
+  TimeoutWithDeadline<Clock> timeout(std::chrono::milliseconds(10));
+
+  BOOST_CHECK(!buffer.write_wait(13, timeout));
+  BOOST_CHECK(buffer.full());
+}
+
+BOOST_AUTO_TEST_CASE(testReadWaitIsWokenByWrite) {
+  Buffer buffer;
+  int value = 0;
+  std::thread producer([&buffer]() {
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    buffer.write(7);
+  });
+
+  BOOST_CHECK(buffer.read_wait(value, TimeoutNever::instance()));
+  BOOST_CHECK_EQUAL(7, value);
+  producer.join();
+}
+
+BOOST_AUTO_TEST_CASE(testWaitingTransfer) {
+  static constexpr int VALUES = 20000;
+  Buffer buffer;
+  std::thread producer([&buffer]() {
+    for (int i = 0; i < VALUES; i++) {
+      buffer.write_wait(i, TimeoutNever::instance());
+    }
+  });
+  size_t errors = 0;
+  for (int i = 0; i < VALUES; i++) {
+    int value = -1;
+    if (!buffer.read_wait(value, TimeoutNever::instance()) || value != i) {
+      errors++;
+    }
+  }
+  producer.join();
+  BOOST_CHECK_EQUAL(0, errors);
+  BOOST_CHECK(buffer.empty());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
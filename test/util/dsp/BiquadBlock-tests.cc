@@ -0,0 +1,115 @@
+//
+// Created by michel on 16-10-26.
+//
+
+#include "test-helper.h"
+#include "util/text/dsp-test-helper.h"
+#include <cmath>
+#include <org-simple/dsp/BiquadBlock.h>
+#include <vector>
+
+using namespace org::simple::dsp;
+
+namespace {
+
+/**
+ * Returns whether the largest difference between \c expected and \c actual
+ * is small, relative to the largest expected value.
+ */
+template <typename T>
+bool equivalent(const std::vector<T> &expected, const std::vector<T> &actual,
+                T tolerance) {
+  T peak = 1;
+  T difference = 0;
+  for (size_t i = 0; i < expected.size(); i++) {
+    peak = std::max(peak, std::abs(expected[i]));
+    difference = std::max(difference, std::abs(expected[i] - actual[i]));
+  }
+  return difference <= tolerance * peak;
+}
+
+/**
+ * Compares BiQuadBlock::apply() with BiQuad::Coefficients::apply() for every
+ * length up to a few blocks, and in a longer run.
+ */
+template <typename T, size_t K> void checkApply(T tolerance) {
+  for (const auto &coefficients : testFilters<T>()) {
+    BiQuadBlock<T, K> block(coefficients);
+    for (size_t len : {2, 3, 5, 8, 9, 16, 17, 31, 33, 64, 1000, 20000}) {
+      BOOST_TEST_CONTEXT("K " << K << ", length " << len) {
+        auto x = testSignal<T>(len);
+        std::vector<T> expected(len);
+        std::vector<T> actual(len);
+        coefficients.apply(x.data(), expected.data(), len);
+        block.apply(x.data(), actual.data(), len);
+        BOOST_CHECK(equivalent(expected, actual, tolerance));
+      }
+    }
+  }
+}
+
+/**
+ * Compares BiQuadBlock::applyWithHistory() with
+ * BiQuad::Coefficients::applyWithHistory() over a number of calls with
+ * lengths that are not a multiple of K.
+ */
+template <typename T, size_t K> void checkHistory(T tolerance) {
+  static constexpr size_t LEN = 3000;
+  auto x = testSignal<T>(LEN);
+  for (const auto &coefficients : testFilters<T>()) {
+    BiQuadBlock<T, K> block(coefficients);
+    std::vector<T> expected(LEN);
+    std::vector<T> actual(LEN);
+    BiQuad::History<T> expectedHistory;
+    BiQuad::History<T> actualHistory;
+    size_t done = 0;
+    for (size_t len = 1; done < LEN; len = len * 3 + 1) {
+      len = std::min(len, LEN - done);
+      coefficients.applyWithHistory(x.data() + done, expected.data() + done,
+                                    len, expectedHistory);
+      block.applyWithHistory(x.data() + done, actual.data() + done, len,
+                             actualHistory);
+      done += len;
+    }
+    BOOST_TEST_CONTEXT("K " << K) {
+      BOOST_CHECK(equivalent(expected, actual, tolerance));
+      BOOST_CHECK_EQUAL(expectedHistory.x1, actualHistory.x1);
+      BOOST_CHECK_EQUAL(expectedHistory.x2, actualHistory.x2);
+    }
+  }
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(org_simple_dsp_BiquadBlock)
+
+BOOST_AUTO_TEST_CASE(testBlockMatchesApply) {
+  checkApply<float, 2>(1e-4f);
+  checkApply<float, 4>(1e-4f);
+  checkApply<float, 8>(1e-4f);
+  checkApply<float, 16>(1e-4f);
+  checkApply<double, 4>(1e-12);
+  checkApply<double, 8>(1e-12);
+}
+
+BOOST_AUTO_TEST_CASE(testBlockMatchesApplyWithHistory) {
+  checkHistory<float, 4>(1e-4f);
+  checkHistory<float, 8>(1e-4f);
+  checkHistory<double, 16>(1e-12);
+}
+
+BOOST_AUTO_TEST_CASE(testBlockOfImpulse) {
+  BiQuad::Coefficients<double> coefficients;
+  BiQuad::Butterworth::configureLowPass(coefficients, 48000, 1000);
+  BiQuadBlock<double, 4> block(coefficients);
+  std::vector<double> x(12, 0.0);
+  x[0] = 1;
+  std::vector<double> y(12);
+  block.apply(x.data(), y.data(), 12);
+  BiQuad::History<double> history;
+  for (size_t i = 0; i < 12; i++) {
+    BOOST_CHECK_CLOSE(coefficients.runAndGet(history, x[i]), y[i], 1e-10);
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,171 @@
+//
+// Created by michel on 16-10-26.
+//
+
+#include "test-helper.h"
+#include "util/text/dsp-test-helper.h"
+#include <cmath>
+#include <org-simple/dsp/BiquadCascade.h>
+#include <vector>
+
+using namespace org::simple::dsp;
+
+namespace {
+
+/**
+ * Returns a different low-pass or high-pass section for every channel and
+ * section.
+ */
+template <typename T>
+BiQuad::Coefficients<T> coefficients(size_t channel, size_t section) {
+  BiQuad::Coefficients<T> result;
+  const double frequency = 100.0 * (1 + channel) + 1000.0 * section;
+  if ((channel + section) % 2) {
+    BiQuad::Butterworth::configureHighPass(result, 48000, frequency);
+  } else {
+    BiQuad::Butterworth::configureLowPass(result, 48000, frequency);
+  }
+  return result;
+}
+
+template <typename T> bool close(T expected, T actual) {
+  return std::abs(expected - actual) <=
+         (sizeof(T) == sizeof(float) ? 1e-4 : 1e-12) *
+             std::max(T(1), std::abs(expected));
+}
+
+/**
+ * Filters \c channels channels in two calls with a cascade and with
+ * BiQuad::Coefficients::applyWithHistory() for every channel and section and
+ * compares the results.
+ */
+template <typename T, size_t GROUP>
+void checkCascade(size_t channels, size_t sections, size_t frames) {
+  using Cascade = BiQuadCascade<T, GROUP>;
+  Cascade cascade(channels, sections);
+  std::vector<std::vector<T>> expected(channels, std::vector<T>(frames));
+  std::vector<std::vector<T>> actual(channels, std::vector<T>(frames));
+  for (size_t channel = 0; channel < channels; channel++) {
+    std::vector<T> input(frames);
+    for (size_t frame = 0; frame < frames; frame++) {
+      input[frame] = testSample<T>(frame, channel);
+      actual[channel][frame] = input[frame];
+    }
+    for (size_t section = 0; section < sections; section++) {
+      auto c = coefficients<T>(channel, section);
+      cascade.setCoefficients(channel, section, c);
+      typename Cascade::History history;
+      c.applyWithHistory(input.data(), expected[channel].data(), frames,
+                         history);
+      input = expected[channel];
+    }
+  }
+  std::vector<T *> pointers(channels);
+  const size_t split = frames / 3;
+  for (size_t channel = 0; channel < channels; channel++) {
+    pointers[channel] = actual[channel].data();
+  }
+  cascade.apply(pointers.data(), pointers.data(), split);
+  for (size_t channel = 0; channel < channels; channel++) {
+    pointers[channel] += split;
+  }
+  cascade.apply(pointers.data(), pointers.data(), frames - split);
+
+  for (size_t channel = 0; channel < channels; channel++) {
+    for (size_t frame = 0; frame < frames; frame++) {
+      if (!close(expected[channel][frame], actual[channel][frame])) {
+        BOOST_CHECK_EQUAL(expected[channel][frame], actual[channel][frame]);
+        return;
+      }
+    }
+  }
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(org_simple_dsp_BiquadCascade)
+
+BOOST_AUTO_TEST_CASE(testCascadeMatchesApplyWithHistory) {
+  for (size_t channels : {1, 2, 3, 4, 5, 8, 13, 16, 17, 32}) {
+    BOOST_TEST_CONTEXT("channels " << channels) {
+      checkCascade<float, 4>(channels, 3, 200);
+      checkCascade<float, 8>(channels, 1, 200);
+      checkCascade<float, 16>(channels, 8, 200);
+      checkCascade<double, 2>(channels, 2, 200);
+      checkCascade<double, 8>(channels, 4, 200);
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(testCascadeShortBlocks) {
+  for (size_t frames = 0; frames < 5; frames++) {
+    BOOST_TEST_CONTEXT("frames " << frames) {
+      checkCascade<float, 4>(6, 2, frames);
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(testCascadePaddingLanesStayZero) {
+  static constexpr size_t GROUP = 4;
+  static constexpr size_t CHANNELS = 5;
+  static constexpr size_t FRAMES = 200;
+  BiQuadCascade<float, GROUP> cascade(CHANNELS, 2);
+  std::vector<std::vector<float>> buffers(CHANNELS, std::vector<float>(FRAMES));
+  std::vector<float *> pointers(CHANNELS);
+  for (size_t channel = 0; channel < CHANNELS; channel++) {
+    for (size_t section = 0; section < 2; section++) {
+      cascade.setCoefficients(channel, section,
+                              coefficients<float>(channel, section));
+    }
+    for (size_t frame = 0; frame < FRAMES; frame++) {
+      buffers[channel][frame] = testSample<float>(frame, channel);
+    }
+    pointers[channel] = buffers[channel].data();
+  }
+  for (size_t round = 0; round < 2; round++) {
+    cascade.apply(pointers.data(), pointers.data(), FRAMES);
+    const size_t lastBlock =
+        FRAMES % cascade.BLOCK_FRAMES ? FRAMES % cascade.BLOCK_FRAMES
+                                      : cascade.BLOCK_FRAMES;
+    for (size_t frame = 0; frame < lastBlock; frame++) {
+      for (size_t lane = CHANNELS % GROUP; lane < GROUP; lane++) {
+        BOOST_CHECK_EQUAL(0.0f, cascade.block()[frame * GROUP + lane]);
+      }
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(testCascadeCoefficientsAndHistory) {
+  BiQuadCascade<float, 4> cascade(5, 2);
+  BOOST_CHECK_EQUAL(5u, cascade.channels());
+  BOOST_CHECK_EQUAL(2u, cascade.sections());
+  BOOST_CHECK_EQUAL(2u, cascade.groups());
+  BOOST_CHECK_EQUAL(1.0f, cascade.coefficients(4, 1).b0);
+  BOOST_CHECK_EQUAL(0.0f, cascade.coefficients(4, 1).a1);
+
+  auto lowPass = coefficients<float>(0, 0);
+  cascade.setCoefficients(1, lowPass);
+  for (size_t channel = 0; channel < 5; channel++) {
+    BOOST_CHECK_EQUAL(lowPass.b1, cascade.coefficients(channel, 1).b1);
+    BOOST_CHECK_EQUAL(lowPass.a2, cascade.coefficients(channel, 1).a2);
+    BOOST_CHECK_EQUAL(1.0f, cascade.coefficients(channel, 0).b0);
+  }
+
+  cascade.setHistory(4, 1, {1, 2, 3, 4});
+  auto history = cascade.history(4, 1);
+  BOOST_CHECK_EQUAL(1.0f, history.x1);
+  BOOST_CHECK_EQUAL(2.0f, history.x2);
+  BOOST_CHECK_EQUAL(3.0f, history.y1);
+  BOOST_CHECK_EQUAL(4.0f, history.y2);
+  BOOST_CHECK_EQUAL(0.0f, cascade.history(3, 1).x1);
+  cascade.zero();
+  BOOST_CHECK_EQUAL(0.0f, cascade.history(4, 1).y2);
+
+  BOOST_CHECK_THROW(cascade.coefficients(5, 0), std::out_of_range);
+  BOOST_CHECK_THROW(cascade.history(0, 2), std::out_of_range);
+  BOOST_CHECK_THROW(cascade.setCoefficients(2, lowPass), std::out_of_range);
+  BOOST_CHECK_THROW((BiQuadCascade<float, 4>(0, 1)), std::invalid_argument);
+  BOOST_CHECK_THROW((BiQuadCascade<float, 4>(1, 0)), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,116 @@
+//
+// Created by michel on 16-10-26.
+//
+
+#include "test-helper.h"
+#include "util/text/dsp-test-helper.h"
+#include <cmath>
+#include <org-simple/dsp/BiquadTopology.h>
+#include <vector>
+
+using namespace org::simple::dsp;
+
+namespace {
+
+/**
+ * Compares the topology with BiQuad::Coefficients::applyWithHistory() in
+ * double precision, in two calls to apply() and with run().
+ */
+template <template <typename> class Topology> void checkTopology() {
+  static constexpr size_t LEN = 1000;
+  static constexpr size_t SPLIT = 377;
+  auto x = testSignal<double>(LEN);
+  for (const auto &coefficients : testFilters<double>()) {
+    std::vector<double> expected(LEN);
+    BiQuad::History<double> history;
+    coefficients.applyWithHistory(x.data(), expected.data(), LEN, history);
+
+    Topology<double> topology(coefficients);
+    typename Topology<double>::template State<double> state;
+    std::vector<double> applied(LEN);
+    topology.apply(x.data(), applied.data(), SPLIT, state);
+    topology.apply(x.data() + SPLIT, applied.data() + SPLIT, LEN - SPLIT,
+                   state);
+    typename Topology<double>::template State<double> runState;
+    double difference = 0;
+    for (size_t i = 0; i < LEN; i++) {
+      const double run = topology.run(runState, x[i]);
+      difference = std::max(difference, std::abs(expected[i] - applied[i]));
+      difference = std::max(difference, std::abs(expected[i] - run));
+    }
+    BOOST_CHECK_LE(difference, 1e-9);
+  }
+}
+
+/**
+ * Returns the power of the difference between filtering in float with the
+ * topology and in double with the direct form I, relative to the power of
+ * the output, in decibels.
+ */
+template <template <typename> class Topology>
+double noiseFloor(const BiQuad::Coefficients<float> &coefficients) {
+  static constexpr size_t LEN = 1 << 15;
+  auto x = testSignal<float>(LEN);
+  std::vector<double> input(x.begin(), x.end());
+  std::vector<double> exact(LEN);
+  BiQuad::Coefficients<double> precise;
+  precise.b0 = coefficients.b0;
+  precise.b1 = coefficients.b1;
+  precise.b2 = coefficients.b2;
+  precise.a1 = coefficients.a1;
+  precise.a2 = coefficients.a2;
+  BiQuad::History<double> history;
+  precise.applyWithHistory(input.data(), exact.data(), LEN, history);
+
+  Topology<float> topology(coefficients);
+  typename Topology<float>::template State<float> state;
+  std::vector<float> y(LEN);
+  topology.apply(x.data(), y.data(), LEN, state);
+  double noise = 0;
+  double power = 0;
+  for (size_t i = 0; i < LEN; i++) {
+    noise += (exact[i] - y[i]) * (exact[i] - y[i]);
+    power += exact[i] * exact[i];
+  }
+  return 10 * std::log10(noise / power);
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(org_simple_dsp_BiquadTopology)
+
+BOOST_AUTO_TEST_CASE(testDirectForm1MatchesCoefficients) {
+  checkTopology<BiQuadDirectForm1>();
+}
+
+BOOST_AUTO_TEST_CASE(testTransposedDirectForm2MatchesCoefficients) {
+  checkTopology<BiQuadTransposedDirectForm2>();
+}
+
+BOOST_AUTO_TEST_CASE(testStateVariableMatchesCoefficients) {
+  checkTopology<BiQuadStateVariable>();
+}
+
+BOOST_AUTO_TEST_CASE(testStateVariableNeedsStableFilter) {
+  BiQuad::Coefficients<double> coefficients;
+  coefficients.a1 = 1.5;
+  coefficients.a2 = -0.4;
+  BOOST_CHECK_THROW(BiQuadStateVariable<double>{coefficients},
+                    std::invalid_argument);
+  coefficients.a1 = 0;
+  coefficients.a2 = -1;
+  BOOST_CHECK_THROW(BiQuadStateVariable<double>{coefficients},
+                    std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(testStateVariableIsPreciseAtLowFrequencies) {
+  BiQuad::Coefficients<float> coefficients;
+  BiQuad::Butterworth::configureHighPass(coefficients, 192000, 20);
+  BOOST_CHECK_LT(noiseFloor<BiQuadStateVariable>(coefficients) + 20,
+                 noiseFloor<BiQuadDirectForm1>(coefficients));
+  BiQuad::Butterworth::configureLowPass(coefficients, 192000, 20);
+  BOOST_CHECK_LT(noiseFloor<BiQuadStateVariable>(coefficients) + 20,
+                 noiseFloor<BiQuadTransposedDirectForm2>(coefficients));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,182 @@
+//
+// Created by michel on 16-10-26.
+//
+
+#include "test-helper.h"
+#include "util/text/dsp-test-helper.h"
+#include <cmath>
+#include <org-simple/dsp/filtfilt.h>
+#include <vector>
+
+using namespace org::simple::dsp;
+
+namespace {
+
+/**
+ * Filters the extended signal in a full buffer with the feed forward and
+ * feed backward coefficients of iir-filter.h, starting from the steady
+ * state of its first sample.
+ */
+std::vector<double> filterOnce(const std::vector<double> &x,
+                               const std::vector<double> &ff,
+                               const std::vector<double> &fb) {
+  const size_t order = ff.size() - 1;
+  double numerator = 0;
+  double denominator = 1;
+  for (size_t j = 0; j <= order; j++) {
+    numerator += ff[j];
+    denominator += j ? fb[j] : 0;
+  }
+  const double gain = numerator / denominator;
+  std::vector<double> y(x.size());
+  for (size_t n = 0; n < x.size(); n++) {
+    double yN = ff[0] * x[n];
+    for (size_t j = 1; j <= order; j++) {
+      const double xJ = n >= j ? x[n - j] : x[0];
+      const double yJ = n >= j ? y[n - j] : gain * x[0];
+      yN += ff[j] * xJ - fb[j] * yJ;
+    }
+    y[n] = yN;
+  }
+  return y;
+}
+
+std::vector<double> reference(const std::vector<double> &x,
+                              const std::vector<double> &ff,
+                              const std::vector<double> &fb) {
+  const size_t count = x.size();
+  const size_t pad = zero_phase::padding(ff.size() - 1, count);
+  std::vector<double> extended;
+  for (size_t i = pad; i > 0; i--) {
+    extended.push_back(2 * x[0] - x[i]);
+  }
+  extended.insert(extended.end(), x.begin(), x.end());
+  for (size_t i = 1; i <= pad; i++) {
+    extended.push_back(2 * x[count - 1] - x[count - 1 - i]);
+  }
+  std::vector<double> forward = filterOnce(extended, ff, fb);
+  std::vector<double> reversed(forward.rbegin(), forward.rend());
+  std::vector<double> backward = filterOnce(reversed, ff, fb);
+  return {backward.rbegin() + pad, backward.rbegin() + pad + count};
+}
+
+BiQuad::Coefficients<double> lowPass() {
+  BiQuad::Coefficients<double> coefficients;
+  BiQuad::Butterworth::configureLowPass(coefficients, 48000, 1000);
+  return coefficients;
+}
+
+std::vector<double> feedForward(const BiQuad::Coefficients<double> &c) {
+  return {c.b0, c.b1, c.b2};
+}
+
+std::vector<double> feedBackward(const BiQuad::Coefficients<double> &c) {
+  return {1, -c.a1, -c.a2};
+}
+
+const size_t lengths[] = {1, 2, 5, 10, 100, zero_phase::BLOCK,
+                          3 * zero_phase::BLOCK + 77};
+
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(org_simple_dsp_filtfilt)
+
+BOOST_AUTO_TEST_CASE(testBiQuadMatchesReference) {
+  const auto coefficients = lowPass();
+  for (size_t len : lengths) {
+    auto x = testSignal(len);
+    auto expected = reference(x, feedForward(coefficients),
+                              feedBackward(coefficients));
+    std::vector<double> y(len);
+    filtfilt(coefficients, x.data(), y.data(), len);
+    BOOST_CHECK_LE(maximumDifference(expected, y), 1e-12);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(testBiQuadInPlace) {
+  const auto coefficients = lowPass();
+  for (size_t len : lengths) {
+    auto x = testSignal(len);
+    std::vector<double> y(len);
+    filtfilt(coefficients, x.data(), y.data(), len);
+    filtfilt(coefficients, x.data(), x.data(), len);
+    BOOST_CHECK_EQUAL(maximumDifference(x, y), 0);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(testCoefficientsMatchBiQuad) {
+  const auto coefficients = lowPass();
+  const auto ff = feedForward(coefficients);
+  const auto fb = feedBackward(coefficients);
+  for (size_t len : lengths) {
+    auto x = testSignal(len);
+    std::vector<double> expected(len);
+    std::vector<double> y(len);
+    filtfilt(coefficients, x.data(), expected.data(), len);
+    filtfilt(2, ff.data(), fb.data(), x.data(), y.data(), len);
+    BOOST_CHECK_LE(maximumDifference(expected, y), 1e-12);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(testFourthOrderMatchesReference) {
+  // Two cascaded low-pass biquads, with the denominator of iir-filter.h.
+  const auto c = lowPass();
+  const std::vector<double> b = feedForward(c);
+  const std::vector<double> a = feedBackward(c);
+  std::vector<double> ff(5, 0);
+  std::vector<double> fb(5, 0);
+  for (size_t i = 0; i < 3; i++) {
+    for (size_t j = 0; j < 3; j++) {
+      ff[i + j] += b[i] * b[j];
+      fb[i + j] += a[i] * a[j];
+    }
+  }
+  for (size_t len : lengths) {
+    auto x = testSignal(len);
+    auto expected = reference(x, ff, fb);
+    filtfilt(4, ff.data(), fb.data(), x.data(), x.data(), len);
+    BOOST_CHECK_LE(maximumDifference(expected, x), 1e-10);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(testConstantHasNoEdgeTransients) {
+  const auto coefficients = lowPass();
+  std::vector<double> x(1000, 0.5);
+  std::vector<double> y(x.size());
+  filtfilt(coefficients, x.data(), y.data(), x.size());
+  BOOST_CHECK_LE(maximumDifference(x, y), 1e-12);
+}
+
+BOOST_AUTO_TEST_CASE(testSineHasNoPhaseShift) {
+  const auto coefficients = lowPass();
+  static constexpr size_t LEN = 4800;
+  std::vector<double> x(LEN);
+  for (size_t i = 0; i < LEN; i++) {
+    x[i] = std::sin(2 * M_PI * 100 * double(i) / 48000);
+  }
+  std::vector<double> y(LEN);
+  filtfilt(coefficients, x.data(), y.data(), LEN);
+  // Like filtfilt of SciPy, the padding is too short to avoid all transients
+  // of a filter with poles this close to one, so check away from the edges.
+  static constexpr size_t EDGE = 480;
+  double difference = 0;
+  for (size_t i = EDGE; i < LEN - EDGE; i++) {
+    difference = std::max(difference, std::abs(x[i] - y[i]));
+  }
+  BOOST_CHECK_LE(difference, 1e-3);
+}
+
+BOOST_AUTO_TEST_CASE(testInvalidFilters) {
+  const double ff[] = {1, 0, 0};
+  const double fb[] = {1, -1, 0};
+  double x[4] = {1, 2, 3, 4};
+  BOOST_CHECK_THROW(filtfilt(0, ff, fb, x, x, 4), std::invalid_argument);
+  BOOST_CHECK_THROW(filtfilt(zero_phase::MAX_ORDER + 1, ff, fb, x, x, 4),
+                    std::invalid_argument);
+  BOOST_CHECK_THROW(filtfilt(1, ff, fb, x, x, 4), std::invalid_argument);
+  BiQuad::Coefficients<double> integrator;
+  integrator.a1 = 1;
+  BOOST_CHECK_THROW(filtfilt(integrator, x, x, 4), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,176 @@
+//
+// Created by michel on 16-10-26.
+//
+
+#include "test-helper.h"
+#include "util/text/dsp-test-helper.h"
+#include <cmath>
+#include <org-simple/dsp/iir-coefficients.h>
+#include <org-simple/dsp/iir-filter.h>
+#include <vector>
+
+using namespace org::simple::dsp;
+
+namespace {
+
+/**
+ * Returns stable coefficients of order \c order, that has its poles on a
+ * circle with radius 0.9, so that the feedback is significant.
+ */
+void coefficients(size_t order, std::vector<double> &ff,
+                  std::vector<double> &fb) {
+  ff.assign(order + 1, 0);
+  fb.assign(order + 1, 0);
+  fb[0] = 1;
+  for (size_t k = 0; k < order; k++) {
+    // Multiply the denominator by (1 - p z^-1) with a real pole p.
+    const double p = 0.9 * std::cos(M_PI * (k + 0.5) / order);
+    for (size_t j = k + 1; j > 0; j--) {
+      fb[j] -= p * fb[j - 1];
+    }
+  }
+  for (size_t j = 0; j <= order; j++) {
+    ff[j] = 1.0 / double(j + 2);
+  }
+}
+
+/**
+ * Compares filter_forward_foh() and filter_backward_foh() with the buffers
+ * with history of filter_forward_oo() and filter_backward_oo(), in blocks
+ * whose lengths are not a multiple of the order.
+ */
+template <size_t ORDER> void checkUnrolled() {
+  static constexpr size_t LEN = 1000;
+  std::vector<double> ff;
+  std::vector<double> fb;
+  coefficients(ORDER, ff, fb);
+  auto x = testSignal(LEN + 2 * ORDER);
+
+  std::vector<double> expected(LEN + 2 * ORDER, 0.0);
+  std::vector<double> actual(LEN + 2 * ORDER, 0.0);
+  filter_forward_oo(ORDER, LEN, ff.data(), fb.data(), x.data(),
+                    expected.data());
+  double xHistory[ORDER];
+  double yHistory[ORDER];
+  for (size_t i = 0; i < ORDER; i++) {
+    xHistory[i] = x[ORDER - 1 - i];
+    yHistory[i] = 0;
+  }
+  for (size_t done = 0, len = 1; done < LEN; done += len, len = len * 2 + 1) {
+    len = std::min(len, LEN - done);
+    filter_forward_foh<double, double, ORDER>(
+        len, ff.data(), fb.data(), x.data() + ORDER + done,
+        actual.data() + ORDER + done, xHistory, yHistory);
+  }
+  BOOST_CHECK_LE(maximumDifference(expected, actual), 1e-12);
+  for (size_t i = 0; i < ORDER; i++) {
+    BOOST_CHECK_EQUAL(xHistory[i], x[ORDER + LEN - 1 - i]);
+    BOOST_CHECK_LE(std::abs(yHistory[i] - expected[ORDER + LEN - 1 - i]),
+                   1e-12);
+  }
+
+  std::fill(expected.begin(), expected.end(), 0.0);
+  std::fill(actual.begin(), actual.end(), 0.0);
+  filter_backward_oo(ORDER, LEN, ff.data(), fb.data(), x.data(),
+                     expected.data());
+  for (size_t i = 0; i < ORDER; i++) {
+    xHistory[i] = x[LEN + i];
+    yHistory[i] = 0;
+  }
+  for (size_t end = LEN, len = 1; end > 0; end -= len, len = len * 2 + 1) {
+    len = std::min(len, end);
+    filter_backward_foh<double, double, ORDER>(
+        len, ff.data(), fb.data(), x.data() + end - len,
+        actual.data() + end - len, xHistory, yHistory);
+  }
+  BOOST_CHECK_LE(maximumDifference(expected, actual), 1e-12);
+}
+
+/**
+ * Compares FixedOrderCoefficients, that uses a FixedOrderKernel, with
+ * FixedOrderCoefficients of a higher order with zero coefficients, that uses
+ * the generic implementation.
+ */
+template <size_t ORDER> void checkCoefficients() {
+  static constexpr size_t LEN = 500;
+  static constexpr size_t GENERIC = MAX_UNROLLED_ORDER + 1;
+  std::vector<double> ff;
+  std::vector<double> fb;
+  coefficients(ORDER, ff, fb);
+  FixedOrderCoefficients<double, ORDER> unrolled;
+  FixedOrderCoefficients<double, GENERIC> generic;
+  for (size_t j = 0; j <= GENERIC; j++) {
+    // setFF() and setFB() swap feed forward and feed backward.
+    generic.setFB(j, j <= ORDER ? ff[j] : 0);
+    generic.setFF(j, j <= ORDER ? -fb[j] : 0);
+    if (j <= ORDER) {
+      unrolled.setFB(j, ff[j]);
+      unrolled.setFF(j, -fb[j]);
+    }
+  }
+  auto x = testSignal(LEN + 2 * GENERIC);
+  std::vector<double> expected(x.size(), 0.0);
+  std::vector<double> actual(x.size(), 0.0);
+  generic.filter_forward_offs(LEN, x.data(), expected.data());
+  unrolled.filter_forward_offs(LEN, x.data() + GENERIC - ORDER,
+                               actual.data() + GENERIC - ORDER);
+  BOOST_CHECK_LE(maximumDifference(expected, actual), 1e-12);
+  generic.filter_forward_history_zero(LEN, x.data(), expected.data());
+  unrolled.filter_forward_history_zero(LEN, x.data(), actual.data());
+  BOOST_CHECK_LE(maximumDifference(expected, actual), 1e-12);
+  generic.filter_backward_offs(LEN, x.data(), expected.data());
+  unrolled.filter_backward_offs(LEN, x.data(), actual.data());
+  BOOST_CHECK_LE(maximumDifference(expected, actual), 1e-12);
+  generic.filter_backward_history_zero(LEN, x.data(), expected.data());
+  unrolled.filter_backward_history_zero(LEN, x.data(), actual.data());
+  BOOST_CHECK_LE(maximumDifference(expected, actual), 1e-12);
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(org_simple_dsp_iir_filter)
+
+BOOST_AUTO_TEST_CASE(testUnrolledMatchesWithOffset) {
+  checkUnrolled<1>();
+  checkUnrolled<2>();
+  checkUnrolled<3>();
+  checkUnrolled<4>();
+  checkUnrolled<5>();
+  checkUnrolled<6>();
+  checkUnrolled<7>();
+  checkUnrolled<8>();
+}
+
+BOOST_AUTO_TEST_CASE(testFixedOrderCoefficientsMatchGeneric) {
+  checkCoefficients<1>();
+  checkCoefficients<2>();
+  checkCoefficients<3>();
+  checkCoefficients<4>();
+  checkCoefficients<5>();
+  checkCoefficients<6>();
+  checkCoefficients<7>();
+  checkCoefficients<8>();
+}
+
+BOOST_AUTO_TEST_CASE(testFixedOrderCoefficientsDoNotFlushSubnormals) {
+  static constexpr size_t LEN = 100;
+  static constexpr size_t GENERIC = MAX_UNROLLED_ORDER + 1;
+  FixedOrderCoefficients<double, 1> unrolled;
+  FixedOrderCoefficients<double, GENERIC> generic;
+  // setFF() and setFB() swap feed forward and feed backward.
+  unrolled.setFB(0, 1.0);
+  unrolled.setFF(1, 0.5);
+  generic.setFB(0, 1.0);
+  generic.setFF(1, 0.5);
+  std::vector<double> x(LEN + GENERIC, 0.0);
+  x[GENERIC] = 1e-300;
+  std::vector<double> expected(x.size(), 0.0);
+  std::vector<double> actual(x.size(), 0.0);
+  generic.filter_forward_offs(LEN, x.data(), expected.data());
+  unrolled.filter_forward_offs(LEN, x.data() + GENERIC - 1,
+                               actual.data() + GENERIC - 1);
+  BOOST_CHECK_EQUAL_COLLECTIONS(expected.begin(), expected.end(),
+                                actual.begin(), actual.end());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
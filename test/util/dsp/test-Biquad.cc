@@ -75,6 +75,20 @@ std::ostream &operator<<(std::ostream &out, const Coefficients &c) {
   return out;
 }
 
+/*
+ * Gain at DC (z = 1) and at the Nyquist frequency (z = -1), where the
+ * feedback coefficients are added to the output, so have the opposite sign of
+ * the usual denominator.
+ */
+static double dcGain(const org::simple::dsp::BiQuad::Coefficients<double> &c) {
+  return (c.b0 + c.b1 + c.b2) / (1.0 - c.a1 - c.a2);
+}
+
+static double
+nyquistGain(const org::simple::dsp::BiQuad::Coefficients<double> &c) {
+  return (c.b0 - c.b1 + c.b2) / (1.0 + c.a1 - c.a2);
+}
+
 BOOST_AUTO_TEST_SUITE(test_audioDsp_Biquad)
 
 BOOST_AUTO_TEST_CASE(test_audioDsp_TestRunSameAsRunWithGet) {
@@ -137,4 +151,18 @@ BOOST_AUTO_TEST_CASE(test_audioDsp_TestRunBackwardsSameAsApplyBackwards) {
                                 other.end());
 }
 
+BOOST_AUTO_TEST_CASE(test_audioDsp_ButterworthLowPassGain) {
+  org::simple::dsp::BiQuad::Coefficients<double> coefficients;
+  Butterworth::configureLowPass(coefficients, 48000, 1000);
+  BOOST_CHECK_CLOSE(1.0, dcGain(coefficients), 1e-9);
+  BOOST_CHECK_SMALL(nyquistGain(coefficients), 1e-9);
+}
+
+BOOST_AUTO_TEST_CASE(test_audioDsp_ButterworthHighPassGain) {
+  org::simple::dsp::BiQuad::Coefficients<double> coefficients;
+  Butterworth::configureHighPass(coefficients, 48000, 1000);
+  BOOST_CHECK_SMALL(dcGain(coefficients), 1e-9);
+  BOOST_CHECK_CLOSE(1.0, nyquistGain(coefficients), 1e-9);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,90 @@
+#ifndef ORG_SIMPLE_DSP_TEST_HELPER_H
+#define ORG_SIMPLE_DSP_TEST_HELPER_H
+/*
+ * org-simple/dsp-test-helper.h
+ *
+ * Added by michel on 2026-10-16
+ * Copyright (C) 2015-2026 Michel Fleur.
+ * Source https://github.com/emmef/org-simple
+ * Email org-simple@emmef.org
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <org-simple/dsp/Biquad.h>
+#include <vector>
+
+namespace {
+
+/**
+ * Returns sample \c frame of \c channel of a deterministic, noise-like test
+ * signal in the range [-1, 1], that differs per channel.
+ */
+template <typename T> T testSample(size_t frame, size_t channel = 0) {
+  return T(int((frame * 7919 + channel * 104729) % 2001) - 1000) / 1000;
+}
+
+/**
+ * Returns \c len samples of the test signal of the first channel.
+ */
+template <typename T = double> std::vector<T> testSignal(size_t len) {
+  std::vector<T> result(len);
+  for (size_t i = 0; i < len; i++) {
+    result[i] = testSample<T>(i);
+  }
+  return result;
+}
+
+/**
+ * Returns the largest absolute difference between \c a and \c b, that have
+ * the same size.
+ */
+inline double maximumDifference(const std::vector<double> &a,
+                                const std::vector<double> &b) {
+  double difference = 0;
+  for (size_t i = 0; i < a.size(); i++) {
+    difference = std::max(difference, std::abs(a[i] - b[i]));
+  }
+  return difference;
+}
+
+/**
+ * Returns biquad coefficients that cover common cases: Butterworth filters at
+ * ordinary and at very low relative frequencies, parametric filters, a filter
+ * with real poles and the identity.
+ */
+template <typename T>
+std::vector<org::simple::dsp::BiQuad::Coefficients<T>> testFilters() {
+  using org::simple::dsp::BiQuad;
+  std::vector<BiQuad::Coefficients<T>> result(8);
+  BiQuad::Butterworth::configureLowPass(result[0], 48000, 1000);
+  BiQuad::Butterworth::configureHighPass(result[1], 48000, 5000);
+  BiQuad::Butterworth::configureLowPass(result[2], 192000, 20);
+  BiQuad::Butterworth::configureLowPass(result[3], 384000, 20);
+  BiQuad::Parametric::configure(result[4], 48000, 3000, 4, 1);
+  BiQuad::Parametric::configure(result[5], 384000, 3000, 4, 1);
+  // Real poles
+  result[6].b0 = 0.5;
+  result[6].b1 = 0.2;
+  result[6].a1 = 0.3;
+  result[6].a2 = 0.1;
+  // result[7] is the identity
+  return result;
+}
+
+} // namespace
+
+#endif // ORG_SIMPLE_DSP_TEST_HELPER_H
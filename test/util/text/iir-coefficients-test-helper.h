@@ -21,7 +21,6 @@
  * limitations under the License.
  */
 
-#include "org-simple/Array.h"
 #include "org-simple/dsp/iir-coefficients.h"
 #include <iostream>
 #include <vector>
@@ -46,7 +45,7 @@ template <unsigned ORDER> class FilterScenarioBuffer {
   const size_t size_;
   const size_t generateStart_ = ORDER;
   const size_t generateEnd_ = generateStart_ + samples_;
-  org::simple::ArrayAllocated<double> data_;
+  std::vector<double> data_;
 
   static size_t valid_buffers(size_t buffers) {
     if (buffers > 0 && buffers < 10) {
@@ -86,14 +85,14 @@ template <unsigned ORDER> class FilterScenarioBuffer {
 
   double *get_buffer(size_t selector) {
     if (selector < buffers_) {
-      return data_ + selector * size_;;
+      return data_.data() + selector * size_;
     }
     throw std::out_of_range("FilterScenarioBuffer: buffer index out of range.");
   }
 
   const double *get_buffer(size_t selector) const {
     if (selector < buffers_) {
-      return data_ + selector * size_;
+      return data_.data() + selector * size_;
     }
     throw std::out_of_range("FilterScenarioBuffer: buffer index out of range.");
   }
@@ -157,7 +156,7 @@ template <unsigned ORDER> class FilterScenarioBuffer {
 public:
   FilterScenarioBuffer(size_t samples, size_t buffers)
       : buffers_(valid_buffers(buffers)),
-        samples_(valid_samples(samples, buffers_)), size_(valid_size(samples_)),
+        samples_(valid_samples(samples, buffers_)), size_(calculate_size(samples_)),
         generateStart_(ORDER), generateEnd_(generateStart_ + samples_),
         data_(size_ * buffers_) {
     for (size_t selector = 0; selector < buffers_; selector++) {
@@ -323,21 +322,21 @@ C measureFilterGain(const org::simple::dsp::CoefficientsFilter<C> &filter, size_
       3 * signal_period +
       signal_period * ((effective_IR_length + signal_period / 2) / signal_period);
   size_t totalSamples = signal_period + 2 * settleSamples;
-  std::unique_ptr<double> buffer(new double[totalSamples]);
+  std::vector<double> buffer(totalSamples);
   org::simple::dsp::FilterHistory<double> history(filter);
   history.zero();
   for (size_t sample = 0; sample < totalSamples; sample++) {
     double input = cos(M_PI * 2 * (sample % signal_period) / signal_period);
-    buffer.get()[sample] =
+    buffer[sample] =
         filter.single(history.inputs(), history.outputs(), input);
   }
   history.zero();
   for (ptrdiff_t sample = totalSamples; sample > 0;) {
-    double &p = buffer.get()[--sample];
+    double &p = buffer[--sample];
     p = filter.single(history.inputs(), history.outputs(), p);
   }
   double gainSquared = 0.0;
-  double *p = buffer.get() + settleSamples;
+  const double *p = buffer.data() + settleSamples;
   for (size_t sample = 0; sample < signal_period; sample++) {
     gainSquared = std::max(gainSquared, *p++);
   }